@@ -270,14 +270,9 @@ static bool string_is_address(const char *str, const char *u, const char *d)
  */
 struct Address *mutt_alias_lookup(const char *s)
 {
-  struct Alias *a = NULL;
+  struct Alias *a = AliasHash ? mutt_hash_find(AliasHash, s) : NULL;
 
-  TAILQ_FOREACH(a, &Aliases, entries)
-  {
-    if (mutt_str_strcasecmp(s, a->name) == 0)
-      return a->addr;
-  }
-  return NULL;
+  return a ? a->addr : NULL;
 }
 
 /**
@@ -467,6 +462,7 @@ retry_name:
   mutt_alias_add_reverse(new);
 
   TAILQ_INSERT_TAIL(&Aliases, new, entries);
+  mutt_hash_insert(AliasHash, new->name, new);
 
   mutt_str_strfcpy(buf, AliasFile, sizeof(buf));
   if (mutt_get_field(_("Save to file: "), buf, sizeof(buf), MUTT_FILE) != 0)
@@ -734,6 +730,10 @@ void mutt_alias_free(struct Alias **p)
     return;
 
   mutt_alias_delete_reverse(*p);
+  /* aborted aliases are freed before ever being added to the hash;
+   * mutt_hash_delete() is a no-op for those */
+  if (AliasHash && (*p)->name)
+    mutt_hash_delete(AliasHash, (*p)->name, *p);
   FREE(&(*p)->name);
   mutt_addr_free(&(*p)->addr);
   FREE(p);
@@ -45,8 +45,54 @@ struct BodyCache
 {
   char path[PATH_MAX];
   size_t pathlen;
+  struct Hash *index; /**< ids of cached bodies, built on first use by
+                           bcache_index_load(); NULL until then */
 };
 
+/**
+ * bcache_index_load - Build the in-memory index of cached ids
+ * @param bcache Body cache
+ *
+ * One pass over the cache directory replaces a stat() per
+ * mutt_bcache_exists() call with a hash lookup.  Put, commit and delete
+ * keep the index in step afterwards; drivers hold the cache open for the
+ * lifetime of the mailbox and nothing else writes a live mailbox's cache,
+ * so the directory can't change under us.
+ *
+ * If the directory can't be read (typically because nothing has been
+ * cached yet), the index stays NULL and existence checks fall back to
+ * stat() until a load succeeds.
+ */
+static void bcache_index_load(struct BodyCache *bcache)
+{
+  char path[PATH_MAX];
+  struct stat st;
+
+  DIR *d = opendir(bcache->path);
+  if (!d)
+    return;
+
+  bcache->index = mutt_hash_create(128, MUTT_HASH_STRDUP_KEYS);
+
+  struct dirent *de = NULL;
+  while ((de = readdir(d)))
+  {
+    if (de->d_name[0] == '.')
+      continue;
+    /* in-progress files from mutt_bcache_put() aren't cached bodies yet */
+    size_t len = mutt_str_strlen(de->d_name);
+    if ((len > 4) && (mutt_str_strcmp(de->d_name + len - 4, ".tmp") == 0))
+      continue;
+
+    /* mirror mutt_bcache_exists(): only non-empty regular files count */
+    snprintf(path, sizeof(path), "%s%s", bcache->path, de->d_name);
+    if ((stat(path, &st) == 0) && S_ISREG(st.st_mode) && (st.st_size != 0))
+      mutt_hash_insert(bcache->index, de->d_name, NULL);
+  }
+
+  closedir(d);
+}
+
 /**
  * bcache_path - Create the cache path for a given account/mailbox
  * @param account Account info
@@ -112,7 +158,13 @@ static int mutt_bcache_move(struct BodyCache *bcache, const char *id, const char
 
   mutt_debug(3, "bcache: mv: '%s' '%s'\n", path, newpath);
 
-  return rename(path, newpath);
+  int rc = rename(path, newpath);
+  if ((rc == 0) && bcache->index)
+  {
+    mutt_hash_delete(bcache->index, id, NULL);
+    mutt_hash_insert(bcache->index, newid, NULL);
+  }
+  return rc;
 }
 
 /**
@@ -155,6 +207,7 @@ void mutt_bcache_close(struct BodyCache **bcache)
 {
   if (!bcache || !*bcache)
     return;
+  mutt_hash_destroy(&(*bcache)->index);
   FREE(bcache);
 }
 
@@ -266,7 +319,10 @@ int mutt_bcache_del(struct BodyCache *bcache, const char *id)
 
   mutt_debug(3, "bcache: del: '%s'\n", path);
 
-  return unlink(path);
+  int rc = unlink(path);
+  if ((rc == 0) && bcache->index)
+    mutt_hash_delete(bcache->index, id, NULL);
+  return rc;
 }
 
 /**
@@ -285,6 +341,15 @@ int mutt_bcache_exists(struct BodyCache *bcache, const char *id)
   if (!id || !*id || !bcache)
     return -1;
 
+  if (!bcache->index)
+    bcache_index_load(bcache);
+  if (bcache->index)
+  {
+    rc = mutt_hash_find_elem(bcache->index, id) ? 0 : -1;
+    mutt_debug(3, "bcache: exists: '%s': %s\n", id, rc == 0 ? "yes" : "no");
+    return rc;
+  }
+
   path[0] = '\0';
   mutt_str_strncat(path, sizeof(path), bcache->path, bcache->pathlen);
   mutt_str_strncat(path, sizeof(path), id, mutt_str_strlen(id));
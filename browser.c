@@ -23,6 +23,7 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <grp.h>
 #include <limits.h>
 #include <locale.h>
@@ -869,7 +870,10 @@ static int examine_directory(struct Menu *menu, struct BrowserState *state,
       }
 
       mutt_path_concat(buffer, d, de->d_name, sizeof(buffer));
-      if (lstat(buffer, &s) == -1)
+      /* stat relative to the directory fd: the kernel resolves just the last
+       * component instead of walking the whole path for every entry, which
+       * adds up in big directories on slow (e.g. NFS) filesystems */
+      if (fstatat(dirfd(dp), de->d_name, &s, AT_SYMLINK_NOFOLLOW) == -1)
         continue;
 
       /* No size for directories or symlinks */
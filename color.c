@@ -182,6 +182,7 @@ static void free_color_line(struct ColorLine *tmp, bool free_colors)
   regfree(&tmp->regex);
   mutt_pattern_free(&tmp->color_pattern);
   FREE(&tmp->pattern);
+  FREE(&tmp->prefilter);
   FREE(&tmp);
 }
 
@@ -781,6 +782,8 @@ static int add_pattern(struct ColorLineHead *top, const char *s, bool sensitive,
         free_color_line(tmp, true);
         return -1;
       }
+      tmp->prefilter = mutt_regex_required_literal(s);
+      tmp->prefilter_icase = (flags & REG_ICASE);
     }
     tmp->pattern = mutt_str_strdup(s);
     tmp->match = match;
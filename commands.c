@@ -45,6 +45,7 @@
 #include "hook.h"
 #include "keymap.h"
 #include "mailbox.h"
+#include "mbox/mbox.h"
 #include "menu.h"
 #include "mutt_curses.h"
 #include "mutt_logging.h"
@@ -83,6 +84,138 @@ static const char *ExtPagerProgress = "all";
 /** The folder the user last saved to.  Used by ci_save_message() */
 static char LastSaveFolder[PATH_MAX] = "";
 
+/**
+ * struct DecodedMsg - A kept decoded rendering of a message
+ *
+ * Re-displaying a message re-runs the whole decode pipeline (MIME decode,
+ * charset conversion, $display_filter) into a fresh temp file.  Keep the
+ * files of the last few viewed messages instead, so bouncing between
+ * messages re-opens a ready file.  Entries are keyed on the mailbox,
+ * Message-ID and on-disk offsets (so a sync or edit orphans them) and carry
+ * the ConfigRevision they were rendered under (so any config command
+ * invalidates them).
+ */
+struct DecodedMsg
+{
+  char *key;  /**< mailbox path, message id and offsets */
+  char *path; /**< temp file holding the decoded message */
+  int revision; /**< ConfigRevision at render time */
+  struct DecodedMsg *next;
+};
+
+static struct DecodedMsg *DecodedCache = NULL;
+
+/* bouncing between a handful of messages is the common review pattern;
+ * a deeper cache mostly keeps files nobody returns to */
+#define DECODED_CACHE_MAX 4
+
+/**
+ * decoded_cache_key - Build the cache key for a message
+ * @param cur    Email being displayed
+ * @param buf    Buffer for the key
+ * @param buflen Length of buffer
+ * @retval true A usable key was built
+ */
+static bool decoded_cache_key(struct Email *cur, char *buf, size_t buflen)
+{
+  if (!Context || !cur->env->message_id)
+    return false;
+
+  snprintf(buf, buflen, "%s\x1f%s\x1f%lld\x1f%lld\x1f%d\x1f%s",
+           Context->mailbox->path, cur->env->message_id,
+           (long long) cur->content->offset, (long long) cur->content->length,
+           Weed, NONULL(DisplayFilter));
+  return true;
+}
+
+/**
+ * decoded_cache_find - Look up a kept decoded message
+ * @param key Cache key from decoded_cache_key()
+ * @retval ptr  Matching entry, moved to the head of the list
+ * @retval NULL No current entry
+ *
+ * Entries rendered under an older ConfigRevision or whose file has gone
+ * missing are dropped on the way.
+ */
+static struct DecodedMsg *decoded_cache_find(const char *key)
+{
+  struct DecodedMsg *np = DecodedCache, **prev = &DecodedCache;
+
+  while (np)
+  {
+    if (mutt_str_strcmp(np->key, key) == 0)
+    {
+      if ((np->revision != ConfigRevision) || (access(np->path, R_OK) != 0))
+      {
+        *prev = np->next;
+        unlink(np->path);
+        FREE(&np->key);
+        FREE(&np->path);
+        FREE(&np);
+        return NULL;
+      }
+      *prev = np->next;
+      np->next = DecodedCache;
+      DecodedCache = np;
+      return np;
+    }
+    prev = &np->next;
+    np = np->next;
+  }
+  return NULL;
+}
+
+/**
+ * decoded_cache_add - Keep a decoded message file
+ * @param key  Cache key from decoded_cache_key()
+ * @param path Temp file holding the decoded message
+ *
+ * The cache takes ownership of the file; the oldest entry beyond the cache
+ * size is unlinked.
+ */
+static void decoded_cache_add(const char *key, const char *path)
+{
+  struct DecodedMsg *np = mutt_mem_calloc(1, sizeof(struct DecodedMsg));
+  np->key = mutt_str_strdup(key);
+  np->path = mutt_str_strdup(path);
+  np->revision = ConfigRevision;
+  np->next = DecodedCache;
+  DecodedCache = np;
+
+  int count = 0;
+  struct DecodedMsg **prev = &DecodedCache;
+  while ((np = *prev))
+  {
+    if (++count > DECODED_CACHE_MAX)
+    {
+      *prev = np->next;
+      unlink(np->path);
+      FREE(&np->key);
+      FREE(&np->path);
+      FREE(&np);
+      continue;
+    }
+    prev = &np->next;
+  }
+}
+
+/**
+ * mutt_decoded_cache_free - Drop all kept decoded message files
+ */
+void mutt_decoded_cache_free(void)
+{
+  struct DecodedMsg *np = NULL;
+
+  while ((np = DecodedCache))
+  {
+    DecodedCache = np->next;
+    unlink(np->path);
+    FREE(&np->key);
+    FREE(&np->path);
+    FREE(&np);
+  }
+}
+
 /**
  * mutt_display_message - Display a message in the pager
  * @param cur Header of current message
@@ -92,8 +225,10 @@ static char LastSaveFolder[PATH_MAX] = "";
 int mutt_display_message(struct Email *cur)
 {
   char tempfile[PATH_MAX], buf[LONG_STRING];
+  char cache_key[PATH_MAX + LONG_STRING];
+  bool cacheable = false;
   int rc = 0;
-  bool builtin = false;
+  const bool builtin = (!Pager || (mutt_str_strcmp(Pager, "builtin") == 0));
   int cmflags = MUTT_CM_DECODE | MUTT_CM_DISPLAY | MUTT_CM_CHARCONV;
   int chflags;
   FILE *fpout = NULL;
@@ -143,6 +278,22 @@ int mutt_display_message(struct Email *cur)
       crypt_invoke_message(APPLICATION_SMIME);
   }
 
+  /* crypto messages carry per-view side effects (passphrases, verification
+   * state), so only plain messages in the builtin pager are kept */
+  if (builtin && !cur->security)
+    cacheable = decoded_cache_key(cur, cache_key, sizeof(cache_key));
+  if (cacheable)
+  {
+    struct DecodedMsg *hit = decoded_cache_find(cache_key);
+    if (hit)
+    {
+      struct Pager info = { 0 };
+      info.email = cur;
+      info.ctx = Context;
+      return mutt_pager(NULL, hit->path, MUTT_PAGER_MESSAGE | MUTT_PAGER_KEEPFILE, &info);
+    }
+  }
+
   mutt_mktemp(tempfile, sizeof(tempfile));
   fpout = mutt_file_fopen(tempfile, "w");
   if (!fpout)
@@ -166,9 +317,7 @@ int mutt_display_message(struct Email *cur)
     }
   }
 
-  if (!Pager || (mutt_str_strcmp(Pager, "builtin") == 0))
-    builtin = true;
-  else
+  if (!builtin)
   {
     struct HdrFormatInfo hfi;
     hfi.ctx = Context;
@@ -246,7 +395,11 @@ int mutt_display_message(struct Email *cur)
     /* Invoke the builtin pager */
     info.email = cur;
     info.ctx = Context;
-    rc = mutt_pager(NULL, tempfile, MUTT_PAGER_MESSAGE, &info);
+    if (cacheable)
+      decoded_cache_add(cache_key, tempfile);
+    rc = mutt_pager(NULL, tempfile,
+                    cacheable ? (MUTT_PAGER_MESSAGE | MUTT_PAGER_KEEPFILE) : MUTT_PAGER_MESSAGE,
+                    &info);
   }
   else
   {
@@ -1024,6 +1177,9 @@ int mutt_save_message(struct Email *e, bool delete, bool decode, bool decrypt)
     {
       int rc = 0;
 
+      /* fsync per tagged message makes bulk saves crawl - do it once at close */
+      savectx->batch_append = true;
+
 #ifdef USE_NOTMUCH
       if (Context->mailbox->magic == MUTT_NOTMUCH)
         nm_longrun_init(Context->mailbox, true);
@@ -1034,7 +1190,8 @@ int mutt_save_message(struct Email *e, bool delete, bool decode, bool decrypt)
           continue;
 
         mutt_message_hook(Context, Context->mailbox->hdrs[i], MUTT_MESSAGE_HOOK);
-        rc = mutt_save_message_ctx(Context->mailbox->hdrs[i], delete, decode, decrypt, savectx);
+        /* deletion is recorded below, once the whole batch is on disk */
+        rc = mutt_save_message_ctx(Context->mailbox->hdrs[i], false, decode, decrypt, savectx);
         if (rc != 0)
           break;
 #ifdef USE_COMPRESSED
@@ -1053,11 +1210,29 @@ int mutt_save_message(struct Email *e, bool delete, bool decode, bool decrypt)
       if (Context->mailbox->magic == MUTT_NOTMUCH)
         nm_longrun_done(Context->mailbox);
 #endif
+      /* the per-message commits skipped their fsync; the batch isn't saved
+       * until this succeeds */
+      if (rc == 0)
+        rc = mbox_flush_append(savectx);
       if (rc != 0)
       {
         mx_mbox_close(&savectx, NULL);
         return -1;
       }
+
+      if (delete)
+      {
+        for (int i = 0; i < Context->mailbox->msg_count; i++)
+        {
+          if (!message_is_tagged(Context, i))
+            continue;
+
+          mutt_set_flag(Context, Context->mailbox->hdrs[i], MUTT_DELETE, 1);
+          mutt_set_flag(Context, Context->mailbox->hdrs[i], MUTT_PURGE, 1);
+          if (DeleteUntag)
+            mutt_set_flag(Context, Context->mailbox->hdrs[i], MUTT_TAG, 0);
+        }
+      }
     }
 
     const bool need_mailbox_cleanup = ((savectx->mailbox->magic == MUTT_MBOX) ||
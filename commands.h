@@ -43,6 +43,7 @@ extern bool          PromptAfter;
 
 void ci_bounce_message(struct Email *e);
 void mutt_check_stats(void);
+void mutt_decoded_cache_free(void);
 bool mutt_check_traditional_pgp(struct Email *e, int *redraw);
 void mutt_display_address(struct Envelope *env);
 int  mutt_display_message(struct Email *cur);
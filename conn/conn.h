@@ -50,6 +50,9 @@
 #include "socket.h"
 #include "ssl.h"
 #include "tunnel.h"
+#ifdef USE_ZLIB
+#include "zstrm.h"
+#endif
 #ifdef USE_SASL
 #include "sasl.h"
 #endif
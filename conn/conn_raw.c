@@ -57,6 +57,107 @@
 bool UseIpv6; ///< Config: Lookup IPv6 addresses when making connections
 #endif
 
+#ifdef HAVE_GETADDRINFO
+/* Cache of recent name lookups, so switching between accounts doesn't block
+ * on the resolver for every reconnect.  Entries are retired after a fixed
+ * interval, or immediately when connecting to the cached addresses fails. */
+#define DNS_CACHE_SIZE 8
+#define DNS_CACHE_TTL 300 ///< seconds a cached lookup stays usable
+
+/**
+ * struct DnsCacheEntry - A cached getaddrinfo() result
+ */
+struct DnsCacheEntry
+{
+  char host[128]; /**< hostname as given in the account, empty if unused */
+  unsigned short port;
+  struct addrinfo *res; /**< owned; freed when the entry is evicted */
+  time_t when;          /**< time of the lookup */
+};
+
+static struct DnsCacheEntry DnsCache[DNS_CACHE_SIZE];
+
+/**
+ * dns_cache_find - Look up a host/port in the lookup cache
+ * @param host Hostname
+ * @param port Port number
+ * @retval ptr  Cached address list
+ * @retval NULL Not cached, or the entry had expired
+ */
+static struct addrinfo *dns_cache_find(const char *host, unsigned short port)
+{
+  for (int i = 0; i < DNS_CACHE_SIZE; i++)
+  {
+    struct DnsCacheEntry *entry = &DnsCache[i];
+    if (entry->res && (entry->port == port) &&
+        (mutt_str_strcmp(entry->host, host) == 0))
+    {
+      if ((time(NULL) - entry->when) > DNS_CACHE_TTL)
+      {
+        freeaddrinfo(entry->res);
+        entry->res = NULL;
+        return NULL;
+      }
+      return entry->res;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * dns_cache_add - Remember a getaddrinfo() result
+ * @param host Hostname
+ * @param port Port number
+ * @param res  Address list, ownership is transferred to the cache
+ *
+ * The oldest entry is evicted if the cache is full.
+ */
+static void dns_cache_add(const char *host, unsigned short port, struct addrinfo *res)
+{
+  struct DnsCacheEntry *victim = &DnsCache[0];
+
+  for (int i = 0; i < DNS_CACHE_SIZE; i++)
+  {
+    struct DnsCacheEntry *entry = &DnsCache[i];
+    if (!entry->res)
+    {
+      victim = entry;
+      break;
+    }
+    if (entry->when < victim->when)
+      victim = entry;
+  }
+
+  if (victim->res)
+    freeaddrinfo(victim->res);
+  mutt_str_strfcpy(victim->host, host, sizeof(victim->host));
+  victim->port = port;
+  victim->res = res;
+  victim->when = time(NULL);
+}
+
+/**
+ * dns_cache_remove - Forget a cached lookup
+ * @param host Hostname
+ * @param port Port number
+ */
+static void dns_cache_remove(const char *host, unsigned short port)
+{
+  for (int i = 0; i < DNS_CACHE_SIZE; i++)
+  {
+    struct DnsCacheEntry *entry = &DnsCache[i];
+    if (entry->res && (entry->port == port) &&
+        (mutt_str_strcmp(entry->host, host) == 0))
+    {
+      freeaddrinfo(entry->res);
+      entry->res = NULL;
+      entry->host[0] = '\0';
+      return;
+    }
+  }
+}
+#endif /* HAVE_GETADDRINFO */
+
 /**
  * socket_connect - set up to connect to a socket fd
  * @param fd File descriptor to connect with
@@ -128,6 +229,7 @@ int raw_socket_open(struct Connection *conn)
   struct addrinfo hints;
   struct addrinfo *res = NULL;
   struct addrinfo *cur = NULL;
+  bool resolved_fresh = false;
 
   /* we accept v4 or v6 STREAM sockets */
   memset(&hints, 0, sizeof(hints));
@@ -141,29 +243,39 @@ int raw_socket_open(struct Connection *conn)
 
   snprintf(port, sizeof(port), "%d", conn->account.port);
 
-#ifdef HAVE_LIBIDN
-  if (mutt_idna_to_ascii_lz(conn->account.host, &host_idna, 1) != 0)
+resolve:
+  res = dns_cache_find(conn->account.host, conn->account.port);
+  if (!res)
   {
-    mutt_error(_("Bad IDN: '%s'"), conn->account.host);
-    return -1;
-  }
+    resolved_fresh = true;
+
+#ifdef HAVE_LIBIDN
+    if (mutt_idna_to_ascii_lz(conn->account.host, &host_idna, 1) != 0)
+    {
+      mutt_error(_("Bad IDN: '%s'"), conn->account.host);
+      return -1;
+    }
 #else
-  host_idna = conn->account.host;
+    host_idna = conn->account.host;
 #endif
 
-  if (!OptNoCurses)
-    mutt_message(_("Looking up %s..."), conn->account.host);
+    if (!OptNoCurses)
+      mutt_message(_("Looking up %s..."), conn->account.host);
 
-  rc = getaddrinfo(host_idna, port, &hints, &res);
+    rc = getaddrinfo(host_idna, port, &hints, &res);
 
 #ifdef HAVE_LIBIDN
-  FREE(&host_idna);
+    FREE(&host_idna);
 #endif
 
-  if (rc)
-  {
-    mutt_error(_("Could not find the host \"%s\""), conn->account.host);
-    return -1;
+    if (rc)
+    {
+      mutt_error(_("Could not find the host \"%s\""), conn->account.host);
+      return -1;
+    }
+
+    /* the cache owns the address list from here on */
+    dns_cache_add(conn->account.host, conn->account.port, res);
   }
 
   if (!OptNoCurses)
@@ -187,7 +299,14 @@ int raw_socket_open(struct Connection *conn)
     }
   }
 
-  freeaddrinfo(res);
+  if (rc != 0)
+  {
+    /* don't keep addresses we couldn't connect to; if they came from the
+     * cache, the host may have moved since the lookup - resolve it again */
+    dns_cache_remove(conn->account.host, conn->account.port);
+    if (!resolved_fresh)
+      goto resolve;
+  }
 
 #else
   /* --- IPv4 only --- */
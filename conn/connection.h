@@ -29,6 +29,9 @@
 #include "mutt/mutt.h"
 #include "connaccount.h"
 
+/* Read buffer size; one TLS record fits without a second syscall */
+#define MUTT_CONN_BUFLEN 16384
+
 /**
  * struct Connection - An open network connection (socket)
  */
@@ -38,7 +41,7 @@ struct Connection
   unsigned int ssf; /**< security strength factor, in bits */
   void *data;
 
-  char inbuf[LONG_STRING];
+  char inbuf[MUTT_CONN_BUFLEN];
   int bufpos;
 
   int fd;
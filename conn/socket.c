@@ -218,6 +218,33 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
   return -1;
 }
 
+/**
+ * socket_fill - Refill a Connection's read buffer
+ * @param conn Connection to a server
+ * @retval >0 Success, number of bytes now buffered
+ * @retval -1 Error, the connection has been closed
+ */
+static int socket_fill(struct Connection *conn)
+{
+  if (conn->fd < 0)
+  {
+    mutt_debug(1, "attempt to read from closed connection.\n");
+    return -1;
+  }
+  conn->available = conn->conn_read(conn, conn->inbuf, sizeof(conn->inbuf));
+  conn->bufpos = 0;
+  if (conn->available == 0)
+  {
+    mutt_error(_("Connection to %s closed"), conn->account.host);
+  }
+  if (conn->available <= 0)
+  {
+    mutt_socket_close(conn);
+    return -1;
+  }
+  return conn->available;
+}
+
 /**
  * mutt_socket_readchar - simple read buffering to speed things up
  * @param[in]  conn Connection to a server
@@ -227,31 +254,40 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
  */
 int mutt_socket_readchar(struct Connection *conn, char *c)
 {
-  if (conn->bufpos >= conn->available)
-  {
-    if (conn->fd >= 0)
-      conn->available = conn->conn_read(conn, conn->inbuf, sizeof(conn->inbuf));
-    else
-    {
-      mutt_debug(1, "attempt to read from closed connection.\n");
-      return -1;
-    }
-    conn->bufpos = 0;
-    if (conn->available == 0)
-    {
-      mutt_error(_("Connection to %s closed"), conn->account.host);
-    }
-    if (conn->available <= 0)
-    {
-      mutt_socket_close(conn);
-      return -1;
-    }
-  }
+  if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
+    return -1;
+
   *c = conn->inbuf[conn->bufpos];
   conn->bufpos++;
   return 1;
 }
 
+/**
+ * mutt_socket_readbuf - Read a block of data from a Connection
+ * @param[in]  conn Connection to a server
+ * @param[out] buf  Buffer to store the data
+ * @param[in]  len  Length of the buffer
+ * @retval >0 Success, number of bytes read
+ * @retval -1 Error
+ *
+ * Serves from the Connection's internal read buffer, refilling it at most
+ * once, so bulk payloads (e.g. IMAP literals) can be consumed in chunks
+ * rather than one mutt_socket_readchar() call per byte.  A short read just
+ * means the buffer ran out; call again for more.
+ */
+int mutt_socket_readbuf(struct Connection *conn, char *buf, size_t len)
+{
+  if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
+    return -1;
+
+  size_t have = conn->available - conn->bufpos;
+  if (len > have)
+    len = have;
+  memcpy(buf, conn->inbuf + conn->bufpos, len);
+  conn->bufpos += len;
+  return len;
+}
+
 /**
  * mutt_socket_readln_d - Read a line from a socket
  * @param buf    Buffer to store the line
@@ -263,20 +299,30 @@ int mutt_socket_readchar(struct Connection *conn, char *c)
  */
 int mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int dbg)
 {
-  char ch;
-  int i;
+  size_t i = 0;
+  bool eol = false;
 
-  for (i = 0; i < buflen - 1; i++)
+  while (!eol && (i < (buflen - 1)))
   {
-    if (mutt_socket_readchar(conn, &ch) != 1)
+    if ((conn->bufpos >= conn->available) && (socket_fill(conn) < 0))
     {
       buf[i] = '\0';
       return -1;
     }
 
-    if (ch == '\n')
-      break;
-    buf[i] = ch;
+    /* scan the buffered span for the end of line and copy it in one go,
+     * instead of fetching one character at a time */
+    const char *start = conn->inbuf + conn->bufpos;
+    size_t chunk = MIN((size_t)(conn->available - conn->bufpos), buflen - 1 - i);
+    const char *nl = memchr(start, '\n', chunk);
+    if (nl)
+    {
+      chunk = nl - start;
+      eol = true;
+    }
+    memcpy(buf + i, start, chunk);
+    i += chunk;
+    conn->bufpos += chunk + (eol ? 1 : 0);
   }
 
   /* strip \r from \r\n termination */
@@ -287,7 +333,7 @@ int mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int
   mutt_debug(dbg, "%d< %s\n", conn->fd, buf);
 
   /* number of bytes read, not strlen */
-  return i + 1;
+  return (int) i + 1;
 }
 
 /**
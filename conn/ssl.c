@@ -95,8 +95,74 @@ static int SkipModeExDataIndex = -1;
  * open up another connection to the same server in this session */
 static STACK_OF(X509) *SslSessionCerts = NULL;
 
+/* SSL sessions from successful handshakes, keyed by "host:port", so that
+ * reconnecting to a server can use an abbreviated handshake */
+static struct Hash *SslSessionCache = NULL;
+
 static int ssl_socket_close(struct Connection *conn);
 
+/**
+ * ssl_session_key - Build the session cache key for a Connection
+ * @param conn   Connection to a server
+ * @param keybuf Buffer for the key
+ * @param keylen Length of the buffer
+ * @retval ptr The buffer, for convenience
+ */
+static const char *ssl_session_key(struct Connection *conn, char *keybuf, size_t keylen)
+{
+  snprintf(keybuf, keylen, "%s:%u", conn->account.host,
+           (unsigned int) conn->account.port);
+  return keybuf;
+}
+
+/**
+ * ssl_session_resume - Offer a cached session when reconnecting to a server
+ * @param conn Connection to a server
+ * @param ssl  SSL handle, before SSL_connect() has been called
+ *
+ * If the server accepts the session, the handshake is shortened to one round
+ * trip.  If it doesn't (or the session has timed out), a full handshake
+ * happens as usual and the cache entry is replaced afterwards.
+ */
+static void ssl_session_resume(struct Connection *conn, SSL *ssl)
+{
+  char key[SHORT_STRING];
+
+  if (!SslSessionCache)
+    return;
+
+  SSL_SESSION *session = mutt_hash_find(SslSessionCache, ssl_session_key(conn, key, sizeof(key)));
+  if (session)
+    SSL_set_session(ssl, session);
+}
+
+/**
+ * ssl_session_store - Remember the session of a completed handshake
+ * @param conn Connection to a server
+ * @param ssl  SSL handle, after SSL_connect() has succeeded
+ */
+static void ssl_session_store(struct Connection *conn, SSL *ssl)
+{
+  char key[SHORT_STRING];
+
+  SSL_SESSION *session = SSL_get1_session(ssl);
+  if (!session)
+    return;
+
+  if (!SslSessionCache)
+    SslSessionCache = mutt_hash_create(23, MUTT_HASH_STRDUP_KEYS);
+
+  ssl_session_key(conn, key, sizeof(key));
+  struct HashElem *elem = mutt_hash_find_elem(SslSessionCache, key);
+  if (elem)
+  {
+    SSL_SESSION_free((SSL_SESSION *) elem->data);
+    elem->data = session;
+  }
+  else
+    mutt_hash_insert(SslSessionCache, key, session);
+}
+
 /**
  * struct SslSockData - SSL socket data
  */
@@ -1300,9 +1366,13 @@ static int ssl_setup(struct Connection *conn)
   ssldata->ssl = SSL_new(ssldata->ctx);
   SSL_set_fd(ssldata->ssl, conn->fd);
 
+  ssl_session_resume(conn, ssldata->ssl);
+
   if (ssl_negotiate(conn, ssldata))
     goto free_ssl;
 
+  ssl_session_store(conn, ssldata->ssl);
+
   ssldata->isopen = 1;
   conn->ssf = SSL_CIPHER_get_bits(SSL_get_current_cipher(ssldata->ssl), &maxbits);
 
@@ -0,0 +1,241 @@
+/**
+ * @file
+ * Compressed network connection (RFC4978)
+ *
+ * @authors
+ * Copyright (C) 2018 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page conn_zstrm Compressed network connection
+ *
+ * Wrap an open Connection in a zlib (deflate) stream, as negotiated by the
+ * IMAP COMPRESS=DEFLATE extension (RFC4978).  The wrapped Connection's
+ * methods are saved and restored when the Connection is closed.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <stdbool.h>
+#include <time.h>
+#include <zlib.h>
+#include "mutt/mutt.h"
+#include "connection.h"
+#include "zstrm.h"
+
+/* Scratch buffer size for the compressed side of each direction */
+#define ZSTRM_BUFSIZE 8192
+
+/**
+ * struct ZstrmDirection - A zlib stream, one direction of traffic
+ */
+struct ZstrmDirection
+{
+  z_stream z;          /**< zlib stream state */
+  char *buf;           /**< scratch buffer holding the compressed bytes */
+  bool conn_eof;       /**< the wrapped connection hit end-of-file */
+  bool stream_eof;     /**< the zlib stream has ended */
+};
+
+/**
+ * struct ZstrmContext - Data compression layer on a Connection
+ */
+struct ZstrmContext
+{
+  struct ZstrmDirection read;  /**< inflate: server to us */
+  struct ZstrmDirection write; /**< deflate: us to server */
+  struct Connection next_conn; /**< the wrapped Connection's methods and data */
+};
+
+/**
+ * zstrm_open - Open a socket Connection - Implements Connection::conn_open()
+ *
+ * Cannot happen: the stream wraps a Connection that is already open.
+ */
+static int zstrm_open(struct Connection *conn)
+{
+  return -1;
+}
+
+/**
+ * zstrm_close - Close a socket Connection - Implements Connection::conn_close()
+ *
+ * Closes the wrapped Connection, restores its methods on @a conn and frees
+ * the compression state: the Connection can be reopened uncompressed.
+ */
+static int zstrm_close(struct Connection *conn)
+{
+  struct ZstrmContext *zctx = conn->sockdata;
+
+  const int rc = zctx->next_conn.conn_close(&zctx->next_conn);
+
+  mutt_debug(4, "read %llu->%llu wrote %llu->%llu bytes\n",
+             (unsigned long long) zctx->read.z.total_in,
+             (unsigned long long) zctx->read.z.total_out,
+             (unsigned long long) zctx->write.z.total_in,
+             (unsigned long long) zctx->write.z.total_out);
+
+  conn->sockdata = zctx->next_conn.sockdata;
+  conn->conn_open = zctx->next_conn.conn_open;
+  conn->conn_read = zctx->next_conn.conn_read;
+  conn->conn_write = zctx->next_conn.conn_write;
+  conn->conn_poll = zctx->next_conn.conn_poll;
+  conn->conn_close = zctx->next_conn.conn_close;
+
+  inflateEnd(&zctx->read.z);
+  deflateEnd(&zctx->write.z);
+  FREE(&zctx->read.buf);
+  FREE(&zctx->write.buf);
+  FREE(&zctx);
+
+  return rc;
+}
+
+/**
+ * zstrm_read - Read from a socket Connection - Implements Connection::conn_read()
+ */
+static int zstrm_read(struct Connection *conn, char *buf, size_t len)
+{
+  struct ZstrmContext *zctx = conn->sockdata;
+
+retry:
+  if (zctx->read.stream_eof)
+    return 0;
+
+  /* when the last batch of compressed input is used up, read some more */
+  if (zctx->read.z.avail_in == 0)
+  {
+    if (zctx->read.conn_eof)
+      return 0;
+
+    const int rc = zctx->next_conn.conn_read(&zctx->next_conn, zctx->read.buf, ZSTRM_BUFSIZE);
+    if (rc < 0)
+      return rc;
+    if (rc == 0)
+    {
+      zctx->read.conn_eof = true;
+      return 0;
+    }
+    zctx->read.z.avail_in = (uInt) rc;
+    zctx->read.z.next_in = (Bytef *) zctx->read.buf;
+  }
+
+  zctx->read.z.avail_out = (uInt) len;
+  zctx->read.z.next_out = (Bytef *) buf;
+
+  const int zrc = inflate(&zctx->read.z, Z_SYNC_FLUSH);
+  switch (zrc)
+  {
+    case Z_OK:
+      if (zctx->read.z.avail_out == (uInt) len)
+        goto retry; /* consumed input without producing output yet */
+      break;
+    case Z_STREAM_END:
+      zctx->read.stream_eof = true;
+      break;
+    case Z_BUF_ERROR:
+      goto retry; /* need more input */
+    default:
+      mutt_debug(1, "inflate returned %d (%s)\n", zrc,
+                 zctx->read.z.msg ? zctx->read.z.msg : "");
+      return -1;
+  }
+
+  return (int) (len - zctx->read.z.avail_out);
+}
+
+/**
+ * zstrm_write - Write to a socket Connection - Implements Connection::conn_write()
+ *
+ * The stream is flushed after every write (Z_PARTIAL_FLUSH), as the server
+ * must be able to act on each command without waiting for more data.
+ */
+static int zstrm_write(struct Connection *conn, const char *buf, size_t count)
+{
+  struct ZstrmContext *zctx = conn->sockdata;
+
+  zctx->write.z.avail_in = (uInt) count;
+  zctx->write.z.next_in = (Bytef *) buf;
+
+  do
+  {
+    zctx->write.z.avail_out = ZSTRM_BUFSIZE;
+    zctx->write.z.next_out = (Bytef *) zctx->write.buf;
+
+    const int zrc = deflate(&zctx->write.z, Z_PARTIAL_FLUSH);
+    if (zrc != Z_OK)
+    {
+      mutt_debug(1, "deflate returned %d (%s)\n", zrc,
+                 zctx->write.z.msg ? zctx->write.z.msg : "");
+      return -1;
+    }
+
+    const unsigned int compressed = ZSTRM_BUFSIZE - zctx->write.z.avail_out;
+    for (unsigned int sent = 0; sent < compressed;)
+    {
+      const int rc = zctx->next_conn.conn_write(&zctx->next_conn,
+                                                zctx->write.buf + sent, compressed - sent);
+      if (rc < 0)
+        return -1;
+      sent += rc;
+    }
+  } while (zctx->write.z.avail_in != 0);
+
+  return (int) count;
+}
+
+/**
+ * zstrm_poll - Check whether a socket read would block - Implements Connection::conn_poll()
+ */
+static int zstrm_poll(struct Connection *conn, time_t wait_secs)
+{
+  struct ZstrmContext *zctx = conn->sockdata;
+
+  /* compressed input still on hand may inflate to more data */
+  if ((zctx->read.z.avail_in != 0) && !zctx->read.stream_eof)
+    return 1;
+
+  return zctx->next_conn.conn_poll(&zctx->next_conn, wait_secs);
+}
+
+/**
+ * mutt_zstrm_wrap_conn - Add a compression layer to a Connection
+ * @param conn Connection to wrap
+ *
+ * To be called once both sides have accepted COMPRESS=DEFLATE: everything
+ * sent or received afterwards is part of a raw deflate stream (RFC4978,
+ * which prescribes the raw format and a 32KB window).
+ */
+void mutt_zstrm_wrap_conn(struct Connection *conn)
+{
+  struct ZstrmContext *zctx = mutt_mem_calloc(1, sizeof(struct ZstrmContext));
+
+  /* RFC4978 dictates the raw deflate format, without zlib headers */
+  deflateInit2(&zctx->write.z, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  inflateInit2(&zctx->read.z, -15);
+
+  zctx->read.buf = mutt_mem_malloc(ZSTRM_BUFSIZE);
+  zctx->write.buf = mutt_mem_malloc(ZSTRM_BUFSIZE);
+  zctx->next_conn = *conn;
+
+  conn->sockdata = zctx;
+  conn->conn_open = zstrm_open;
+  conn->conn_read = zstrm_read;
+  conn->conn_write = zstrm_write;
+  conn->conn_poll = zstrm_poll;
+  conn->conn_close = zstrm_close;
+}
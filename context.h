@@ -48,6 +48,7 @@ struct Context
 
   bool dontwrite : 1; /**< don't write the mailbox on close */
   bool append : 1;    /**< mailbox is opened in append mode */
+  bool batch_append : 1; /**< many appends coming; defer fsync to close */
   bool collapsed : 1; /**< are all threads collapsed? */
   bool peekonly : 1;  /**< just taking a glance, revert atime */
 
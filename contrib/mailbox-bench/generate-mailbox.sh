@@ -0,0 +1,140 @@
+#!/bin/sh
+#
+# Generate a reproducible synthetic mailbox for benchmarking.
+#
+# The same seed always produces byte-identical messages, so timings taken on
+# different machines or revisions are comparing the same workload.
+
+usage()
+{
+    echo "Usage: $(basename "$0") -o <path> [-f <format>] [-c <count>] [-d <depth>] [-H <bytes>] [-a <nth>] [-s <seed>]"
+    echo ""
+    echo "   -o Output mailbox path (must not exist)"
+    echo "   -f Mailbox format: maildir, mbox or mh (default: maildir)"
+    echo "   -c Number of messages (default: 1000)"
+    echo "   -d Thread depth: every message replies to the previous one in"
+    echo "      its thread of this length (default: 1, no threading)"
+    echo "   -H Extra header padding per message, in bytes (default: 0)"
+    echo "   -a Attach a base64 blob to every n-th message (default: 0, never)"
+    echo "   -s Random seed (default: 42)"
+    echo ""
+}
+
+FORMAT=maildir
+COUNT=1000
+DEPTH=1
+HPAD=0
+ATTACH=0
+SEED=42
+OUT=
+
+while getopts o:f:c:d:H:a:s: OPT; do
+    case "$OPT" in
+        o) OUT="$OPTARG" ;;
+        f) FORMAT="$OPTARG" ;;
+        c) COUNT="$OPTARG" ;;
+        d) DEPTH="$OPTARG" ;;
+        H) HPAD="$OPTARG" ;;
+        a) ATTACH="$OPTARG" ;;
+        s) SEED="$OPTARG" ;;
+        *) usage; exit 1
+    esac
+done
+
+if [ -z "$OUT" ]; then
+    usage
+    exit 1
+fi
+if [ -e "$OUT" ]; then
+    echo "$OUT already exists" >&2
+    exit 1
+fi
+
+case "$FORMAT" in
+    maildir) mkdir -p "$OUT/cur" "$OUT/new" "$OUT/tmp" ;;
+    mh)      mkdir -p "$OUT" ;;
+    mbox)    : > "$OUT" ;;
+    *)       usage; exit 1
+esac
+
+awk -v count="$COUNT" -v depth="$DEPTH" -v hpad="$HPAD" -v attach="$ATTACH" \
+    -v seed="$SEED" -v fmt="$FORMAT" -v out="$OUT" '
+function rnd() {
+    # deterministic LCG so every run produces the same corpus
+    seed = (seed * 1103515245 + 12345) % 2147483648
+    return seed
+}
+function emit(line) {
+    if (fmt == "mbox")
+        print line >> out
+    else
+        print line > file
+}
+BEGIN {
+    months = "Jan Feb Mar Apr May Jun Jul Aug Sep Oct Nov Dec"
+    split(months, mon, " ")
+    pad = ""
+    while (length(pad) < hpad)
+        pad = pad "x"
+
+    for (i = 1; i <= count; i++) {
+        if (fmt == "maildir")
+            file = out "/" ((rnd() % 4) ? "cur" : "new") "/1514764800." i ".bench" ((rnd() % 4) ? ":2,S" : "")
+        else if (fmt == "mh")
+            file = out "/" i
+
+        # one message per minute, starting 1 Jan 2018
+        min = (i - 1) % 60
+        hour = int((i - 1) / 60) % 24
+        day = int((i - 1) / 1440) % 28 + 1
+        m = int((i - 1) / 40320) % 12 + 1
+        date = sprintf("%d %s 2018 %02d:%02d:00 +0000", day, mon[m], hour, min)
+
+        if (fmt == "mbox")
+            emit(sprintf("From bench-%d@example.com Mon %s  %d %02d:%02d:00 2018", \
+                         i % 100, mon[m], day, hour, min))
+
+        t = (i - 1) % depth
+        emit("From: Bench Sender <bench-" (i % 100) "@example.com>")
+        emit("To: recipient@example.com")
+        emit("Subject: " (t ? "Re: " : "") "benchmark message " (i - t))
+        emit("Date: Mon, " date)
+        emit("Message-ID: <bench-" i "@example.com>")
+        if (t)
+            emit("In-Reply-To: <bench-" (i - 1) "@example.com>")
+        if (hpad > 0)
+            emit("X-Padding: " pad)
+
+        if (attach > 0 && (i % attach) == 0) {
+            emit("MIME-Version: 1.0")
+            emit("Content-Type: multipart/mixed; boundary=\"bench-boundary\"")
+            emit("")
+            emit("--bench-boundary")
+            emit("Content-Type: text/plain")
+            emit("")
+        } else {
+            emit("")
+        }
+
+        lines = rnd() % 20 + 3
+        for (j = 0; j < lines; j++)
+            emit("Body line " j " of message " i ", filler text to give parsers something to chew on.")
+
+        if (attach > 0 && (i % attach) == 0) {
+            emit("")
+            emit("--bench-boundary")
+            emit("Content-Type: application/octet-stream")
+            emit("Content-Transfer-Encoding: base64")
+            emit("")
+            for (j = 0; j < 16; j++)
+                emit("QmVuY2htYXJrIGJsb2IgZGF0YSwgcmVwZWF0ZWQgdG8gZmlsbCBvdXQgdGhlIHBhcnQu")
+            emit("--bench-boundary--")
+        }
+        emit("")
+
+        if (fmt != "mbox")
+            close(file)
+    }
+}'
+
+echo "Generated $COUNT $FORMAT messages in $OUT"
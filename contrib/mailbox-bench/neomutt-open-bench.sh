@@ -0,0 +1,73 @@
+#!/bin/sh
+#
+# Measure end-to-end mailbox open time, cold and warm.
+#
+# "Cold" opens the mailbox with an empty header cache; "warm" re-opens it with
+# the cache populated by the cold run.  Results are CSV on stdout:
+#
+#     phase,run,real,user,sys
+
+usage()
+{
+    echo "Usage: $(basename "$0") -e <neomutt> -m <mailbox> [-t <times>]"
+    echo ""
+    echo "   -e Path to the neomutt executable"
+    echo "   -m Path to the mailbox to open (see generate-mailbox.sh)"
+    echo "   -t Number of times to repeat the test (default: 3)"
+    echo ""
+}
+
+TIMES=3
+NEOMUTT=
+MAILBOX=
+
+while getopts e:m:t: OPT; do
+    case "$OPT" in
+        e) NEOMUTT="$OPTARG" ;;
+        m) MAILBOX="$OPTARG" ;;
+        t) TIMES="$OPTARG" ;;
+        *) usage; exit 1
+    esac
+done
+
+if [ -z "$NEOMUTT" ] || [ -z "$MAILBOX" ]; then
+    usage
+    exit 1
+fi
+
+CWD=$(dirname "$(realpath "$0")")
+TMPDIR=$(mktemp -d)
+trap 'rm -rf "$TMPDIR"' EXIT
+
+# 'time' is a keyword in bash/ksh/zsh but missing from some /bin/sh
+# implementations; fall back to coarse wall-clock timing there
+if (time -p true) > /dev/null 2>&1; then
+    HAVE_TIME=1
+else
+    HAVE_TIME=
+fi
+
+exe()
+{
+    export my_mailbox="$MAILBOX"
+    export my_tmpdir="$TMPDIR"
+    if [ -n "$HAVE_TIME" ]; then
+        t=$({ time -p "$NEOMUTT" -F "$CWD"/neomuttrc > /dev/null 2>/dev/null; } 2>&1)
+        echo "$t" | awk '/^real/ {r=$2} /^user/ {u=$2} /^sys/ {s=$2} END {print r "," u "," s}'
+    else
+        s=$(date +%s)
+        "$NEOMUTT" -F "$CWD"/neomuttrc > /dev/null 2>&1
+        e=$(date +%s)
+        echo "$((e - s)),,"
+    fi
+}
+
+echo "phase,run,real,user,sys"
+i=1
+while [ "$i" -le "$TIMES" ]; do
+    rm -rf "$TMPDIR"/hcache
+    mkdir -p "$TMPDIR"/hcache
+    echo "cold,$i,$(exe)"
+    echo "warm,$i,$(exe)"
+    i=$((i + 1))
+done
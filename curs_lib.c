@@ -1113,6 +1113,32 @@ void mutt_paddstr(int n, const char *s)
     addch(' ');
 }
 
+/**
+ * char_width - wcwidth() with a memo for the Basic Multilingual Plane
+ * @param wc Wide character
+ * @retval num Screen cells, or -1 if unprintable
+ *
+ * Width lookups dominate redraw profiles on CJK-heavy mailboxes, so remember
+ * each answer.  The table depends only on LC_CTYPE, which is set once at
+ * startup, so it never needs invalidating.
+ */
+static int char_width(wchar_t wc)
+{
+  static signed char *widths = NULL; /* -3 = not computed yet */
+
+  if ((wc < 0) || (wc >= 0x10000))
+    return wcwidth(wc);
+
+  if (!widths)
+  {
+    widths = mutt_mem_malloc(0x10000);
+    memset(widths, -3, 0x10000);
+  }
+  if (widths[wc] == -3)
+    widths[wc] = wcwidth(wc);
+  return widths[wc];
+}
+
 /**
  * mutt_wstr_trunc - Work out how to truncate a widechar string
  * @param[in]  src    String to measure
@@ -1137,8 +1163,22 @@ size_t mutt_wstr_trunc(const char *src, size_t maxlen, size_t maxwid, size_t *wi
   n = mutt_str_strlen(src);
 
   memset(&mbstate, 0, sizeof(mbstate));
-  for (w = 0; n && (cl = mbrtowc(&wc, src, n, &mbstate)); src += cl, n -= cl)
+  for (w = 0; n; src += cl, n -= cl)
   {
+    /* printable ASCII in the initial shift state: one byte, one column */
+    if (mbsinit(&mbstate) && (src[0] >= 0x20) && (src[0] < 0x7f))
+    {
+      if ((1 + l > maxlen) || (1 + w > maxwid))
+        break;
+      cl = 1;
+      l++;
+      w++;
+      continue;
+    }
+
+    cl = mbrtowc(&wc, src, n, &mbstate);
+    if (cl == 0)
+      break;
     if (cl == (size_t)(-1) || cl == (size_t)(-2))
     {
       if (cl == (size_t)(-1))
@@ -1146,7 +1186,7 @@ size_t mutt_wstr_trunc(const char *src, size_t maxlen, size_t maxwid, size_t *wi
       cl = (cl == (size_t)(-1)) ? 1 : n;
       wc = ReplacementChar;
     }
-    cw = wcwidth(wc);
+    cw = char_width(wc);
     /* hack because MUTT_TREE symbols aren't turned into characters
      * until rendered by print_enriched_string (#3364) */
     if ((cw < 0) && (src[0] == MUTT_SPECIAL_INDEX))
@@ -1187,8 +1227,16 @@ int mutt_strwidth(const char *s)
   n = mutt_str_strlen(s);
 
   memset(&mbstate, 0, sizeof(mbstate));
-  for (w = 0; n && (k = mbrtowc(&wc, s, n, &mbstate)); s += k, n -= k)
+  for (w = 0; n; s += k, n -= k)
   {
+    /* printable ASCII in the initial shift state: one byte, one column */
+    if (mbsinit(&mbstate) && (s[0] >= 0x20) && (s[0] < 0x7f))
+    {
+      w++;
+      k = 1;
+      continue;
+    }
+
     if (*s == MUTT_SPECIAL_INDEX)
     {
       s += 2; /* skip the index coloring sequence */
@@ -1196,6 +1244,9 @@ int mutt_strwidth(const char *s)
       continue;
     }
 
+    k = mbrtowc(&wc, s, n, &mbstate);
+    if (k == 0)
+      break;
     if (k == (size_t)(-1) || k == (size_t)(-2))
     {
       if (k == (size_t)(-1))
@@ -1205,7 +1256,7 @@ int mutt_strwidth(const char *s)
     }
     if (!IsWPrint(wc))
       wc = '?';
-    w += wcwidth(wc);
+    w += char_width(wc);
   }
   return w;
 }
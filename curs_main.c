@@ -713,7 +713,23 @@ void index_make_entry(char *buf, size_t buflen, struct Menu *menu, int num)
     }
   }
 
+  /* serve the line from the cache if nothing that feeds it has changed;
+   * flag changes (flags.c), sorting/threading (sort.c), collapsing
+   * (mutt_thread.c), renumbering (mx.c, pattern.c) and config changes
+   * (menu.c) all retire stale entries */
+  if (e->index_line && (e->index_line_flags == (int) flag) &&
+      (e->index_line_gen == IndexLineGen) && (e->index_line_cols == MuttIndexWindow->cols))
+  {
+    mutt_str_strfcpy(buf, e->index_line, buflen);
+    return;
+  }
+
   mutt_make_string_flags(buf, buflen, NONULL(IndexFormat), Context, e, flag);
+
+  mutt_str_replace(&e->index_line, buf);
+  e->index_line_flags = flag;
+  e->index_line_gen = IndexLineGen;
+  e->index_line_cols = MuttIndexWindow->cols;
 }
 
 /**
@@ -926,6 +942,8 @@ static void index_menu_redraw(struct Menu *menu)
       menu_redraw_index(menu);
       menu->redraw |= REDRAW_STATUS;
     }
+    else if (menu->redraw & REDRAW_ROWS)
+      menu_redraw_rows(menu);
     else if (menu->redraw & (REDRAW_MOTION_RESYNCH | REDRAW_MOTION))
       menu_redraw_motion(menu);
     else if (menu->redraw & REDRAW_CURRENT)
@@ -1561,6 +1579,25 @@ int mutt_index_menu(void)
         break;
       }
 
+      case OP_SHOW_STATS:
+      {
+        char tempfile[PATH_MAX];
+        mutt_mktemp(tempfile, sizeof(tempfile));
+
+        FILE *fp = mutt_file_fopen(tempfile, "a+");
+        if (!fp)
+        {
+          mutt_perror("fopen");
+          break;
+        }
+
+        mutt_mailbox_stats(fp);
+        mutt_file_fclose(&fp);
+
+        mutt_do_pager(_("statistics"), tempfile, MUTT_PAGER_NOWRAP, NULL);
+        break;
+      }
+
       case OP_HELP:
 
         mutt_help(MENU_MAIN);
@@ -1715,10 +1752,23 @@ int mutt_index_menu(void)
         CHECK_VISIBLE;
         if (tag && !AutoTag)
         {
+          int first = -1, last = -1;
           for (j = 0; j < Context->mailbox->msg_count; j++)
             if (message_is_visible(Context, j))
+            {
+              if (Context->mailbox->hdrs[j]->tagged)
+              {
+                const int v = Context->mailbox->hdrs[j]->virtual;
+                if ((first < 0) || (v < first))
+                  first = v;
+                if (v > last)
+                  last = v;
+              }
               mutt_set_flag(Context, Context->mailbox->hdrs[j], MUTT_TAG, 0);
-          menu->redraw |= REDRAW_STATUS | REDRAW_INDEX;
+            }
+          menu->redraw |= REDRAW_STATUS;
+          if (first >= 0)
+            mutt_menu_mark_dirty_rows(menu, first, last);
         }
         else
         {
@@ -3530,23 +3580,8 @@ bool mutt_reply_listener(const struct ConfigSet *cs, struct HashElem *he,
   if (!Context)
     return true;
 
-  regmatch_t pmatch[1];
-
   for (int i = 0; i < Context->mailbox->msg_count; i++)
-  {
-    struct Envelope *e = Context->mailbox->hdrs[i]->env;
-    if (!e || !e->subject)
-      continue;
-
-    if (ReplyRegex && ReplyRegex->regex &&
-        (regexec(ReplyRegex->regex, e->subject, 1, pmatch, 0) == 0))
-    {
-      e->real_subj = e->subject + pmatch[0].rm_eo;
-      continue;
-    }
-
-    e->real_subj = e->subject;
-  }
+    mutt_adjust_subject(Context->mailbox->hdrs[i]->env);
 
   OptResortInit = true; /* trigger a redraw of the index */
   return true;
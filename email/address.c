@@ -79,6 +79,24 @@ static void free_address(struct Address **a)
   FREE(a);
 }
 
+/**
+ * dup_buffer - Copy a parsed token whose length is already known
+ * @param buf Token, NUL-terminated
+ * @param len Length of the token
+ * @retval ptr Copy of the token
+ *
+ * The parser tracks the length of every phrase, comment and mailbox it
+ * collects, so duplicating them via strdup() would re-scan each buffer for
+ * its terminator.  Lengths are clamped by the callers because a counter may
+ * run past its buffer when a quoted string is truncated.
+ */
+static char *dup_buffer(const char *buf, size_t len)
+{
+  char *p = mutt_mem_malloc(len + 1);
+  memcpy(p, buf, len + 1);
+  return p;
+}
+
 /**
  * parse_comment - Extract a comment (parenthesised string)
  * @param[in]  s          String, just after the opening parenthesis
@@ -273,12 +291,12 @@ static const char *parse_address(const char *s, char *token, size_t *tokenlen,
   }
 
   terminate_string(token, *tokenlen, tokenmax);
-  addr->mailbox = mutt_str_strdup(token);
+  addr->mailbox = dup_buffer(token, MIN(*tokenlen, tokenmax));
 
   if (*commentlen && !addr->personal)
   {
     terminate_string(comment, *commentlen, commentmax);
-    addr->personal = mutt_str_strdup(comment);
+    addr->personal = dup_buffer(comment, MIN(*commentlen, commentmax));
   }
 
   return s;
@@ -491,7 +509,7 @@ struct Address *mutt_addr_parse_list(struct Address *top, const char *s)
       else if ((commentlen != 0) && last && !last->personal)
       {
         terminate_buffer(comment, commentlen);
-        last->personal = mutt_str_strdup(comment);
+        last->personal = dup_buffer(comment, MIN(commentlen, sizeof(comment) - 1));
       }
 
       commentlen = 0;
@@ -526,7 +544,7 @@ struct Address *mutt_addr_parse_list(struct Address *top, const char *s)
     {
       cur = mutt_addr_new();
       terminate_buffer(phrase, phraselen);
-      cur->mailbox = mutt_str_strdup(phrase);
+      cur->mailbox = dup_buffer(phrase, MIN(phraselen, sizeof(phrase) - 1));
       cur->group = 1;
 
       if (last)
@@ -549,7 +567,7 @@ struct Address *mutt_addr_parse_list(struct Address *top, const char *s)
       else if ((commentlen != 0) && last && !last->personal)
       {
         terminate_buffer(comment, commentlen);
-        last->personal = mutt_str_strdup(comment);
+        last->personal = dup_buffer(comment, MIN(commentlen, sizeof(comment) - 1));
       }
 
       /* add group terminator */
@@ -569,7 +587,7 @@ struct Address *mutt_addr_parse_list(struct Address *top, const char *s)
       terminate_buffer(phrase, phraselen);
       cur = mutt_addr_new();
       if (phraselen != 0)
-        cur->personal = mutt_str_strdup(phrase);
+        cur->personal = dup_buffer(phrase, MIN(phraselen, sizeof(phrase) - 1));
       ps = parse_route_addr(s + 1, comment, &commentlen, sizeof(comment) - 1, cur);
       if (!ps)
       {
@@ -613,7 +631,7 @@ struct Address *mutt_addr_parse_list(struct Address *top, const char *s)
   else if ((commentlen != 0) && last && !last->personal)
   {
     terminate_buffer(comment, commentlen);
-    last->personal = mutt_str_strdup(comment);
+    last->personal = dup_buffer(comment, MIN(commentlen, sizeof(comment) - 1));
   }
 
   return top;
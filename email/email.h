@@ -74,12 +74,10 @@ struct Email
   /* the following are used to support collapsing threads  */
   bool collapsed : 1; /**< is this message part of a collapsed thread? */
   bool limited : 1;   /**< is this message in a limited view?  */
-  size_t num_hidden;  /**< number of hidden messages in this view */
-
-  short recipient;    /**< user_is_recipient()'s return value, cached */
-
-  int pair;           /**< color-pair to use when displaying in the index */
 
+  /* The fields the sort comparators and limit/redraw loops read live right
+   * after the flag bits, so those loops stay within the first cache line of
+   * the struct; keep cold pointers and caches below them. */
   time_t date_sent;   /**< time when the message was sent (UTC) */
   time_t received;    /**< time when the message was placed in the mailbox */
   LOFF_T offset;      /**< where in the stream does this message begin? */
@@ -88,6 +86,20 @@ struct Email
   int msgno;          /**< number displayed to the user */
   int virtual;        /**< virtual message number */
   int score;
+  unsigned int score_rules;  /**< hash of the score rules that set score, 0 if never scored */
+
+  size_t num_hidden;  /**< number of hidden messages in this view */
+
+  short recipient;    /**< user_is_recipient()'s return value, cached */
+
+  int pair;           /**< color-pair to use when displaying in the index */
+
+  /* cached rendered index line; see index_make_entry() */
+  char *index_line;     /**< cached rendered index line */
+  int index_line_flags; /**< flags the cached line was rendered with */
+  int index_line_gen;   /**< value of IndexLineGen at render time */
+  int index_line_cols;  /**< screen width the cached line was rendered for */
+
   struct Envelope *env;      /**< envelope information */
   struct Body *content;      /**< list of MIME parts */
   char *path;
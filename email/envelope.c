@@ -33,6 +33,88 @@
 #include "envelope.h"
 #include "address.h"
 
+/* interning pool for message-id strings, see mutt_env_intern_id() */
+static struct Hash *IdPool = NULL;
+
+/**
+ * mutt_env_intern_id - Get the shared copy of a message-id string
+ * @param id Malloc'd message-id, ownership is taken
+ * @retval ptr Canonical copy of id
+ * @retval NULL If id was NULL
+ *
+ * Identical ids recur constantly (every References chain repeats its
+ * ancestors), so they're stored once and reference-counted.  The result must
+ * be given back with mutt_env_release_id(), never passed to free().
+ */
+char *mutt_env_intern_id(char *id)
+{
+  if (!id)
+    return NULL;
+
+  if (!IdPool)
+    IdPool = mutt_hash_create(1031, 0);
+
+  struct HashElem *elem = mutt_hash_find_elem(IdPool, id);
+  if (elem)
+  {
+    (*(size_t *) elem->data)++;
+    FREE(&id);
+    return (char *) elem->key.strkey;
+  }
+
+  size_t *refs = mutt_mem_malloc(sizeof(size_t));
+  *refs = 1;
+  mutt_hash_insert(IdPool, id, refs);
+  return id;
+}
+
+/**
+ * mutt_env_release_id - Release a message-id string
+ * @param ptr Message-id to release
+ *
+ * Drops one reference if *ptr is the pool's copy.  Equal strings allocated
+ * elsewhere (e.g. by gen_msgid() or the header cache) are simply freed.
+ */
+void mutt_env_release_id(char **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct HashElem *elem = IdPool ? mutt_hash_find_elem(IdPool, *ptr) : NULL;
+  if (elem && (elem->key.strkey == *ptr))
+  {
+    size_t *refs = elem->data;
+    if (--*refs == 0)
+    {
+      mutt_hash_delete(IdPool, *ptr, refs);
+      FREE(&refs);
+      FREE(ptr);
+    }
+    else
+      *ptr = NULL;
+  }
+  else
+    FREE(ptr);
+}
+
+/**
+ * release_id_void - Free callback wrapper for mutt_env_release_id()
+ * @param ptr Message-id to release
+ */
+static void release_id_void(void **ptr)
+{
+  mutt_env_release_id((char **) ptr);
+}
+
+/**
+ * mutt_env_release_idlist - Release a List of message-id strings
+ * @param head List to empty, e.g. Envelope.references
+ */
+void mutt_env_release_idlist(struct ListHead *head)
+{
+  mutt_list_free_type(head, release_id_void);
+}
+
 /**
  * mutt_env_new - Create a new Envelope
  * @retval ptr New Envelope
@@ -67,7 +149,7 @@ void mutt_env_free(struct Envelope **p)
   FREE(&(*p)->subject);
   /* real_subj is just an offset to subject and shouldn't be freed */
   FREE(&(*p)->disp_subj);
-  FREE(&(*p)->message_id);
+  mutt_env_release_id(&(*p)->message_id);
   FREE(&(*p)->supersedes);
   FREE(&(*p)->date);
   FREE(&(*p)->x_label);
@@ -81,8 +163,8 @@ void mutt_env_free(struct Envelope **p)
 
   mutt_buffer_free(&(*p)->spam);
 
-  mutt_list_free(&(*p)->references);
-  mutt_list_free(&(*p)->in_reply_to);
+  mutt_env_release_idlist(&(*p)->references);
+  mutt_env_release_idlist(&(*p)->in_reply_to);
   mutt_list_free(&(*p)->userhdrs);
   FREE(p);
 }
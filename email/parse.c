@@ -181,9 +181,9 @@ static void parse_content_disposition(const char *s, struct Body *ct)
   struct ParameterList parms;
   TAILQ_INIT(&parms);
 
-  if (mutt_str_strncasecmp("inline", s, 6) == 0)
+  if (mutt_str_ascii_strncasecmp("inline", s, 6) == 0)
     ct->disposition = DISP_INLINE;
-  else if (mutt_str_strncasecmp("form-data", s, 9) == 0)
+  else if (mutt_str_ascii_strncasecmp("form-data", s, 9) == 0)
     ct->disposition = DISP_FORM_DATA;
   else
     ct->disposition = DISP_ATTACH;
@@ -216,7 +216,7 @@ static void parse_references(struct ListHead *head, char *s)
 
   while ((m = mutt_extract_message_id(s, &sp)))
   {
-    mutt_list_insert_head(head, m);
+    mutt_list_insert_head(head, mutt_env_intern_id(m));
     s = NULL;
   }
 }
@@ -254,29 +254,29 @@ bool mutt_matches_ignore(const char *s)
  */
 int mutt_check_mime_type(const char *s)
 {
-  if (mutt_str_strcasecmp("text", s) == 0)
+  if (mutt_str_ascii_strcasecmp("text", s) == 0)
     return TYPE_TEXT;
-  else if (mutt_str_strcasecmp("multipart", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("multipart", s) == 0)
     return TYPE_MULTIPART;
 #ifdef SUN_ATTACHMENT
-  else if (mutt_str_strcasecmp("x-sun-attachment", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("x-sun-attachment", s) == 0)
     return TYPE_MULTIPART;
 #endif
-  else if (mutt_str_strcasecmp("application", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("application", s) == 0)
     return TYPE_APPLICATION;
-  else if (mutt_str_strcasecmp("message", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("message", s) == 0)
     return TYPE_MESSAGE;
-  else if (mutt_str_strcasecmp("image", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("image", s) == 0)
     return TYPE_IMAGE;
-  else if (mutt_str_strcasecmp("audio", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("audio", s) == 0)
     return TYPE_AUDIO;
-  else if (mutt_str_strcasecmp("video", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("video", s) == 0)
     return TYPE_VIDEO;
-  else if (mutt_str_strcasecmp("model", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("model", s) == 0)
     return TYPE_MODEL;
-  else if (mutt_str_strcasecmp("*", s) == 0)
+  else if (mutt_str_ascii_strcasecmp("*", s) == 0)
     return TYPE_ANY;
-  else if (mutt_str_strcasecmp(".*", s) == 0)
+  else if (mutt_str_ascii_strcasecmp(".*", s) == 0)
     return TYPE_ANY;
   else
     return TYPE_OTHER;
@@ -363,20 +363,20 @@ char *mutt_extract_message_id(const char *s, const char **saveptr)
  */
 int mutt_check_encoding(const char *c)
 {
-  if (mutt_str_strncasecmp("7bit", c, sizeof("7bit") - 1) == 0)
+  if (mutt_str_ascii_strncasecmp("7bit", c, sizeof("7bit") - 1) == 0)
     return ENC_7BIT;
-  else if (mutt_str_strncasecmp("8bit", c, sizeof("8bit") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("8bit", c, sizeof("8bit") - 1) == 0)
     return ENC_8BIT;
-  else if (mutt_str_strncasecmp("binary", c, sizeof("binary") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("binary", c, sizeof("binary") - 1) == 0)
     return ENC_BINARY;
-  else if (mutt_str_strncasecmp("quoted-printable", c, sizeof("quoted-printable") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("quoted-printable", c, sizeof("quoted-printable") - 1) == 0)
     return ENC_QUOTED_PRINTABLE;
-  else if (mutt_str_strncasecmp("base64", c, sizeof("base64") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("base64", c, sizeof("base64") - 1) == 0)
     return ENC_BASE64;
-  else if (mutt_str_strncasecmp("x-uuencode", c, sizeof("x-uuencode") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("x-uuencode", c, sizeof("x-uuencode") - 1) == 0)
     return ENC_UUENCODED;
 #ifdef SUN_ATTACHMENT
-  else if (mutt_str_strncasecmp("uuencode", c, sizeof("uuencode") - 1) == 0)
+  else if (mutt_str_ascii_strncasecmp("uuencode", c, sizeof("uuencode") - 1) == 0)
     return ENC_UUENCODED;
 #endif
   else
@@ -434,7 +434,7 @@ void mutt_parse_content_type(char *s, struct Body *ct)
   ct->type = mutt_check_mime_type(s);
 
 #ifdef SUN_ATTACHMENT
-  if (mutt_str_strcasecmp("x-sun-attachment", s) == 0)
+  if (mutt_str_ascii_strcasecmp("x-sun-attachment", s) == 0)
     ct->subtype = mutt_str_strdup("x-sun-attachment");
 #endif
 
@@ -500,15 +500,19 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
 {
   bool matched = false;
 
+  /* The field is identified by its initial, then by its length: together
+   * they reject almost every candidate before a string comparison runs. */
+  const size_t len = mutt_str_strlen(line);
+
   switch (tolower(line[0]))
   {
     case 'a':
-      if (mutt_str_strcasecmp(line + 1, "pparently-to") == 0)
+      if ((len == 13) && (mutt_str_ascii_strcasecmp(line + 1, "pparently-to") == 0))
       {
         env->to = mutt_addr_parse_list(env->to, p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "pparently-from") == 0)
+      else if ((len == 15) && (mutt_str_ascii_strcasecmp(line + 1, "pparently-from") == 0))
       {
         env->from = mutt_addr_parse_list(env->from, p);
         matched = true;
@@ -516,7 +520,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'b':
-      if (mutt_str_strcasecmp(line + 1, "cc") == 0)
+      if ((len == 3) && (mutt_str_ascii_strcasecmp(line + 1, "cc") == 0))
       {
         env->bcc = mutt_addr_parse_list(env->bcc, p);
         matched = true;
@@ -524,32 +528,32 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'c':
-      if (mutt_str_strcasecmp(line + 1, "c") == 0)
+      if ((len == 2) && (mutt_str_ascii_strcasecmp(line + 1, "c") == 0))
       {
         env->cc = mutt_addr_parse_list(env->cc, p);
         matched = true;
       }
-      else if (mutt_str_strncasecmp(line + 1, "ontent-", 7) == 0)
+      else if (mutt_str_ascii_strncasecmp(line + 1, "ontent-", 7) == 0)
       {
-        if (mutt_str_strcasecmp(line + 8, "type") == 0)
+        if ((len == 12) && (mutt_str_ascii_strcasecmp(line + 8, "type") == 0))
         {
           if (e)
             mutt_parse_content_type(p, e->content);
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 8, "language") == 0)
+        else if ((len == 16) && (mutt_str_ascii_strcasecmp(line + 8, "language") == 0))
         {
           if (e)
             parse_content_language(p, e->content);
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 8, "transfer-encoding") == 0)
+        else if ((len == 25) && (mutt_str_ascii_strcasecmp(line + 8, "transfer-encoding") == 0))
         {
           if (e)
             e->content->encoding = mutt_check_encoding(p);
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 8, "length") == 0)
+        else if ((len == 14) && (mutt_str_ascii_strcasecmp(line + 8, "length") == 0))
         {
           if (e)
           {
@@ -559,7 +563,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
           }
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 8, "description") == 0)
+        else if ((len == 19) && (mutt_str_ascii_strcasecmp(line + 8, "description") == 0))
         {
           if (e)
           {
@@ -568,7 +572,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
           }
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 8, "disposition") == 0)
+        else if ((len == 19) && (mutt_str_ascii_strcasecmp(line + 8, "disposition") == 0))
         {
           if (e)
             parse_content_disposition(p, e->content);
@@ -578,7 +582,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'd':
-      if (mutt_str_strcasecmp("ate", line + 1) == 0)
+      if ((len == 4) && (mutt_str_ascii_strcasecmp("ate", line + 1) == 0))
       {
         mutt_str_replace(&env->date, p);
         if (e)
@@ -597,7 +601,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'e':
-      if ((mutt_str_strcasecmp("xpires", line + 1) == 0) && e &&
+      if (((len == 7) && (mutt_str_ascii_strcasecmp("xpires", line + 1) == 0)) && e &&
           mutt_date_parse_date(p, NULL) < time(NULL))
       {
         e->expired = true;
@@ -605,13 +609,13 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'f':
-      if (mutt_str_strcasecmp("rom", line + 1) == 0)
+      if ((len == 4) && (mutt_str_ascii_strcasecmp("rom", line + 1) == 0))
       {
         env->from = mutt_addr_parse_list(env->from, p);
         matched = true;
       }
 #ifdef USE_NNTP
-      else if (mutt_str_strcasecmp(line + 1, "ollowup-to") == 0)
+      else if ((len == 11) && (mutt_str_ascii_strcasecmp(line + 1, "ollowup-to") == 0))
       {
         if (!env->followup_to)
         {
@@ -624,16 +628,16 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'i':
-      if (mutt_str_strcasecmp(line + 1, "n-reply-to") == 0)
+      if ((len == 11) && (mutt_str_ascii_strcasecmp(line + 1, "n-reply-to") == 0))
       {
-        mutt_list_free(&env->in_reply_to);
+        mutt_env_release_idlist(&env->in_reply_to);
         parse_references(&env->in_reply_to, p);
         matched = true;
       }
       break;
 
     case 'l':
-      if (mutt_str_strcasecmp(line + 1, "ines") == 0)
+      if ((len == 5) && (mutt_str_ascii_strcasecmp(line + 1, "ines") == 0))
       {
         if (e)
         {
@@ -646,7 +650,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
 
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "ist-Post") == 0)
+      else if ((len == 9) && (mutt_str_ascii_strcasecmp(line + 1, "ist-Post") == 0))
       {
         /* RFC2369.  FIXME: We should ignore whitespace, but don't. */
         if (strncmp(p, "NO", 2) != 0)
@@ -673,29 +677,29 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'm':
-      if (mutt_str_strcasecmp(line + 1, "ime-version") == 0)
+      if ((len == 12) && (mutt_str_ascii_strcasecmp(line + 1, "ime-version") == 0))
       {
         if (e)
           e->mime = true;
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "essage-id") == 0)
+      else if ((len == 10) && (mutt_str_ascii_strcasecmp(line + 1, "essage-id") == 0))
       {
         /* We add a new "Message-ID:" when building a message */
-        FREE(&env->message_id);
-        env->message_id = mutt_extract_message_id(p, NULL);
+        mutt_env_release_id(&env->message_id);
+        env->message_id = mutt_env_intern_id(mutt_extract_message_id(p, NULL));
         matched = true;
       }
-      else if (mutt_str_strncasecmp(line + 1, "ail-", 4) == 0)
+      else if (mutt_str_ascii_strncasecmp(line + 1, "ail-", 4) == 0)
       {
-        if (mutt_str_strcasecmp(line + 5, "reply-to") == 0)
+        if ((len == 13) && (mutt_str_ascii_strcasecmp(line + 5, "reply-to") == 0))
         {
           /* override the Reply-To: field */
           mutt_addr_free(&env->reply_to);
           env->reply_to = mutt_addr_parse_list(env->reply_to, p);
           matched = true;
         }
-        else if (mutt_str_strcasecmp(line + 5, "followup-to") == 0)
+        else if ((len == 16) && (mutt_str_ascii_strcasecmp(line + 5, "followup-to") == 0))
         {
           env->mail_followup_to = mutt_addr_parse_list(env->mail_followup_to, p);
           matched = true;
@@ -705,7 +709,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
 
 #ifdef USE_NNTP
     case 'n':
-      if (mutt_str_strcasecmp(line + 1, "ewsgroups") == 0)
+      if ((len == 10) && (mutt_str_ascii_strcasecmp(line + 1, "ewsgroups") == 0))
       {
         FREE(&env->newsgroups);
         mutt_str_remove_trailing_ws(p);
@@ -717,31 +721,31 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
 
     case 'o':
       /* field `Organization:' saves only for pager! */
-      if (mutt_str_strcasecmp(line + 1, "rganization") == 0)
+      if ((len == 12) && (mutt_str_ascii_strcasecmp(line + 1, "rganization") == 0))
       {
-        if (!env->organization && (mutt_str_strcasecmp(p, "unknown") != 0))
+        if (!env->organization && (mutt_str_ascii_strcasecmp(p, "unknown") != 0))
           env->organization = mutt_str_strdup(p);
       }
       break;
 
     case 'r':
-      if (mutt_str_strcasecmp(line + 1, "eferences") == 0)
+      if ((len == 10) && (mutt_str_ascii_strcasecmp(line + 1, "eferences") == 0))
       {
-        mutt_list_free(&env->references);
+        mutt_env_release_idlist(&env->references);
         parse_references(&env->references, p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "eply-to") == 0)
+      else if ((len == 8) && (mutt_str_ascii_strcasecmp(line + 1, "eply-to") == 0))
       {
         env->reply_to = mutt_addr_parse_list(env->reply_to, p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "eturn-path") == 0)
+      else if ((len == 11) && (mutt_str_ascii_strcasecmp(line + 1, "eturn-path") == 0))
       {
         env->return_path = mutt_addr_parse_list(env->return_path, p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "eceived") == 0)
+      else if ((len == 8) && (mutt_str_ascii_strcasecmp(line + 1, "eceived") == 0))
       {
         if (e && !e->received)
         {
@@ -754,18 +758,18 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 's':
-      if (mutt_str_strcasecmp(line + 1, "ubject") == 0)
+      if ((len == 7) && (mutt_str_ascii_strcasecmp(line + 1, "ubject") == 0))
       {
         if (!env->subject)
           env->subject = mutt_str_strdup(p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "ender") == 0)
+      else if ((len == 6) && (mutt_str_ascii_strcasecmp(line + 1, "ender") == 0))
       {
         env->sender = mutt_addr_parse_list(env->sender, p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "tatus") == 0)
+      else if ((len == 6) && (mutt_str_ascii_strcasecmp(line + 1, "tatus") == 0))
       {
         if (e)
         {
@@ -788,8 +792,8 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
         }
         matched = true;
       }
-      else if (((mutt_str_strcasecmp("upersedes", line + 1) == 0) ||
-                (mutt_str_strcasecmp("upercedes", line + 1) == 0)) &&
+      else if ((((len == 10) && (mutt_str_ascii_strcasecmp("upersedes", line + 1) == 0)) ||
+                ((len == 10) && (mutt_str_ascii_strcasecmp("upercedes", line + 1) == 0))) &&
                e)
       {
         FREE(&env->supersedes);
@@ -798,7 +802,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 't':
-      if (mutt_str_strcasecmp(line + 1, "o") == 0)
+      if ((len == 2) && (mutt_str_ascii_strcasecmp(line + 1, "o") == 0))
       {
         env->to = mutt_addr_parse_list(env->to, p);
         matched = true;
@@ -806,7 +810,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
       break;
 
     case 'x':
-      if (mutt_str_strcasecmp(line + 1, "-status") == 0)
+      if ((len == 8) && (mutt_str_ascii_strcasecmp(line + 1, "-status") == 0))
       {
         if (e)
         {
@@ -831,27 +835,27 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, char *line,
         }
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "-label") == 0)
+      else if ((len == 7) && (mutt_str_ascii_strcasecmp(line + 1, "-label") == 0))
       {
         FREE(&env->x_label);
         env->x_label = mutt_str_strdup(p);
         matched = true;
       }
 #ifdef USE_NNTP
-      else if (mutt_str_strcasecmp(line + 1, "-comment-to") == 0)
+      else if ((len == 12) && (mutt_str_ascii_strcasecmp(line + 1, "-comment-to") == 0))
       {
         if (!env->x_comment_to)
           env->x_comment_to = mutt_str_strdup(p);
         matched = true;
       }
-      else if (mutt_str_strcasecmp(line + 1, "ref") == 0)
+      else if ((len == 4) && (mutt_str_ascii_strcasecmp(line + 1, "ref") == 0))
       {
         if (!env->xref)
           env->xref = mutt_str_strdup(p);
         matched = true;
       }
 #endif
-      else if (mutt_str_strcasecmp(line + 1, "-original-to") == 0)
+      else if ((len == 13) && (mutt_str_ascii_strcasecmp(line + 1, "-original-to") == 0))
       {
         env->x_original_to = mutt_addr_parse_list(env->x_original_to, p);
         matched = true;
@@ -947,6 +951,31 @@ char *mutt_rfc822_read_line(FILE *f, char *line, size_t *linelen)
   /* not reached */
 }
 
+/**
+ * mutt_adjust_subject - Find the real subject, skipping any reply prefix
+ * @param env Envelope containing the subject
+ *
+ * Point env->real_subj at the portion of env->subject following whatever
+ * $reply_regex matches (or at the whole subject if it doesn't match).
+ * The result stays valid as long as env->subject does, so sorting and
+ * threading compare real_subj directly and never re-run the regex.
+ */
+void mutt_adjust_subject(struct Envelope *env)
+{
+  if (!env || !env->subject)
+    return;
+
+  regmatch_t pmatch[1];
+
+  if (ReplyRegex && ReplyRegex->regex &&
+      (regexec(ReplyRegex->regex, env->subject, 1, pmatch, 0) == 0))
+  {
+    env->real_subj = env->subject + pmatch[0].rm_eo;
+  }
+  else
+    env->real_subj = env->subject;
+}
+
 /**
  * mutt_rfc822_read_header - parses an RFC822 header
  * @param f         Stream to read from
@@ -1082,17 +1111,8 @@ struct Envelope *mutt_rfc822_read_header(FILE *f, struct Email *e, bool user_hdr
 
     if (env->subject)
     {
-      regmatch_t pmatch[1];
-
       rfc2047_decode(&env->subject);
-
-      if (ReplyRegex && ReplyRegex->regex &&
-          (regexec(ReplyRegex->regex, env->subject, 1, pmatch, 0) == 0))
-      {
-        env->real_subj = env->subject + pmatch[0].rm_eo;
-      }
-      else
-        env->real_subj = env->subject;
+      mutt_adjust_subject(env);
     }
 
     if (e->received < 0)
@@ -1151,32 +1171,32 @@ struct Body *mutt_read_mime_header(FILE *fp, bool digest)
       break;
     }
 
-    if (mutt_str_strncasecmp("content-", line, 8) == 0)
+    if (mutt_str_ascii_strncasecmp("content-", line, 8) == 0)
     {
-      if (mutt_str_strcasecmp("type", line + 8) == 0)
+      if (mutt_str_ascii_strcasecmp("type", line + 8) == 0)
         mutt_parse_content_type(c, p);
-      else if (mutt_str_strcasecmp("language", line + 8) == 0)
+      else if (mutt_str_ascii_strcasecmp("language", line + 8) == 0)
         parse_content_language(c, p);
-      else if (mutt_str_strcasecmp("transfer-encoding", line + 8) == 0)
+      else if (mutt_str_ascii_strcasecmp("transfer-encoding", line + 8) == 0)
         p->encoding = mutt_check_encoding(c);
-      else if (mutt_str_strcasecmp("disposition", line + 8) == 0)
+      else if (mutt_str_ascii_strcasecmp("disposition", line + 8) == 0)
         parse_content_disposition(c, p);
-      else if (mutt_str_strcasecmp("description", line + 8) == 0)
+      else if (mutt_str_ascii_strcasecmp("description", line + 8) == 0)
       {
         mutt_str_replace(&p->description, c);
         rfc2047_decode(&p->description);
       }
     }
 #ifdef SUN_ATTACHMENT
-    else if (mutt_str_strncasecmp("x-sun-", line, 6) == 0)
+    else if (mutt_str_ascii_strncasecmp("x-sun-", line, 6) == 0)
     {
-      if (mutt_str_strcasecmp("data-type", line + 6) == 0)
+      if (mutt_str_ascii_strcasecmp("data-type", line + 6) == 0)
         mutt_parse_content_type(c, p);
-      else if (mutt_str_strcasecmp("encoding-info", line + 6) == 0)
+      else if (mutt_str_ascii_strcasecmp("encoding-info", line + 6) == 0)
         p->encoding = mutt_check_encoding(c);
-      else if (mutt_str_strcasecmp("content-lines", line + 6) == 0)
+      else if (mutt_str_ascii_strcasecmp("content-lines", line + 6) == 0)
         mutt_param_set(&p->parameter, "content-lines", c);
-      else if (mutt_str_strcasecmp("data-description", line + 6) == 0)
+      else if (mutt_str_ascii_strcasecmp("data-description", line + 6) == 0)
       {
         mutt_str_replace(&p->description, c);
         rfc2047_decode(&p->description);
@@ -1208,8 +1228,8 @@ bool mutt_is_message_type(int type, const char *subtype)
     return false;
 
   subtype = NONULL(subtype);
-  return (mutt_str_strcasecmp(subtype, "rfc822") == 0) ||
-         (mutt_str_strcasecmp(subtype, "news") == 0);
+  return (mutt_str_ascii_strcasecmp(subtype, "rfc822") == 0) ||
+         (mutt_str_ascii_strcasecmp(subtype, "news") == 0);
 }
 
 /**
@@ -1225,7 +1245,7 @@ void mutt_parse_part(FILE *fp, struct Body *b)
   {
     case TYPE_MULTIPART:
 #ifdef SUN_ATTACHMENT
-      if (mutt_str_strcasecmp(b->subtype, "x-sun-attachment") == 0)
+      if (mutt_str_ascii_strcasecmp(b->subtype, "x-sun-attachment") == 0)
         bound = "--------";
       else
 #endif
@@ -1233,7 +1253,7 @@ void mutt_parse_part(FILE *fp, struct Body *b)
 
       fseeko(fp, b->offset, SEEK_SET);
       b->parts = mutt_parse_multipart(fp, bound, b->offset + b->length,
-                                      (mutt_str_strcasecmp("digest", b->subtype) == 0));
+                                      (mutt_str_ascii_strcasecmp("digest", b->subtype) == 0));
       break;
 
     case TYPE_MESSAGE:
@@ -1242,7 +1262,7 @@ void mutt_parse_part(FILE *fp, struct Body *b)
         fseeko(fp, b->offset, SEEK_SET);
         if (mutt_is_message_type(b->type, b->subtype))
           b->parts = mutt_rfc822_parse_message(fp, b);
-        else if (mutt_str_strcasecmp(b->subtype, "external-body") == 0)
+        else if (mutt_str_ascii_strcasecmp(b->subtype, "external-body") == 0)
           b->parts = mutt_read_mime_header(fp, 0);
         else
           return;
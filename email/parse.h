@@ -30,6 +30,7 @@ struct Body;
 struct Envelope;
 struct Email;
 
+void             mutt_adjust_subject(struct Envelope *env);
 int              mutt_check_encoding(const char *c);
 int              mutt_check_mime_type(const char *s);
 char *           mutt_extract_message_id(const char *s, const char **saveptr);
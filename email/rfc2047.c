@@ -214,11 +214,9 @@ static size_t try_block(const char *d, size_t dlen, const char *fromcode,
         iconv(cd, NULL, NULL, &ob, &obl) == (size_t)(-1))
     {
       assert(errno == E2BIG);
-      iconv_close(cd);
       assert(ib > d);
       return (ib - d == dlen) ? dlen : ib - d + 1;
     }
-    iconv_close(cd);
   }
   else
   {
@@ -294,7 +292,6 @@ static size_t encode_block(char *str, char *buf, size_t buflen, const char *from
   const size_t n1 = iconv(cd, (ICONV_CONST char **) &ib, &ibl, &ob, &obl);
   const size_t n2 = iconv(cd, NULL, NULL, &ob, &obl);
   assert(n1 != (size_t)(-1) && n2 != (size_t)(-1));
-  iconv_close(cd);
   return (*encoder)(str, tmp, ob - tmp, tocode);
 }
 
@@ -372,26 +369,28 @@ static char *decode_word(const char *s, size_t len, enum ContentEncoding enc)
 
   if (enc == ENC_QUOTED_PRINTABLE)
   {
-    struct Buffer buf = { 0 };
+    /* decoding only shrinks the text, one allocation is enough */
+    char *out = mutt_mem_malloc(len + 1);
+    char *o = out;
     for (; it < end; ++it)
     {
       if (*it == '_')
       {
-        mutt_buffer_addch(&buf, ' ');
+        *o++ = ' ';
       }
       else if ((*it == '=') && (!(it[1] & ~127) && hexval(it[1]) != -1) &&
                (!(it[2] & ~127) && hexval(it[2]) != -1))
       {
-        mutt_buffer_addch(&buf, (hexval(it[1]) << 4) | hexval(it[2]));
+        *o++ = (hexval(it[1]) << 4) | hexval(it[2]);
         it += 2;
       }
       else
       {
-        mutt_buffer_addch(&buf, *it);
+        *o++ = *it;
       }
     }
-    mutt_buffer_addch(&buf, '\0');
-    return buf.data;
+    *o = '\0';
+    return out;
   }
   else if (enc == ENC_BASE64)
   {
@@ -200,7 +200,7 @@ void clean_references(struct MuttThread *brk, struct MuttThread *cur)
       while ((np = STAILQ_NEXT(ref, entries)))
       {
         STAILQ_REMOVE_AFTER(&cur->message->env->references, ref, entries);
-        FREE(&np->data);
+        mutt_env_release_id(&np->data);
         FREE(&np);
       }
 
@@ -216,8 +216,8 @@ void clean_references(struct MuttThread *brk, struct MuttThread *cur)
  */
 void mutt_break_thread(struct Email *e)
 {
-  mutt_list_free(&e->env->in_reply_to);
-  mutt_list_free(&e->env->references);
+  mutt_env_release_idlist(&e->env->in_reply_to);
+  mutt_env_release_idlist(&e->env->references);
   e->env->irt_changed = true;
   e->env->refs_changed = true;
   e->changed = true;
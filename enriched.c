@@ -245,7 +245,10 @@ static void enriched_flush(struct EnrichedState *stte, bool wrap)
     stte->line_used += stte->buf_used;
     if (stte->line_used > stte->line_max)
     {
-      stte->line_max = stte->line_used;
+      /* flush happens per word - growing to the exact length would make
+       * long no-fill lines reallocate and copy on every word */
+      while (stte->line_used > stte->line_max)
+        stte->line_max *= 2;
       mutt_mem_realloc(&stte->line, (stte->line_max + 1) * sizeof(wchar_t));
     }
     wcscat(stte->line, stte->buffer);
@@ -273,7 +276,7 @@ static void enriched_putwc(wchar_t c, struct EnrichedState *stte)
     if (stte->tag_level[RICH_COLOR])
     {
       if (stte->param_used + 1 >= stte->param_len)
-        mutt_mem_realloc(&stte->param, (stte->param_len += STRING) * sizeof(wchar_t));
+        mutt_mem_realloc(&stte->param, (stte->param_len *= 2) * sizeof(wchar_t));
 
       stte->param[stte->param_used++] = c;
     }
@@ -283,7 +286,7 @@ static void enriched_putwc(wchar_t c, struct EnrichedState *stte)
   /* see if more space is needed (plus extra for possible rich characters) */
   if (stte->buf_len < (stte->buf_used + 3))
   {
-    stte->buf_len += LONG_STRING;
+    stte->buf_len = stte->buf_len ? (stte->buf_len * 2) : LONG_STRING;
     mutt_mem_realloc(&stte->buffer, (stte->buf_len + 1) * sizeof(wchar_t));
   }
 
@@ -344,9 +347,11 @@ static void enriched_puts(const char *s, struct EnrichedState *stte)
 
   const char *c = NULL;
 
-  if (stte->buf_len < (stte->buf_used + mutt_str_strlen(s)))
+  while (stte->buf_len < (stte->buf_used + mutt_str_strlen(s)))
   {
-    stte->buf_len += LONG_STRING;
+    /* adding a single chunk isn't guaranteed to fit a string longer
+     * than LONG_STRING - keep doubling until it does */
+    stte->buf_len = stte->buf_len ? (stte->buf_len * 2) : LONG_STRING;
     mutt_mem_realloc(&stte->buffer, (stte->buf_len + 1) * sizeof(wchar_t));
   }
   c = s;
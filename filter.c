@@ -27,6 +27,7 @@
  */
 
 #include "config.h"
+#include <fcntl.h>
 #include <stdlib.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -58,6 +59,22 @@
  * Additionally, in, out, and err will point to FILE* streams representing the
  * processes stdin, stdout, and stderr.
  */
+/**
+ * grow_pipe - Ask the kernel for a bigger pipe buffer
+ * @param fd Write end of a pipe
+ *
+ * The 64KB default means a process piping a large message to a filter
+ * bounces between sleeping and writing every few pages.  Best effort: the
+ * fcntl can fail (e.g. /proc/sys/fs/pipe-max-size, unprivileged limits)
+ * and the pipe simply keeps its default size.
+ */
+static void grow_pipe(int fd)
+{
+#ifdef F_SETPIPE_SZ
+  fcntl(fd, F_SETPIPE_SZ, 1048576);
+#endif
+}
+
 pid_t mutt_create_filter_fd(const char *cmd, FILE **in, FILE **out, FILE **err,
                             int fdin, int fdout, int fderr)
 {
@@ -68,6 +85,7 @@ pid_t mutt_create_filter_fd(const char *cmd, FILE **in, FILE **out, FILE **err,
     *in = 0;
     if (pipe(pin) == -1)
       return -1;
+    grow_pipe(pin[1]);
   }
 
   if (out)
@@ -82,6 +100,7 @@ pid_t mutt_create_filter_fd(const char *cmd, FILE **in, FILE **out, FILE **err,
       }
       return -1;
     }
+    grow_pipe(pout[1]);
   }
 
   if (err)
@@ -330,7 +330,12 @@ void mutt_set_flag_update(struct Context *ctx, struct Email *e, int flag, bool b
 
   if (update)
   {
-    mutt_set_header_color(ctx, e);
+    FREE(&e->index_line);
+    /* force the index entry's color to be re-evaluated on next draw: bulk
+     * operations (tag-prefix, thread flagging) hit this once per message,
+     * and evaluating the color patterns eagerly here would cost a pattern
+     * match per message instead of one per visible row */
+    e->pair = 0;
 #ifdef USE_SIDEBAR
     mutt_menu_set_current_redraw(REDRAW_SIDEBAR);
 #endif
@@ -204,6 +204,7 @@ const struct Binding OpMain[] = { /* map: index */
   { "set-flag",                  OP_MAIN_SET_FLAG,                  "w" },
   { "show-limit",                OP_MAIN_SHOW_LIMIT,                "\033l" },
   { "show-log-messages",         OP_SHOW_LOG_MESSAGES,              "M" },
+  { "show-stats",                OP_SHOW_STATS,                     NULL },
   { "show-version",              OP_VERSION,                        "V" },
 #ifdef USE_SIDEBAR
   { "sidebar-next",              OP_SIDEBAR_NEXT,                   NULL },
@@ -56,6 +56,7 @@ WHERE char *LastFolder;
 extern const char *GitVer;
 
 WHERE struct Hash *Groups;
+WHERE struct Hash *AliasHash;
 WHERE struct Hash *ReverseAliases;
 WHERE struct Hash *TagFormats;
 
@@ -94,6 +95,10 @@ WHERE SIG_ATOMIC_VOLATILE_T SigWinch;
 
 WHERE int CurrentMenu;
 
+WHERE int IndexLineGen; /**< bumped whenever cached index lines become stale */
+
+WHERE int ConfigRevision; /**< bumped whenever a config command runs */
+
 WHERE struct AliasList Aliases INITVAL(TAILQ_HEAD_INITIALIZER(Aliases));
 
 /* All the variables below are backing for config items */
@@ -216,8 +221,8 @@ WHERE bool FlagSafe;                       ///< Config: Protect flagged messages
 WHERE bool ForwardDecode;                  ///< Config: Decode the message when forwarding it
 WHERE bool ForwardQuote;                   ///< Config: Automatically quote a forwarded message using IndentString
 #ifdef USE_HCACHE
-#if defined(HAVE_QDBM) || defined(HAVE_TC) || defined(HAVE_KC)
-WHERE bool HeaderCacheCompress;            ///< Config: (hcache) Enable database compression (qdbm,tokyocabinet,kyotocabinet)
+#if defined(HAVE_QDBM) || defined(HAVE_TC) || defined(HAVE_KC) || defined(USE_ZLIB)
+WHERE bool HeaderCacheCompress;            ///< Config: (hcache) Enable database compression
 #endif /* HAVE_QDBM */
 #endif
 WHERE bool Header;                         ///< Config: Include the message headers in the reply email (Weed applies)
@@ -266,6 +271,7 @@ WHERE bool WrapSearch;                     ///< Config: Wrap around when the sea
 WHERE bool WriteBcc;                       ///< Config: Write out the 'Bcc' field when preparing to send a mail
 
 WHERE bool CryptUsePka;                    ///< Config: Use GPGME to use PKA (lookup PGP keys using DNS)
+WHERE short CryptVerifyCacheTtl;           ///< Config: (gpgme) Lifetime of cached signature verification results, in seconds
 
 /* PGP options */
 
@@ -65,6 +65,7 @@ static void group_remove(struct Group *g)
   if (!g)
     return;
   mutt_hash_delete(Groups, g->name, g);
+  mutt_hash_destroy(&g->ah);
   mutt_addr_free(&g->as);
   mutt_regexlist_free(&g->rs);
   FREE(&g->name);
@@ -131,6 +132,26 @@ void mutt_group_context_destroy(struct GroupContext **ctx)
   }
 }
 
+/**
+ * group_rehash - Rebuild a Group's address lookup table
+ * @param g Group to rebuild
+ *
+ * Group edits happen at config time; membership tests happen per message in
+ * pattern matching.  Rebuilding the whole table on each edit keeps the edit
+ * paths trivial while mutt_group_match() stays a single lookup.
+ */
+static void group_rehash(struct Group *g)
+{
+  mutt_hash_destroy(&g->ah);
+  if (!g->as)
+    return;
+
+  g->ah = mutt_hash_create(32, MUTT_HASH_STRCASECMP);
+  for (struct Address *ap = g->as; ap; ap = ap->next)
+    if (ap->mailbox)
+      mutt_hash_insert(g->ah, ap->mailbox, ap);
+}
+
 /**
  * group_add_addrlist - Add an Address List to a Group
  * @param g Group to add to
@@ -151,6 +172,7 @@ static void group_add_addrlist(struct Group *g, struct Address *a)
   q = mutt_addr_copy_list(a, false);
   q = mutt_remove_xrefs(g->as, q);
   *p = q;
+  group_rehash(g);
 }
 
 /**
@@ -171,6 +193,7 @@ static int group_remove_addrlist(struct Group *g, struct Address *a)
 
   for (p = a; p; p = p->next)
     mutt_addr_remove_from_list(&g->as, p->mailbox);
+  group_rehash(g);
 
   return 0;
 }
@@ -287,9 +310,8 @@ bool mutt_group_match(struct Group *g, const char *s)
 
   if (mutt_regexlist_match(&g->rs, s))
     return true;
-  for (struct Address *ap = g->as; ap; ap = ap->next)
-    if (ap->mailbox && (mutt_str_strcasecmp(s, ap->mailbox) == 0))
-      return true;
+  if (g->ah && mutt_hash_find(g->ah, s))
+    return true;
 
   return false;
 }
@@ -28,6 +28,7 @@
 
 struct Address;
 struct Buffer;
+struct Hash;
 
 #define MUTT_GROUP   0
 #define MUTT_UNGROUP 1
@@ -38,6 +39,7 @@ struct Buffer;
 struct Group
 {
   struct Address *as;
+  struct Hash *ah; /**< as, hashed by mailbox for O(1) membership tests */
   struct RegexList rs;
   char *name;
 };
@@ -62,8 +62,11 @@ char *PreferredLanguages; ///< Config: Preferred languages for multilingual MIME
 bool ReflowText; ///< Config: Reformat paragraphs of 'format=flowed' text
 char *ShowMultipartAlternative; ///< Config: How to display 'multipart/alternative' MIME parts
 
-#define BUFI_SIZE 1000
-#define BUFO_SIZE 2000
+/* Sized so text display converts in large blocks: iconv (and the stateful
+ * prefix writer behind it) runs once per 16KiB of decoded text rather than
+ * once per kilobyte.  BUFO is bigger because conversions can expand. */
+#define BUFI_SIZE 16384
+#define BUFO_SIZE 32768
 
 #define TXTHTML 1
 #define TXTPLAIN 2
@@ -240,6 +243,18 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
 
   for (d = dest, s = src; *s;)
   {
+    if (*s != '=')
+    {
+      /* bulk-copy the literal run up to the next escape; strchr/memcpy
+       * let libc scan and move whole words at a time */
+      char *esc = strchr(s, '=');
+      size_t run = esc ? (size_t)(esc - s) : strlen(s);
+      memcpy(d, s, run);
+      d += run;
+      s += run;
+      kind = -1;
+      continue;
+    }
     switch ((kind = qp_decode_triple(s, &c)))
     {
       case 0:
@@ -1763,7 +1778,4 @@ void mutt_decode_attachment(struct Body *b, struct State *s)
                   cd);
       break;
   }
-
-  if (cd != (iconv_t)(-1))
-    iconv_close(cd);
 }
@@ -85,6 +85,27 @@ struct HcacheOps
    * @retval num Error, a backend-specific error code
    */
   int (*delete)(void *ctx, const char *key, size_t keylen);
+  /**
+   * store_begin - backend-specific routine to start a batch of stores
+   * @param ctx The backend-specific context retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Optional (may be NULL).  Backends with transaction support can group the
+   * store() calls made until the matching store_commit() into a single
+   * transaction, so that populating the cache for a large folder costs one
+   * fsync instead of one per message.
+   */
+  int (*store_begin)(void *ctx);
+  /**
+   * store_commit - backend-specific routine to commit a batch of stores
+   * @param ctx The backend-specific context retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Optional (may be NULL).  See store_begin().
+   */
+  int (*store_commit)(void *ctx);
   /**
    * close - backend-specific routine to close a context
    * @param ctx The backend-specific context retrieved via open()
@@ -113,4 +134,18 @@ struct HcacheOps
     .backend = hcache_##_name##_backend,                                       \
   };
 
+#define HCACHE_BACKEND_OPS_BATCH(_name)                                        \
+  const struct HcacheOps hcache_##_name##_ops = {                              \
+    .name         = #_name,                                                    \
+    .open         = hcache_##_name##_open,                                     \
+    .fetch        = hcache_##_name##_fetch,                                    \
+    .free         = hcache_##_name##_free,                                     \
+    .store        = hcache_##_name##_store,                                    \
+    .store_begin  = hcache_##_name##_store_begin,                              \
+    .store_commit = hcache_##_name##_store_commit,                             \
+    .delete       = hcache_##_name##_delete,                                   \
+    .close        = hcache_##_name##_close,                                    \
+    .backend      = hcache_##_name##_backend,                                  \
+  };
+
 #endif /* MUTT_HCACHE_BACKEND_H */
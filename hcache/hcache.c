@@ -49,8 +49,13 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
 #include "mutt/mutt.h"
+#include "mutt.h"
 #include "backend.h"
+#include "globals.h"
 #include "hcache.h"
 #include "hcache/hcversion.h"
 
@@ -59,6 +64,9 @@ char *HeaderCacheBackend; ///< Config: (hcache) Header cache backend to use
 
 static unsigned int hcachever = 0x0;
 
+int HcacheHits = 0;   /**< Number of header cache lookups that found a valid entry */
+int HcacheMisses = 0; /**< Number of header cache lookups that found nothing */
+
 #define HCACHE_BACKEND(name) extern const struct HcacheOps hcache_##name##_ops;
 HCACHE_BACKEND(bdb)
 HCACHE_BACKEND(gdbm)
@@ -258,6 +266,8 @@ header_cache_t *mutt_hcache_open(const char *path, const char *folder, hcache_na
   if (!ops)
     return NULL;
 
+  log_trace_add("mutt_hcache_open");
+
   header_cache_t *h = mutt_mem_calloc(1, sizeof(header_cache_t));
 
   /* Calculate the current hcache version from dynamic configuration */
@@ -276,6 +286,12 @@ header_cache_t *mutt_hcache_open(const char *path, const char *folder, hcache_na
     /* Seed with the compiled-in header structure hash */
     mutt_md5_process_bytes(&hcachever, sizeof(hcachever), &ctx);
 
+#ifdef USE_ZLIB
+    /* Blobs carry the compression prefix only when zlib support is compiled
+     * in, so keep the two formats in disjoint version spaces */
+    mutt_md5_process("zlib", &ctx);
+#endif
+
     /* Mix in user's spam list */
     struct ReplaceListNode *sp = NULL;
     STAILQ_FOREACH(sp, &SpamList, entries)
@@ -291,6 +307,22 @@ header_cache_t *mutt_hcache_open(const char *path, const char *folder, hcache_na
       mutt_md5_process(np->regex->pattern, &ctx);
     }
 
+    /* Mix in the attachment counting rules: cached attach_total values are
+     * only valid for the rules they were counted under */
+    static const struct ListHead *attach_lists[] = { &AttachAllow, &AttachExclude,
+                                                     &InlineAllow, &InlineExclude };
+    for (size_t i = 0; i < mutt_array_size(attach_lists); i++)
+    {
+      struct ListNode *lnp = NULL;
+      STAILQ_FOREACH(lnp, attach_lists[i], entries)
+      {
+        const struct AttachMatch *am = (const struct AttachMatch *) lnp->data;
+        mutt_md5_process(am->major, &ctx);
+        mutt_md5_process(am->minor, &ctx);
+      }
+      mutt_md5_process("|", &ctx);
+    }
+
     /* Get a hash and take its bytes as an (unsigned int) hash version */
     mutt_md5_finish_ctx(&ctx, digest.charval);
     hcachever = digest.intval;
@@ -349,15 +381,18 @@ void *mutt_hcache_fetch(header_cache_t *h, const char *key, size_t keylen)
   void *data = mutt_hcache_fetch_raw(h, key, keylen);
   if (!data)
   {
+    HcacheMisses++;
     return NULL;
   }
 
   if (!crc_matches(data, h->crc))
   {
+    HcacheMisses++;
     mutt_hcache_free(h, &data);
     return NULL;
   }
 
+  HcacheHits++;
   return data;
 }
 
@@ -380,6 +415,64 @@ void *mutt_hcache_fetch_raw(header_cache_t *h, const char *key, size_t keylen)
   return ops->fetch(h->ctx, path, keylen);
 }
 
+/**
+ * mutt_hcache_fetch_multi - Fetch and validate a batch of cached headers
+ * @param[in]  h       Header cache handle
+ * @param[in]  keys    Array of message identification strings
+ * @param[in]  keylens Lengths of the strings pointed to by keys
+ * @param[in]  count   Number of keys
+ * @param[out] results Fetched data for each key, or NULL if absent/invalid
+ * @retval num Number of keys found
+ * @retval -1  Error
+ *
+ * Equivalent to calling mutt_hcache_fetch() once per key, but the backend
+ * lookup and the folder prefix are computed only once for the whole batch.
+ * Each non-NULL result must be freed with mutt_hcache_free().
+ * The whole results array is written even on error, so the caller may
+ * consume it without checking the return value.
+ */
+int mutt_hcache_fetch_multi(header_cache_t *h, const char *const *keys,
+                            const size_t *keylens, size_t count, void **results)
+{
+  char path[PATH_MAX];
+  const struct HcacheOps *ops = hcache_get_ops();
+
+  if (!results)
+    return -1;
+  for (size_t i = 0; i < count; i++)
+    results[i] = NULL;
+
+  if (!h || !ops)
+    return -1;
+
+  const size_t flen = mutt_str_strlen(h->folder);
+  if (flen >= sizeof(path))
+    return -1;
+  memcpy(path, h->folder, flen);
+
+  int found = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!keys[i] || ((flen + keylens[i]) >= sizeof(path)))
+      continue;
+    memcpy(path + flen, keys[i], keylens[i]);
+    path[flen + keylens[i]] = '\0';
+
+    void *data = ops->fetch(h->ctx, path, flen + keylens[i]);
+    if (!data)
+      continue;
+    if (!crc_matches(data, h->crc))
+    {
+      ops->free(h->ctx, &data);
+      continue;
+    }
+    results[i] = data;
+    found++;
+  }
+
+  return found;
+}
+
 /**
  * mutt_hcache_free - Multiplexor for HcacheOps::free
  */
@@ -393,6 +486,57 @@ void mutt_hcache_free(header_cache_t *h, void **data)
   ops->free(h->ctx, data);
 }
 
+#ifdef USE_ZLIB
+/**
+ * hcache_wrap_value - Add the compression prefix to a serialized Email
+ * @param[in]     data Blob from mutt_hcache_dump()
+ * @param[in,out] dlen Length of the blob
+ * @retval ptr Replacement blob, the original is freed
+ *
+ * Rewrites the blob as validity + crc + compressed length + original length +
+ * payload, deflating the payload when $header_cache_compress is set.  A
+ * compressed length of zero marks the payload as stored verbatim, which also
+ * happens when deflation would not shrink it or when the backend (qdbm,
+ * tokyocabinet, kyotocabinet) already compresses the database itself.
+ */
+static char *hcache_wrap_value(char *data, int *dlen)
+{
+  const size_t hdrlen = sizeof(union Validate) + sizeof(unsigned int);
+  const unsigned char *payload = (unsigned char *) data + hdrlen;
+  const unsigned int plen = *dlen - hdrlen;
+  unsigned int clen = 0;
+
+  bool deflate = HeaderCacheCompress;
+  const struct HcacheOps *ops = hcache_get_ops();
+  if (ops && ((strcmp(ops->name, "qdbm") == 0) || (strcmp(ops->name, "tokyocabinet") == 0) ||
+              (strcmp(ops->name, "kyotocabinet") == 0)))
+  {
+    deflate = false;
+  }
+
+  char *out = mutt_mem_malloc(hdrlen + 2 * sizeof(unsigned int) +
+                              (deflate ? compressBound(plen) : plen));
+  memcpy(out, data, hdrlen);
+  unsigned char *dst = (unsigned char *) out + hdrlen + 2 * sizeof(unsigned int);
+
+  if (deflate)
+  {
+    uLongf zlen = compressBound(plen);
+    if ((compress2(dst, &zlen, payload, plen, Z_DEFAULT_COMPRESSION) == Z_OK) && (zlen < plen))
+      clen = zlen;
+  }
+  if (clen == 0)
+    memcpy(dst, payload, plen);
+
+  memcpy(out + hdrlen, &clen, sizeof(clen));
+  memcpy(out + hdrlen + sizeof(clen), &plen, sizeof(plen));
+
+  FREE(&data);
+  *dlen = hdrlen + 2 * sizeof(unsigned int) + ((clen != 0) ? clen : plen);
+  return out;
+}
+#endif /* USE_ZLIB */
+
 /**
  * mutt_hcache_store - Multiplexor for HcacheOps::store
  */
@@ -407,6 +551,9 @@ int mutt_hcache_store(header_cache_t *h, const char *key, size_t keylen,
     return -1;
 
   data = mutt_hcache_dump(h, e, &dlen, uidvalidity);
+#ifdef USE_ZLIB
+  data = hcache_wrap_value(data, &dlen);
+#endif
   ret = mutt_hcache_store_raw(h, key, keylen, data, dlen);
 
   FREE(&data);
@@ -438,6 +585,48 @@ int mutt_hcache_store_raw(header_cache_t *h, const char *key, size_t keylen,
   return ops->store(h->ctx, path, keylen, data, dlen);
 }
 
+/**
+ * mutt_hcache_store_begin - Multiplexor for HcacheOps::store_begin
+ * @param h Header cache handle
+ * @retval 0   Success (or the backend has no batch support)
+ * @retval num Backend-specific error code otherwise
+ *
+ * Bracket a bulk series of mutt_hcache_store() calls with
+ * mutt_hcache_store_begin() / mutt_hcache_store_commit() so that backends with
+ * transaction support can write them out with a single fsync.
+ */
+int mutt_hcache_store_begin(header_cache_t *h)
+{
+  const struct HcacheOps *ops = hcache_get_ops();
+
+  if (!h || !ops)
+    return -1;
+
+  if (!ops->store_begin)
+    return 0;
+
+  return ops->store_begin(h->ctx);
+}
+
+/**
+ * mutt_hcache_store_commit - Multiplexor for HcacheOps::store_commit
+ * @param h Header cache handle
+ * @retval 0   Success (or the backend has no batch support)
+ * @retval num Backend-specific error code otherwise
+ */
+int mutt_hcache_store_commit(header_cache_t *h)
+{
+  const struct HcacheOps *ops = hcache_get_ops();
+
+  if (!h || !ops)
+    return -1;
+
+  if (!ops->store_commit)
+    return 0;
+
+  return ops->store_commit(h->ctx);
+}
+
 /**
  * mutt_hcache_delete - Multiplexor for HcacheOps::delete
  */
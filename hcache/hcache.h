@@ -91,6 +91,9 @@ union Validate {
 /* These Config Variables are only used in hcache/hcache.c */
 extern char *HeaderCacheBackend;
 
+extern int HcacheHits;
+extern int HcacheMisses;
+
 /**
  * mutt_hcache_open - open the connection to the header cache
  * @param path   Location of the header cache (often as specified by the user)
@@ -139,6 +142,23 @@ void *mutt_hcache_fetch(header_cache_t *h, const char *key, size_t keylen);
  */
 void *mutt_hcache_fetch_raw(header_cache_t *h, const char *key, size_t keylen);
 
+/**
+ * mutt_hcache_fetch_multi - fetch and validate a batch of messages' headers
+ * @param[in]  h       Pointer to the header_cache_t structure got by mutt_hcache_open
+ * @param[in]  keys    Array of message identification strings
+ * @param[in]  keylens Lengths of the strings pointed to by keys
+ * @param[in]  count   Number of keys
+ * @param[out] results Fetched data for each key, or NULL if absent/invalid
+ * @retval num Number of keys found
+ * @retval -1  Error
+ *
+ * @note Like mutt_hcache_fetch(), each result is validated against the crc
+ *       value of the header_cache_t structure.  Every non-NULL result must be
+ *       freed by calling mutt_hcache_free before closing the header cache.
+ */
+int mutt_hcache_fetch_multi(header_cache_t *h, const char *const *keys,
+                            const size_t *keylens, size_t count, void **results);
+
 /**
  * mutt_hcache_free - free previously fetched data
  * @param h    Pointer to the header_cache_t structure got by mutt_hcache_open
@@ -182,6 +202,27 @@ int mutt_hcache_store(header_cache_t *h, const char *key, size_t keylen,
 int mutt_hcache_store_raw(header_cache_t *h, const char *key, size_t keylen,
                           void *data, size_t dlen);
 
+/**
+ * mutt_hcache_store_begin - start a batch of stores
+ * @param h Pointer to the header_cache_t structure got by mutt_hcache_open
+ * @retval 0   Success (or the backend has no batch support)
+ * @retval num Backend-specific error code otherwise
+ *
+ * Bracket a bulk series of mutt_hcache_store() calls with
+ * mutt_hcache_store_begin() / mutt_hcache_store_commit() so that backends with
+ * transaction support can group them into a single transaction and fsync once,
+ * instead of once per message.
+ */
+int mutt_hcache_store_begin(header_cache_t *h);
+
+/**
+ * mutt_hcache_store_commit - commit a batch of stores
+ * @param h Pointer to the header_cache_t structure got by mutt_hcache_open
+ * @retval 0   Success (or the backend has no batch support)
+ * @retval num Backend-specific error code otherwise
+ */
+int mutt_hcache_store_commit(header_cache_t *h);
+
 /**
  * mutt_hcache_delete - delete a key / data pair
  * @param h      Pointer to the header_cache_t structure got by mutt_hcache_open
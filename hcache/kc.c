@@ -108,6 +108,40 @@ static int hcache_kyotocabinet_store(void *ctx, const char *key, size_t keylen,
   return 0;
 }
 
+/**
+ * hcache_kyotocabinet_store_begin - Implements HcacheOps::store_begin()
+ */
+static int hcache_kyotocabinet_store_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  KCDB *db = ctx;
+  if (!kcdbbegintran(db, false))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * hcache_kyotocabinet_store_commit - Implements HcacheOps::store_commit()
+ */
+static int hcache_kyotocabinet_store_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  KCDB *db = ctx;
+  if (!kcdbendtran(db, true))
+  {
+    int ecode = kcdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * hcache_kyotocabinet_delete - Implements HcacheOps::delete()
  */
@@ -155,4 +189,4 @@ static const char *hcache_kyotocabinet_backend(void)
   return version_cache;
 }
 
-HCACHE_BACKEND_OPS(kyotocabinet)
+HCACHE_BACKEND_OPS_BATCH(kyotocabinet)
@@ -252,6 +252,44 @@ static int hcache_lmdb_store(void *vctx, const char *key, size_t keylen, void *d
   return rc;
 }
 
+/**
+ * hcache_lmdb_store_begin - Implements HcacheOps::store_begin()
+ *
+ * Nothing to do here: the write transaction is created lazily by the first
+ * store() and kept open until store_commit() or close().
+ */
+static int hcache_lmdb_store_begin(void *vctx)
+{
+  if (!vctx)
+    return -1;
+
+  return MDB_SUCCESS;
+}
+
+/**
+ * hcache_lmdb_store_commit - Implements HcacheOps::store_commit()
+ */
+static int hcache_lmdb_store_commit(void *vctx)
+{
+  int rc;
+
+  if (!vctx)
+    return -1;
+
+  struct HcacheLmdbCtx *ctx = vctx;
+
+  if (!ctx->txn || ctx->txn_mode != TXN_WRITE)
+    return MDB_SUCCESS;
+
+  rc = mdb_txn_commit(ctx->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+  ctx->txn_mode = TXN_UNINITIALIZED;
+  ctx->txn = NULL;
+
+  return rc;
+}
+
 /**
  * hcache_lmdb_delete - Implements HcacheOps::delete()
  */
@@ -314,4 +352,4 @@ static const char *hcache_lmdb_backend(void)
   return "lmdb " MDB_VERSION_STRING;
 }
 
-HCACHE_BACKEND_OPS(lmdb)
+HCACHE_BACKEND_OPS_BATCH(lmdb)
@@ -35,9 +35,20 @@
 #include <string.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
 #include "mutt/mutt.h"
 #include "email/lib.h"
 #include "hcache.h"
+#include "globals.h"
+#include "score.h"
+
+/* Capacity of the blob currently being serialised by mutt_hcache_dump().
+ * Dumping is not reentrant, so a single tracker suffices; it lets
+ * lazy_realloc() grow the blob geometrically instead of reallocating on
+ * every field once the blob has outgrown its initial size. */
+static size_t lazy_size = 0;
 
 /**
  * lazy_malloc - Allocate some memory
@@ -52,6 +63,7 @@ static void *lazy_malloc(size_t size)
   if (size < 4096)
     size = 4096;
 
+  lazy_size = size;
   return mutt_mem_malloc(size);
 }
 
@@ -60,16 +72,22 @@ static void *lazy_malloc(size_t size)
  * @param ptr Pointer to resize
  * @param size Minimum size
  *
- * The minimum size is 4KiB to avoid repeated resizing.
+ * The blob is grown by doubling, so serialising a large header costs
+ * O(log n) reallocations rather than one per field.
  */
 static void lazy_realloc(void *ptr, size_t size)
 {
   void **p = (void **) ptr;
 
-  if (p && (size < 4096))
+  if (p && (size <= lazy_size))
     return;
 
-  mutt_mem_realloc(ptr, size);
+  if (lazy_size < 4096)
+    lazy_size = 4096;
+  while (lazy_size < size)
+    lazy_size *= 2;
+
+  mutt_mem_realloc(ptr, lazy_size);
 }
 
 /**
@@ -172,21 +190,22 @@ void serial_restore_char(char **c, const unsigned char *d, int *off, bool conver
     return;
   }
 
-  *c = mutt_mem_malloc(size);
-  memcpy(*c, d + *off, size);
-  if (convert && !mutt_str_is_ascii(*c, size))
+  /* Examine the string while it's still in the fetched blob, so the common
+   * (ascii or no-conversion) case costs a single allocation and copy */
+  if (convert && !mutt_str_is_ascii((const char *) d + *off, size))
   {
-    char *tmp = mutt_str_strdup(*c);
+    char *tmp = mutt_str_substr_dup((const char *) d + *off, (const char *) d + *off + size);
     if (mutt_ch_convert_string(&tmp, "utf-8", Charset, 0) == 0)
     {
-      FREE(c);
       *c = tmp;
+      *off += size;
+      return;
     }
-    else
-    {
-      FREE(&tmp);
-    }
+    FREE(&tmp);
   }
+
+  *c = mutt_mem_malloc(size);
+  memcpy(*c, d + *off, size);
   *off += size;
 }
 
@@ -595,6 +614,13 @@ void *mutt_hcache_dump(header_cache_t *h, const struct Email *e, int *off, unsig
   lazy_realloc(&d, *off + sizeof(struct Email));
   memcpy(&nh, e, sizeof(struct Email));
 
+  /* score the copy, so a cache entry written right after parsing already
+   * carries its score and the rules hash that produced it - the restored
+   * Email then skips the pattern runs entirely.  If the live Email has been
+   * scored, this returns immediately. */
+  if (Score)
+    mutt_score_message(NULL, &nh, false);
+
   /* some fields are not safe to cache */
   nh.tagged = false;
   nh.changed = false;
@@ -607,9 +633,11 @@ void *mutt_hcache_dump(header_cache_t *h, const struct Email *e, int *off, unsig
   nh.num_hidden = 0;
   nh.recipient = 0;
   nh.pair = 0;
-  nh.attach_valid = false;
+  /* attach_valid/attach_total survive the round trip: the cache version
+   * mixes in the attachments rules, so a rules change drops the blobs */
   nh.path = NULL;
   nh.tree = NULL;
+  nh.index_line = NULL;
   nh.thread = NULL;
   STAILQ_INIT(&nh.tags);
 #ifdef MIXMASTER
@@ -644,6 +672,32 @@ struct Email *mutt_hcache_restore(const unsigned char *d)
   /* skip crc */
   off += sizeof(unsigned int);
 
+#ifdef USE_ZLIB
+  /* compression prefix written by mutt_hcache_store(): the payload is
+   * deflated when clen is non-zero, stored verbatim otherwise */
+  unsigned char *inflated = NULL;
+  unsigned int clen = 0;
+  unsigned int ulen = 0;
+  memcpy(&clen, d + off, sizeof(clen));
+  off += sizeof(clen);
+  memcpy(&ulen, d + off, sizeof(ulen));
+  off += sizeof(ulen);
+  if (clen != 0)
+  {
+    inflated = mutt_mem_malloc(ulen);
+    uLongf dlen = ulen;
+    if ((uncompress(inflated, &dlen, d + off, clen) != Z_OK) || (dlen != ulen))
+    {
+      mutt_debug(1, "failed to inflate cached header\n");
+      FREE(&inflated);
+      mutt_email_free(&e);
+      return NULL;
+    }
+    d = inflated;
+    off = 0;
+  }
+#endif
+
   memcpy(e, d + off, sizeof(struct Email));
   off += sizeof(struct Email);
 
@@ -660,5 +714,9 @@ struct Email *mutt_hcache_restore(const unsigned char *d)
 
   serial_restore_char(&e->maildir_flags, d, &off, convert);
 
+#ifdef USE_ZLIB
+  FREE(&inflated);
+#endif
+
   return e;
 }
@@ -99,6 +99,40 @@ static int hcache_tokyocabinet_store(void *ctx, const char *key, size_t keylen,
   return 0;
 }
 
+/**
+ * hcache_tokyocabinet_store_begin - Implements HcacheOps::store_begin()
+ */
+static int hcache_tokyocabinet_store_begin(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  TCBDB *db = ctx;
+  if (!tcbdbtranbegin(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
+/**
+ * hcache_tokyocabinet_store_commit - Implements HcacheOps::store_commit()
+ */
+static int hcache_tokyocabinet_store_commit(void *ctx)
+{
+  if (!ctx)
+    return -1;
+
+  TCBDB *db = ctx;
+  if (!tcbdbtrancommit(db))
+  {
+    int ecode = tcbdbecode(db);
+    return ecode ? ecode : -1;
+  }
+  return 0;
+}
+
 /**
  * hcache_tokyocabinet_delete - Implements HcacheOps::delete()
  */
@@ -141,4 +175,4 @@ static const char *hcache_tokyocabinet_backend(void)
   return "tokyocabinet " _TC_VERSION;
 }
 
-HCACHE_BACKEND_OPS(tokyocabinet)
+HCACHE_BACKEND_OPS_BATCH(tokyocabinet)
@@ -70,6 +70,70 @@ static TAILQ_HEAD(, Hook) Hooks = TAILQ_HEAD_INITIALIZER(Hooks);
 
 static int current_hook_type = 0;
 
+/* bumped whenever the Hooks list changes, so mutt_account_hook() can tell
+ * that its cached "already ran for this URL" answer is stale */
+static unsigned int hooks_gen = 1;
+
+/**
+ * struct HookIndex - Hooks of one type, in registration order
+ */
+struct HookIndex
+{
+  struct Hook **hooks;
+  size_t num;
+  size_t max;
+};
+
+/* One index per hook type bit, so dispatch only visits hooks of the type it
+ * is running instead of regexec'ing its way past every other hook.  Rebuilt
+ * lazily whenever hooks_gen says the Hooks list has changed. */
+static struct HookIndex HookIndexes[32];
+static unsigned int hooks_indexed_gen = 0;
+
+/**
+ * rebuild_hook_index - Regenerate the per-type indexes from the Hooks list
+ */
+static void rebuild_hook_index(void)
+{
+  struct Hook *h = NULL;
+
+  for (int bit = 0; bit < 32; bit++)
+    HookIndexes[bit].num = 0;
+
+  TAILQ_FOREACH(h, &Hooks, entries)
+  {
+    for (int bit = 0; bit < 32; bit++)
+    {
+      if (!(h->type & (1 << bit)))
+        continue;
+      struct HookIndex *idx = &HookIndexes[bit];
+      if (idx->num == idx->max)
+      {
+        idx->max += 64;
+        mutt_mem_realloc(&idx->hooks, idx->max * sizeof(*idx->hooks));
+      }
+      idx->hooks[idx->num++] = h;
+    }
+  }
+  hooks_indexed_gen = hooks_gen;
+}
+
+/**
+ * hook_index - Get the index of Hooks matching a type
+ * @param type Hook type, e.g. #MUTT_FOLDER_HOOK (a single type bit)
+ * @retval ptr Index of matching Hooks (possibly empty, never NULL)
+ */
+static struct HookIndex *hook_index(int type)
+{
+  if (hooks_indexed_gen != hooks_gen)
+    rebuild_hook_index();
+
+  int bit = 0;
+  while (!(type & (1 << bit)))
+    bit++;
+  return &HookIndexes[bit];
+}
+
 /**
  * mutt_parse_hook - Parse the 'hook' family of commands
  * @param buf  Temporary Buffer
@@ -276,6 +340,7 @@ int mutt_parse_hook(struct Buffer *buf, struct Buffer *s, unsigned long data,
   ptr->regex.regex = rx;
   ptr->regex.not = not;
   TAILQ_INSERT_TAIL(&Hooks, ptr, entries);
+  hooks_gen++;
   return 0;
 
 error:
@@ -318,6 +383,7 @@ void mutt_delete_hooks(int type)
     {
       TAILQ_REMOVE(&Hooks, h, entries);
       delete_hook(h);
+      hooks_gen++;
     }
   }
 }
@@ -379,8 +445,8 @@ int mutt_parse_unhook(struct Buffer *buf, struct Buffer *s, unsigned long data,
  */
 void mutt_folder_hook(const char *path)
 {
-  struct Hook *tmp = NULL;
   struct Buffer err, token;
+  struct HookIndex *idx = hook_index(MUTT_FOLDER_HOOK);
 
   current_hook_type = MUTT_FOLDER_HOOK;
 
@@ -388,24 +454,22 @@ void mutt_folder_hook(const char *path)
   err.dsize = STRING;
   err.data = mutt_mem_malloc(err.dsize);
   mutt_buffer_init(&token);
-  TAILQ_FOREACH(tmp, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
+    struct Hook *tmp = idx->hooks[i];
     if (!tmp->command)
       continue;
 
-    if (tmp->type & MUTT_FOLDER_HOOK)
+    if ((regexec(tmp->regex.regex, path, 0, NULL, 0) == 0) ^ tmp->regex.not)
     {
-      if ((regexec(tmp->regex.regex, path, 0, NULL, 0) == 0) ^ tmp->regex.not)
+      if (mutt_parse_rc_line(tmp->command, &token, &err) == -1)
       {
-        if (mutt_parse_rc_line(tmp->command, &token, &err) == -1)
-        {
-          mutt_error("%s", err.data);
-          FREE(&token.data);
-          current_hook_type = 0;
-          FREE(&err.data);
+        mutt_error("%s", err.data);
+        FREE(&token.data);
+        current_hook_type = 0;
+        FREE(&err.data);
 
-          return;
-        }
+        return;
       }
     }
   }
@@ -425,15 +489,13 @@ void mutt_folder_hook(const char *path)
  */
 char *mutt_find_hook(int type, const char *pat)
 {
-  struct Hook *tmp = NULL;
+  struct HookIndex *idx = hook_index(type);
 
-  TAILQ_FOREACH(tmp, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
-    if (tmp->type & type)
-    {
-      if (regexec(tmp->regex.regex, pat, 0, NULL, 0) == 0)
-        return tmp->command;
-    }
+    struct Hook *tmp = idx->hooks[i];
+    if (regexec(tmp->regex.regex, pat, 0, NULL, 0) == 0)
+      return tmp->command;
   }
   return NULL;
 }
@@ -447,8 +509,8 @@ char *mutt_find_hook(int type, const char *pat)
 void mutt_message_hook(struct Context *ctx, struct Email *e, int type)
 {
   struct Buffer err, token;
-  struct Hook *hook = NULL;
   struct PatternCache cache = { 0 };
+  struct HookIndex *idx = hook_index(type);
 
   current_hook_type = type;
 
@@ -456,29 +518,26 @@ void mutt_message_hook(struct Context *ctx, struct Email *e, int type)
   err.dsize = STRING;
   err.data = mutt_mem_malloc(err.dsize);
   mutt_buffer_init(&token);
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
+    struct Hook *hook = idx->hooks[i];
     if (!hook->command)
       continue;
 
-    if (hook->type & type)
+    if ((mutt_pattern_exec(hook->pattern, 0, ctx, e, &cache) > 0) ^ hook->regex.not)
     {
-      if ((mutt_pattern_exec(hook->pattern, 0, ctx, e, &cache) > 0) ^
-          hook->regex.not)
+      if (mutt_parse_rc_line(hook->command, &token, &err) == -1)
       {
-        if (mutt_parse_rc_line(hook->command, &token, &err) == -1)
-        {
-          FREE(&token.data);
-          mutt_error("%s", err.data);
-          current_hook_type = 0;
-          FREE(&err.data);
+        FREE(&token.data);
+        mutt_error("%s", err.data);
+        current_hook_type = 0;
+        FREE(&err.data);
 
-          return;
-        }
-        /* Executing arbitrary commands could affect the pattern results,
-         * so the cache has to be wiped */
-        memset(&cache, 0, sizeof(cache));
+        return;
       }
+      /* Executing arbitrary commands could affect the pattern results,
+       * so the cache has to be wiped */
+      memset(&cache, 0, sizeof(cache));
     }
   }
   FREE(&token.data);
@@ -500,23 +559,20 @@ void mutt_message_hook(struct Context *ctx, struct Email *e, int type)
 static int addr_hook(char *path, size_t pathlen, int type, struct Context *ctx,
                      struct Email *e)
 {
-  struct Hook *hook = NULL;
   struct PatternCache cache = { 0 };
+  struct HookIndex *idx = hook_index(type);
 
   /* determine if a matching hook exists */
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
+    struct Hook *hook = idx->hooks[i];
     if (!hook->command)
       continue;
 
-    if (hook->type & type)
+    if ((mutt_pattern_exec(hook->pattern, 0, ctx, e, &cache) > 0) ^ hook->regex.not)
     {
-      if ((mutt_pattern_exec(hook->pattern, 0, ctx, e, &cache) > 0) ^
-          hook->regex.not)
-      {
-        mutt_make_string(path, pathlen, hook->command, ctx, e);
-        return 0;
-      }
+      mutt_make_string(path, pathlen, hook->command, ctx, e);
+      return 0;
     }
   }
 
@@ -591,12 +647,12 @@ void mutt_select_fcc(char *path, size_t pathlen, struct Email *e)
  */
 static void list_hook(struct ListHead *matches, const char *match, int hook)
 {
-  struct Hook *tmp = NULL;
+  struct HookIndex *idx = hook_index(hook);
 
-  TAILQ_FOREACH(tmp, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
-    if ((tmp->type & hook) && ((match && regexec(tmp->regex.regex, match, 0, NULL, 0) == 0) ^
-                               tmp->regex.not))
+    struct Hook *tmp = idx->hooks[i];
+    if ((match && regexec(tmp->regex.regex, match, 0, NULL, 0) == 0) ^ tmp->regex.not)
     {
       mutt_list_insert_tail(matches, mutt_str_strdup(tmp->command));
     }
@@ -626,22 +682,33 @@ void mutt_account_hook(const char *url)
    * call. We just skip processing if this occurs. Typically such commands
    * belong in a folder-hook -- perhaps we should warn the user. */
   static bool inhook = false;
+  static char last_url[LONG_STRING] = "";
+  static unsigned int last_gen = 0;
 
-  struct Hook *hook = NULL;
   struct Buffer token;
   struct Buffer err;
 
   if (inhook)
     return;
 
+  /* Every connection lookup lands here, including keepalive polls, so this
+   * runs far more often than accounts change.  Re-running the hooks for the
+   * URL they were last run for is redundant - their job is to switch
+   * settings *between* accounts - and just burns regex and parsing time. */
+  if ((last_gen == hooks_gen) && (mutt_str_strcmp(last_url, url) == 0))
+    return;
+
+  struct HookIndex *idx = hook_index(MUTT_ACCOUNT_HOOK);
+
   mutt_buffer_init(&err);
   err.dsize = STRING;
   err.data = mutt_mem_malloc(err.dsize);
   mutt_buffer_init(&token);
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
-    if (!(hook->command && (hook->type & MUTT_ACCOUNT_HOOK)))
+    struct Hook *hook = idx->hooks[i];
+    if (!hook->command)
       continue;
 
     if ((regexec(hook->regex.regex, url, 0, NULL, 0) == 0) ^ hook->regex.not)
@@ -662,6 +729,9 @@ void mutt_account_hook(const char *url)
     }
   }
 
+  mutt_str_strfcpy(last_url, url, sizeof(last_url));
+  last_gen = hooks_gen;
+
   FREE(&token.data);
   FREE(&err.data);
 }
@@ -675,19 +745,20 @@ void mutt_account_hook(const char *url)
  */
 void mutt_timeout_hook(void)
 {
-  struct Hook *hook = NULL;
   struct Buffer token;
   struct Buffer err;
   char buf[STRING];
+  struct HookIndex *idx = hook_index(MUTT_TIMEOUT_HOOK);
 
   mutt_buffer_init(&err);
   err.data = buf;
   err.dsize = sizeof(buf);
   mutt_buffer_init(&token);
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
-    if (!(hook->command && (hook->type & MUTT_TIMEOUT_HOOK)))
+    struct Hook *hook = idx->hooks[i];
+    if (!hook->command)
       continue;
 
     if (mutt_parse_rc_line(hook->command, &token, &err) == -1)
@@ -711,18 +782,19 @@ void mutt_timeout_hook(void)
  */
 void mutt_startup_shutdown_hook(int type)
 {
-  struct Hook *hook = NULL;
   struct Buffer token = { 0 };
   struct Buffer err = { 0 };
   char buf[STRING];
+  struct HookIndex *idx = hook_index(type);
 
   err.data = buf;
   err.dsize = sizeof(buf);
   mutt_buffer_init(&token);
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  for (size_t i = 0; i < idx->num; i++)
   {
-    if (!(hook->command && (hook->type & type)))
+    struct Hook *hook = idx->hooks[i];
+    if (!hook->command)
       continue;
 
     if (mutt_parse_rc_line(hook->command, &token, &err) == -1)
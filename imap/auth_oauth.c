@@ -92,6 +92,7 @@ enum ImapAuthRes imap_auth_oauth(struct ImapMboxData *mdata, const char *method)
     return IMAP_AUTH_SUCCESS;
   }
 
+  mutt_account_forget_oauthbearer(&mdata->conn->account);
   mutt_error(_("OAUTHBEARER authentication failed."));
   return IMAP_AUTH_FAILURE;
 }
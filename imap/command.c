@@ -53,6 +53,9 @@
 #include "mutt_logging.h"
 #include "mutt_socket.h"
 #include "mx.h"
+#ifdef USE_INOTIFY
+#include "monitor.h"
+#endif
 
 /* These Config Variables are only used in imap/command.c */
 bool ImapServernoise; ///< Config: (imap) Display server warnings as error messages
@@ -72,8 +75,8 @@ static const char *const Capabilities[] = {
   "AUTH=GSSAPI", "AUTH=ANONYMOUS", "AUTH=OAUTHBEARER",
   "STARTTLS",    "LOGINDISABLED",  "IDLE",
   "SASL-IR",     "ENABLE",         "CONDSTORE",
-  "QRESYNC",     "X-GM-EXT-1",     "X-GM-EXT1",
-  NULL,
+  "QRESYNC",     "COMPRESS=DEFLATE", "X-GM-EXT-1",
+  "X-GM-EXT1",   NULL,
 };
 
 /**
@@ -209,7 +212,12 @@ static int cmd_start(struct ImapMboxData *mdata, const char *cmdstr, int flags)
 
   /* unidle when command queue is flushed */
   if (mdata->state == IMAP_IDLE)
+  {
     mdata->state = IMAP_SELECTED;
+#ifdef USE_INOTIFY
+    mutt_monitor_unwatch_fd(mdata->conn->fd);
+#endif
+  }
 
   return (rc < 0) ? IMAP_CMD_BAD : 0;
 }
@@ -224,9 +232,9 @@ static int cmd_status(const char *s)
 {
   s = imap_next_word((char *) s);
 
-  if (mutt_str_strncasecmp("OK", s, 2) == 0)
+  if (mutt_str_ascii_strncasecmp("OK", s, 2) == 0)
     return IMAP_CMD_OK;
-  if (mutt_str_strncasecmp("NO", s, 2) == 0)
+  if (mutt_str_ascii_strncasecmp("NO", s, 2) == 0)
     return IMAP_CMD_NO;
 
   return IMAP_CMD_BAD;
@@ -291,7 +299,7 @@ static void cmd_parse_vanished(struct ImapMboxData *mdata, char *s)
 
   mutt_debug(2, "Handling VANISHED\n");
 
-  if (mutt_str_strncasecmp("(EARLIER)", s, 9) == 0)
+  if (mutt_str_ascii_strncasecmp("(EARLIER)", s, 9) == 0)
   {
     /* The RFC says we should not decrement msns with the VANISHED EARLIER tag.
      * My experimentation says that's crap. */
@@ -420,7 +428,7 @@ static void cmd_parse_fetch(struct ImapMboxData *mdata, char *s)
   {
     SKIPWS(s);
 
-    if (mutt_str_strncasecmp("FLAGS", s, 5) == 0)
+    if (mutt_str_ascii_strncasecmp("FLAGS", s, 5) == 0)
     {
       flags = s;
       if (uid_checked)
@@ -444,7 +452,7 @@ static void cmd_parse_fetch(struct ImapMboxData *mdata, char *s)
         return;
       }
     }
-    else if (mutt_str_strncasecmp("UID", s, 3) == 0)
+    else if (mutt_str_ascii_strncasecmp("UID", s, 3) == 0)
     {
       s += 3;
       SKIPWS(s);
@@ -463,7 +471,7 @@ static void cmd_parse_fetch(struct ImapMboxData *mdata, char *s)
         break;
       s = imap_next_word(s);
     }
-    else if (mutt_str_strncasecmp("MODSEQ", s, 6) == 0)
+    else if (mutt_str_ascii_strncasecmp("MODSEQ", s, 6) == 0)
     {
       s += 6;
       SKIPWS(s);
@@ -568,12 +576,12 @@ static void cmd_parse_list(struct ImapMboxData *mdata, char *s)
   s++;
   while (*s)
   {
-    if (mutt_str_strncasecmp(s, "\\NoSelect", 9) == 0)
+    if (mutt_str_ascii_strncasecmp(s, "\\NoSelect", 9) == 0)
       list->noselect = true;
-    else if (mutt_str_strncasecmp(s, "\\NoInferiors", 12) == 0)
+    else if (mutt_str_ascii_strncasecmp(s, "\\NoInferiors", 12) == 0)
       list->noinferiors = true;
     /* See draft-gahrns-imap-child-mailbox-?? */
-    else if (mutt_str_strncasecmp(s, "\\HasNoChildren", 14) == 0)
+    else if (mutt_str_ascii_strncasecmp(s, "\\HasNoChildren", 14) == 0)
       list->noinferiors = true;
 
     s = imap_next_word(s);
@@ -582,7 +590,7 @@ static void cmd_parse_list(struct ImapMboxData *mdata, char *s)
   }
 
   /* Delimiter */
-  if (mutt_str_strncasecmp(s, "NIL", 3) != 0)
+  if (mutt_str_ascii_strncasecmp(s, "NIL", 3) != 0)
   {
     delimbuf[0] = '\0';
     mutt_str_strcat(delimbuf, 5, s);
@@ -947,12 +955,12 @@ static void cmd_parse_enabled(struct ImapMboxData *mdata, const char *s)
 
   while ((s = imap_next_word((char *) s)) && *s != '\0')
   {
-    if ((mutt_str_strncasecmp(s, "UTF8=ACCEPT", 11) == 0) ||
-        (mutt_str_strncasecmp(s, "UTF8=ONLY", 9) == 0))
+    if ((mutt_str_ascii_strncasecmp(s, "UTF8=ACCEPT", 11) == 0) ||
+        (mutt_str_ascii_strncasecmp(s, "UTF8=ONLY", 9) == 0))
     {
       mdata->unicode = 1;
     }
-    if (mutt_str_strncasecmp(s, "QRESYNC", 7) == 0)
+    if (mutt_str_ascii_strncasecmp(s, "QRESYNC", 7) == 0)
       mdata->qresync = 1;
   }
 }
@@ -977,7 +985,7 @@ static int cmd_handle_untagged(struct ImapMboxData *mdata)
     /* EXISTS and EXPUNGE are always related to the SELECTED mailbox for the
      * connection, so update that one.
      */
-    if (mutt_str_strncasecmp("EXISTS", s, 6) == 0)
+    if (mutt_str_ascii_strncasecmp("EXISTS", s, 6) == 0)
     {
       mutt_debug(2, "Handling EXISTS\n");
 
@@ -1009,32 +1017,32 @@ static int cmd_handle_untagged(struct ImapMboxData *mdata)
       }
     }
     /* pn vs. s: need initial seqno */
-    else if (mutt_str_strncasecmp("EXPUNGE", s, 7) == 0)
+    else if (mutt_str_ascii_strncasecmp("EXPUNGE", s, 7) == 0)
       cmd_parse_expunge(mdata, pn);
-    else if (mutt_str_strncasecmp("FETCH", s, 5) == 0)
+    else if (mutt_str_ascii_strncasecmp("FETCH", s, 5) == 0)
       cmd_parse_fetch(mdata, pn);
   }
-  else if ((mdata->state >= IMAP_SELECTED) && (mutt_str_strncasecmp("VANISHED", s, 8) == 0))
+  else if ((mdata->state >= IMAP_SELECTED) && (mutt_str_ascii_strncasecmp("VANISHED", s, 8) == 0))
     cmd_parse_vanished(mdata, pn);
-  else if (mutt_str_strncasecmp("CAPABILITY", s, 10) == 0)
+  else if (mutt_str_ascii_strncasecmp("CAPABILITY", s, 10) == 0)
     cmd_parse_capability(mdata, s);
-  else if (mutt_str_strncasecmp("OK [CAPABILITY", s, 14) == 0)
+  else if (mutt_str_ascii_strncasecmp("OK [CAPABILITY", s, 14) == 0)
     cmd_parse_capability(mdata, pn);
-  else if (mutt_str_strncasecmp("OK [CAPABILITY", pn, 14) == 0)
+  else if (mutt_str_ascii_strncasecmp("OK [CAPABILITY", pn, 14) == 0)
     cmd_parse_capability(mdata, imap_next_word(pn));
-  else if (mutt_str_strncasecmp("LIST", s, 4) == 0)
+  else if (mutt_str_ascii_strncasecmp("LIST", s, 4) == 0)
     cmd_parse_list(mdata, s);
-  else if (mutt_str_strncasecmp("LSUB", s, 4) == 0)
+  else if (mutt_str_ascii_strncasecmp("LSUB", s, 4) == 0)
     cmd_parse_lsub(mdata, s);
-  else if (mutt_str_strncasecmp("MYRIGHTS", s, 8) == 0)
+  else if (mutt_str_ascii_strncasecmp("MYRIGHTS", s, 8) == 0)
     cmd_parse_myrights(mdata, s);
-  else if (mutt_str_strncasecmp("SEARCH", s, 6) == 0)
+  else if (mutt_str_ascii_strncasecmp("SEARCH", s, 6) == 0)
     cmd_parse_search(mdata, s);
-  else if (mutt_str_strncasecmp("STATUS", s, 6) == 0)
+  else if (mutt_str_ascii_strncasecmp("STATUS", s, 6) == 0)
     cmd_parse_status(mdata, s);
-  else if (mutt_str_strncasecmp("ENABLED", s, 7) == 0)
+  else if (mutt_str_ascii_strncasecmp("ENABLED", s, 7) == 0)
     cmd_parse_enabled(mdata, s);
-  else if (mutt_str_strncasecmp("BYE", s, 3) == 0)
+  else if (mutt_str_ascii_strncasecmp("BYE", s, 3) == 0)
   {
     mutt_debug(2, "Handling BYE\n");
 
@@ -1050,7 +1058,7 @@ static int cmd_handle_untagged(struct ImapMboxData *mdata)
 
     return -1;
   }
-  else if (ImapServernoise && (mutt_str_strncasecmp("NO", s, 2) == 0))
+  else if (ImapServernoise && (mutt_str_ascii_strncasecmp("NO", s, 2) == 0))
   {
     mutt_debug(2, "Handling untagged NO\n");
 
@@ -1104,8 +1112,11 @@ int imap_cmd_step(struct ImapMboxData *mdata)
   {
     if (len == mdata->blen)
     {
-      mutt_mem_realloc(&mdata->buf, mdata->blen + IMAP_CMD_BUFSIZE);
-      mdata->blen = mdata->blen + IMAP_CMD_BUFSIZE;
+      /* grow geometrically: long lines (e.g. untagged FETCH responses
+       * carrying literals) would otherwise loop here once per
+       * IMAP_CMD_BUFSIZE bytes */
+      mdata->blen += MAX(IMAP_CMD_BUFSIZE, mdata->blen / 2);
+      mutt_mem_realloc(&mdata->buf, mdata->blen);
       mutt_debug(3, "grew buffer to %u bytes\n", mdata->blen);
     }
 
@@ -1225,9 +1236,9 @@ const char *imap_cmd_trailer(struct ImapMboxData *mdata)
   }
 
   s = imap_next_word((char *) s);
-  if (!s || ((mutt_str_strncasecmp(s, "OK", 2) != 0) &&
-             (mutt_str_strncasecmp(s, "NO", 2) != 0) &&
-             (mutt_str_strncasecmp(s, "BAD", 3) != 0)))
+  if (!s || ((mutt_str_ascii_strncasecmp(s, "OK", 2) != 0) &&
+             (mutt_str_ascii_strncasecmp(s, "NO", 2) != 0) &&
+             (mutt_str_ascii_strncasecmp(s, "BAD", 3) != 0)))
   {
     mutt_debug(2, "not a command completion: %s\n", mdata->buf);
     return notrailer;
@@ -1257,6 +1268,8 @@ const char *imap_cmd_trailer(struct ImapMboxData *mdata)
  * * IMAP_CMD_PASS: command contains a password. Suppress logging.
  * * IMAP_CMD_QUEUE: only queue command, do not execute.
  * * IMAP_CMD_POLL: poll the socket for a response before running imap_cmd_step.
+ * * IMAP_CMD_ASYNC: send the command but don't wait for its response; the
+ *       pipeline collects it whenever the connection is next read.
  */
 int imap_exec(struct ImapMboxData *mdata, const char *cmdstr, int flags)
 {
@@ -1269,7 +1282,7 @@ int imap_exec(struct ImapMboxData *mdata, const char *cmdstr, int flags)
     return -1;
   }
 
-  if (flags & IMAP_CMD_QUEUE)
+  if (flags & (IMAP_CMD_QUEUE | IMAP_CMD_ASYNC))
     return 0;
 
   if ((flags & IMAP_CMD_POLL) && (ImapPollTimeout > 0) &&
@@ -1281,11 +1294,15 @@ int imap_exec(struct ImapMboxData *mdata, const char *cmdstr, int flags)
   }
 
   /* Allow interruptions, particularly useful if there are network problems. */
+  log_trace_add("imap_exec: start");
   mutt_sig_allow_interrupt(1);
   do
     rc = imap_cmd_step(mdata);
   while (rc == IMAP_CMD_CONTINUE);
   mutt_sig_allow_interrupt(0);
+  log_trace_add("imap_exec: done");
+  if (mdata->ctx)
+    mdata->ctx->mailbox->open_rtt++;
 
   if (rc == IMAP_CMD_NO && (flags & IMAP_CMD_FAIL_OK))
     return -2;
@@ -1382,6 +1399,10 @@ int imap_cmd_idle(struct ImapMboxData *mdata)
   {
     /* successfully entered IDLE state */
     mdata->state = IMAP_IDLE;
+#ifdef USE_INOTIFY
+    /* let the server's unsolicited responses wake the event loop */
+    mutt_monitor_watch_fd(mdata->conn->fd);
+#endif
     /* queue automatic exit when next command is issued */
     mutt_buffer_printf(mdata->cmdbuf, "DONE\r\n");
     rc = IMAP_CMD_OK;
@@ -58,6 +58,9 @@
 #include "pattern.h"
 #include "progress.h"
 #include "sort.h"
+#ifdef USE_INOTIFY
+#include "monitor.h"
+#endif
 #ifdef USE_HCACHE
 #include "hcache/hcache.h"
 #endif
@@ -66,6 +69,7 @@
 #endif
 
 /* These Config Variables are only used in imap/imap.c */
+bool ImapDeflate; ///< Config: (imap) Compress network traffic via COMPRESS=DEFLATE
 bool ImapIdle; ///< Config: (imap) Use the IMAP IDLE extension to check for new mail
 
 /**
@@ -165,98 +169,74 @@ static void set_flag(struct ImapMboxData *mdata, int aclbit, int flag,
 }
 
 /**
- * make_msg_set - Make a message set
- * @param[in]  mdata   Imap Mailbox data
- * @param[in]  buf     Buffer to store message set
- * @param[in]  flag    Flags to match, e.g. #MUTT_DELETED
- * @param[in]  changed Matched messages that have been altered
- * @param[in]  invert  Flag matches should be inverted
- * @param[out] pos     Cursor used for multiple calls to this function
- * @retval num Messages in the set
- *
- * @note Headers must be in SORT_ORDER. See imap_exec_msgset() for args.
- * Pos is an opaque pointer a la strtok(). It should be 0 at first call.
+ * msg_matches_flag - Does this message belong in the message set?
+ * @param e       Email
+ * @param flag    Flag to match, e.g. #MUTT_DELETED
+ * @param changed Matched messages that have been altered
+ * @param invert  Flag matches should be inverted
+ * @retval true If the message matches
  */
-static int make_msg_set(struct ImapMboxData *mdata, struct Buffer *buf,
-                        int flag, bool changed, bool invert, int *pos)
+static bool msg_matches_flag(struct Email *e, int flag, bool changed, bool invert)
 {
-  int count = 0;             /* number of messages in message set */
-  unsigned int setstart = 0; /* start of current message range */
-  int n;
-  bool started = false;
-  struct Email **emails = mdata->ctx->mailbox->hdrs;
-
-  for (n = *pos; n < mdata->ctx->mailbox->msg_count && buf->dptr - buf->data < IMAP_MAX_CMDLEN;
-       n++)
-  {
-    bool match = false; /* whether current message matches flag condition */
-    /* don't include pending expunged messages */
-    if (emails[n]->active)
-    {
-      switch (flag)
-      {
-        case MUTT_DELETED:
-          if (emails[n]->deleted != IMAP_EDATA(emails[n])->deleted)
-            match = invert ^ emails[n]->deleted;
-          break;
-        case MUTT_FLAG:
-          if (emails[n]->flagged != IMAP_EDATA(emails[n])->flagged)
-            match = invert ^ emails[n]->flagged;
-          break;
-        case MUTT_OLD:
-          if (emails[n]->old != IMAP_EDATA(emails[n])->old)
-            match = invert ^ emails[n]->old;
-          break;
-        case MUTT_READ:
-          if (emails[n]->read != IMAP_EDATA(emails[n])->read)
-            match = invert ^ emails[n]->read;
-          break;
-        case MUTT_REPLIED:
-          if (emails[n]->replied != IMAP_EDATA(emails[n])->replied)
-            match = invert ^ emails[n]->replied;
-          break;
-        case MUTT_TAG:
-          if (emails[n]->tagged)
-            match = true;
-          break;
-        case MUTT_TRASH:
-          if (emails[n]->deleted && !emails[n]->purge)
-            match = true;
-          break;
-      }
-    }
+  bool match = false;
 
-    if (match && (!changed || emails[n]->changed))
-    {
-      count++;
-      if (setstart == 0)
-      {
-        setstart = IMAP_EDATA(emails[n])->uid;
-        if (!started)
-        {
-          mutt_buffer_printf(buf, "%u", IMAP_EDATA(emails[n])->uid);
-          started = true;
-        }
-        else
-          mutt_buffer_printf(buf, ",%u", IMAP_EDATA(emails[n])->uid);
-      }
-      /* tie up if the last message also matches */
-      else if (n == mdata->ctx->mailbox->msg_count - 1)
-        mutt_buffer_printf(buf, ":%u", IMAP_EDATA(emails[n])->uid);
-    }
-    /* End current set if message doesn't match or we've reached the end
-     * of the mailbox via inactive messages following the last match. */
-    else if (setstart && (emails[n]->active || n == mdata->ctx->mailbox->msg_count - 1))
-    {
-      if (IMAP_EDATA(emails[n - 1])->uid > setstart)
-        mutt_buffer_printf(buf, ":%u", IMAP_EDATA(emails[n - 1])->uid);
-      setstart = 0;
-    }
+  /* don't include pending expunged messages */
+  if (!e->active)
+    return false;
+
+  switch (flag)
+  {
+    case MUTT_DELETED:
+      if (e->deleted != IMAP_EDATA(e)->deleted)
+        match = invert ^ e->deleted;
+      break;
+    case MUTT_FLAG:
+      if (e->flagged != IMAP_EDATA(e)->flagged)
+        match = invert ^ e->flagged;
+      break;
+    case MUTT_OLD:
+      if (e->old != IMAP_EDATA(e)->old)
+        match = invert ^ e->old;
+      break;
+    case MUTT_READ:
+      if (e->read != IMAP_EDATA(e)->read)
+        match = invert ^ e->read;
+      break;
+    case MUTT_REPLIED:
+      if (e->replied != IMAP_EDATA(e)->replied)
+        match = invert ^ e->replied;
+      break;
+    case MUTT_TAG:
+      if (e->tagged)
+        match = true;
+      break;
+    case MUTT_TRASH:
+      if (e->deleted && !e->purge)
+        match = true;
+      break;
   }
 
-  *pos = n;
+  return match && (!changed || e->changed);
+}
 
-  return count;
+/**
+ * compare_uid - Compare two UIDs for qsort
+ * @param a First UID
+ * @param b Second UID
+ * @retval -1 a < b
+ * @retval  0 a == b
+ * @retval  1 a > b
+ */
+static int compare_uid(const void *a, const void *b)
+{
+  const unsigned int ua = *(const unsigned int *) a;
+  const unsigned int ub = *(const unsigned int *) b;
+
+  if (ua < ub)
+    return -1;
+  if (ua > ub)
+    return 1;
+  return 0;
 }
 
 /**
@@ -776,7 +756,7 @@ void imap_logout_all(void)
 int imap_read_literal(FILE *fp, struct ImapMboxData *mdata, unsigned long bytes,
                       struct Progress *pbar)
 {
-  char c;
+  char chunk[MUTT_CONN_BUFLEN];
   bool r = false;
   struct Buffer *buf = NULL;
 
@@ -785,9 +765,13 @@ int imap_read_literal(FILE *fp, struct ImapMboxData *mdata, unsigned long bytes,
 
   mutt_debug(2, "reading %ld bytes\n", bytes);
 
-  for (unsigned long pos = 0; pos < bytes; pos++)
+  for (unsigned long pos = 0; pos < bytes;)
   {
-    if (mutt_socket_readchar(mdata->conn, &c) != 1)
+    size_t want = bytes - pos;
+    if (want > sizeof(chunk))
+      want = sizeof(chunk);
+    const int len = mutt_socket_readbuf(mdata->conn, chunk, want);
+    if (len <= 0)
     {
       mutt_debug(1, "error during read, %ld bytes read\n", pos);
       mdata->status = IMAP_FATAL;
@@ -795,24 +779,42 @@ int imap_read_literal(FILE *fp, struct ImapMboxData *mdata, unsigned long bytes,
       mutt_buffer_free(&buf);
       return -1;
     }
+    pos += len;
 
-    if (r && c != '\n')
-      fputc('\r', fp);
-
-    if (c == '\r')
+    /* strip CRs from CRLF pairs: write out the spans between CRs and hold
+     * back each CR until the following byte shows whether to keep it.  The
+     * held CR may arrive in the next chunk (or be the literal's last byte,
+     * in which case it is dropped, as the per-byte version did) */
+    const char *p = chunk;
+    const char *end = chunk + len;
+    while (p < end)
     {
+      if (r)
+      {
+        r = false;
+        if (*p != '\n')
+        {
+          fputc('\r', fp);
+          if (buf)
+            mutt_buffer_addch(buf, '\r');
+        }
+      }
+      const char *cr = memchr(p, '\r', end - p);
+      const size_t span = cr ? (size_t) (cr - p) : (size_t) (end - p);
+      if (span != 0)
+      {
+        fwrite(p, 1, span, fp);
+        if (buf)
+          mutt_buffer_add(buf, p, span);
+      }
+      if (!cr)
+        break;
       r = true;
-      continue;
+      p = cr + 1;
     }
-    else
-      r = false;
 
-    fputc(c, fp);
-
-    if (pbar && !(pos % 1024))
+    if (pbar)
       mutt_progress_update(pbar, pos, -1);
-    if (DebugLevel >= IMAP_LOG_LTRL)
-      mutt_buffer_addch(buf, c);
   }
 
   if (DebugLevel >= IMAP_LOG_LTRL)
@@ -1007,6 +1009,19 @@ struct ImapMboxData *imap_conn_find(const struct ConnAccount *account, int flags
 
     /* we may need the root delimiter before we open a mailbox */
     imap_exec(mdata, NULL, IMAP_CMD_FAIL_OK);
+
+#ifdef USE_ZLIB
+    /* RFC4978 COMPRESS=DEFLATE.  Negotiated last, with the pipeline drained:
+     * everything after the server's OK is a deflate stream. */
+    if (ImapDeflate && mutt_bit_isset(mdata->capabilities, COMPRESS))
+    {
+      if (imap_exec(mdata, "COMPRESS DEFLATE", IMAP_CMD_FAIL_OK) == 0)
+      {
+        mutt_debug(2, "IMAP compression enabled\n");
+        mutt_zstrm_wrap_conn(mdata->conn);
+      }
+    }
+#endif
   }
 
   return mdata;
@@ -1114,6 +1129,9 @@ void imap_close_connection(struct ImapMboxData *mdata)
 {
   if (mdata->state != IMAP_DISCONNECTED)
   {
+#ifdef USE_INOTIFY
+    mutt_monitor_unwatch_fd(mdata->conn->fd);
+#endif
     mutt_socket_close(mdata->conn);
     mdata->state = IMAP_DISCONNECTED;
   }
@@ -1189,62 +1207,70 @@ bool imap_has_flag(struct ListHead *flag_list, const char *flag)
 int imap_exec_msgset(struct ImapMboxData *mdata, const char *pre,
                      const char *post, int flag, bool changed, bool invert)
 {
-  struct Email **emails = NULL;
-  short oldsort;
-  int pos;
-  int rc;
-  int count = 0;
-
-  struct Buffer *cmd = mutt_buffer_new();
+  struct Mailbox *m = mdata->ctx->mailbox;
+  int rc = 0;
+  int pos = 0;
+
+  /* Collect the matching UIDs up front.  The set is built from the UIDs
+   * alone, so the header array can stay in whatever order the user sorted
+   * it - no more temporary re-sort of m->hdrs per call. */
+  unsigned int *uids = mutt_mem_malloc(m->msg_count * sizeof(unsigned int));
+  int num_uids = 0;
+  for (int n = 0; n < m->msg_count; n++)
+  {
+    /* cheap pre-filter: during a flag sync, the ten passes over the
+     * mailbox (five flags, set and clear) prune on the dirty bit before
+     * looking at any flag state */
+    if (changed && !m->hdrs[n]->changed)
+      continue;
+    if (msg_matches_flag(m->hdrs[n], flag, changed, invert))
+      uids[num_uids++] = IMAP_EDATA(m->hdrs[n])->uid;
+  }
 
-  /* We make a copy of the headers just in case resorting doesn't give
-   exactly the original order (duplicate messages?), because other parts of
-   the ctx are tied to the header order. This may be overkill. */
-  oldsort = Sort;
-  if (Sort != SORT_ORDER)
+  if (num_uids == 0)
   {
-    emails = mdata->ctx->mailbox->hdrs;
-    mdata->ctx->mailbox->hdrs =
-        mutt_mem_malloc(mdata->ctx->mailbox->msg_count * sizeof(struct Email *));
-    memcpy(mdata->ctx->mailbox->hdrs, emails,
-           mdata->ctx->mailbox->msg_count * sizeof(struct Email *));
-
-    Sort = SORT_ORDER;
-    qsort(mdata->ctx->mailbox->hdrs, mdata->ctx->mailbox->msg_count,
-          sizeof(struct Email *), mutt_get_sort_func(SORT_ORDER));
+    FREE(&uids);
+    return 0;
   }
 
-  pos = 0;
+  qsort(uids, num_uids, sizeof(unsigned int), compare_uid);
 
-  do
+  struct Buffer *cmd = mutt_buffer_new();
+
+  while (pos < num_uids)
   {
     cmd->dptr = cmd->data;
     mutt_buffer_printf(cmd, "%s ", pre);
-    rc = make_msg_set(mdata, cmd, flag, changed, invert, &pos);
-    if (rc > 0)
+
+    /* emit coalesced "start:end" ranges until the command is full */
+    bool started = false;
+    while ((pos < num_uids) && ((cmd->dptr - cmd->data) < IMAP_MAX_CMDLEN))
     {
-      mutt_buffer_printf(cmd, " %s", post);
-      if (imap_exec(mdata, cmd->data, IMAP_CMD_QUEUE))
-      {
-        rc = -1;
-        goto out;
-      }
-      count += rc;
+      const unsigned int start = uids[pos];
+      unsigned int end = start;
+      while (((pos + 1) < num_uids) && (uids[pos + 1] == (end + 1)))
+        end = uids[++pos];
+      pos++;
+
+      if (end > start)
+        mutt_buffer_printf(cmd, started ? ",%u:%u" : "%u:%u", start, end);
+      else
+        mutt_buffer_printf(cmd, started ? ",%u" : "%u", start);
+      started = true;
     }
-  } while (rc > 0);
 
-  rc = count;
+    mutt_buffer_printf(cmd, " %s", post);
+    if (imap_exec(mdata, cmd->data, IMAP_CMD_QUEUE))
+    {
+      rc = -1;
+      break;
+    }
+  }
 
-out:
   mutt_buffer_free(&cmd);
-  if (oldsort != Sort)
-  {
-    Sort = oldsort;
-    FREE(&mdata->ctx->mailbox->hdrs);
-    mdata->ctx->mailbox->hdrs = emails;
-  }
+  FREE(&uids);
 
-  return rc;
+  return (rc < 0) ? -1 : num_uids;
 }
 
 /**
@@ -2004,8 +2030,6 @@ int imap_sync_mailbox(struct Context *ctx, bool expunge)
 {
   struct Context *appendctx = NULL;
   struct Email *e = NULL;
-  struct Email **emails = NULL;
-  int oldsort;
   int rc;
 
   struct ImapMboxData *mdata = ctx->mailbox->data;
@@ -2095,20 +2119,8 @@ int imap_sync_mailbox(struct Context *ctx, bool expunge)
   imap_hcache_close(mdata);
 #endif
 
-  /* presort here to avoid doing 10 resorts in imap_exec_msgset */
-  oldsort = Sort;
-  if (Sort != SORT_ORDER)
-  {
-    emails = ctx->mailbox->hdrs;
-    ctx->mailbox->hdrs =
-        mutt_mem_malloc(ctx->mailbox->msg_count * sizeof(struct Email *));
-    memcpy(ctx->mailbox->hdrs, emails, ctx->mailbox->msg_count * sizeof(struct Email *));
-
-    Sort = SORT_ORDER;
-    qsort(ctx->mailbox->hdrs, ctx->mailbox->msg_count, sizeof(struct Email *),
-          mutt_get_sort_func(SORT_ORDER));
-  }
-
+  /* no presort needed: imap_exec_msgset builds its sets from UIDs and
+   * doesn't care about the order of the header array */
   rc = sync_helper(mdata, MUTT_ACL_DELETE, MUTT_DELETED, "\\Deleted");
   if (rc >= 0)
     rc |= sync_helper(mdata, MUTT_ACL_WRITE, MUTT_FLAG, "\\Flagged");
@@ -2119,13 +2131,6 @@ int imap_sync_mailbox(struct Context *ctx, bool expunge)
   if (rc >= 0)
     rc |= sync_helper(mdata, MUTT_ACL_WRITE, MUTT_REPLIED, "\\Answered");
 
-  if (oldsort != Sort)
-  {
-    Sort = oldsort;
-    FREE(&ctx->mailbox->hdrs);
-    ctx->mailbox->hdrs = emails;
-  }
-
   /* Flush the queued flags if any were changed in sync_helper. */
   if (rc > 0)
     if (imap_exec(mdata, NULL, 0) != IMAP_CMD_OK)
@@ -62,6 +62,7 @@ struct Pattern;
 extern char *ImapAuthenticators;
 
 /* These Config Variables are only used in imap/imap.c */
+extern bool ImapDeflate;
 extern bool ImapIdle;
 
 /* These Config Variables are only used in imap/message.c */
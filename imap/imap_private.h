@@ -76,10 +76,14 @@ struct Progress;
 #define IMAP_CMD_PASS    (1 << 1)
 #define IMAP_CMD_QUEUE   (1 << 2)
 #define IMAP_CMD_POLL    (1 << 3)
+#define IMAP_CMD_ASYNC   (1 << 4)
 
 /* length of "DD-MMM-YYYY HH:MM:SS +ZZzz" (null-terminated) */
 #define IMAP_DATELEN 27
 
+/* number of header cache entries fetched per batch */
+#define IMAP_HCACHE_BATCH 128
+
 /**
  * enum ImapFlags - IMAP server responses
  */
@@ -137,6 +141,7 @@ enum ImapCaps
   ENABLE,                /**< RFC5161 */
   CONDSTORE,             /**< RFC7162 */
   QRESYNC,               /**< RFC7162 */
+  COMPRESS,              /**< RFC4978: COMPRESS=DEFLATE */
   X_GM_EXT1,             /**< https://developers.google.com/gmail/imap/imap-extensions */
   X_GM_ALT1 = X_GM_EXT1, /**< Alternative capability string */
 
@@ -334,6 +339,8 @@ int imap_msg_commit(struct Context *ctx, struct Message *msg);
 header_cache_t *imap_hcache_open(struct ImapMboxData *mdata, const char *path);
 void imap_hcache_close(struct ImapMboxData *mdata);
 struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid);
+int imap_hcache_get_multi(struct ImapMboxData *mdata, const unsigned int *uids,
+                          size_t count, struct Email **emails);
 int imap_hcache_put(struct ImapMboxData *mdata, struct Email *e);
 int imap_hcache_del(struct ImapMboxData *mdata, unsigned int uid);
 int imap_hcache_store_uid_seqset(struct ImapMboxData *mdata);
@@ -800,16 +800,34 @@ static int read_headers_qresync_eval_cache(struct ImapMboxData *mdata, char *uid
   if (!iter)
     return -1;
 
-  while ((rc = mutt_seqset_iterator_next(iter, &uid)) == 0)
+  rc = 0;
+  while (rc == 0)
   {
-    /* The seqset may contain more headers than the fetch request, so
-     * we need to watch and reallocate the context and msn_index */
-    if (msn > mdata->msn_index_size)
-      alloc_msn_index(mdata, msn);
+    /* Collect a batch of UIDs from the seqset, so the header cache can be
+     * queried with a single call per batch */
+    unsigned int uids[IMAP_HCACHE_BATCH];
+    struct Email *emails[IMAP_HCACHE_BATCH];
+    size_t n = 0;
+
+    while ((n < IMAP_HCACHE_BATCH) && ((rc = mutt_seqset_iterator_next(iter, &uid)) == 0))
+      uids[n++] = uid;
+
+    if (n == 0)
+      break;
+
+    imap_hcache_get_multi(mdata, uids, n, emails);
 
-    struct Email *e = imap_hcache_get(mdata, uid);
-    if (e)
+    for (size_t i = 0; i < n; i++)
     {
+      /* The seqset may contain more headers than the fetch request, so
+       * we need to watch and reallocate the context and msn_index */
+      if (msn > mdata->msn_index_size)
+        alloc_msn_index(mdata, msn);
+
+      struct Email *e = emails[i];
+      if (!e)
+        continue;
+
       mdata->max_msn = MAX(mdata->max_msn, msn);
       mdata->msn_index[msn - 1] = e;
 
@@ -830,8 +848,8 @@ static int read_headers_qresync_eval_cache(struct ImapMboxData *mdata, char *uid
       edata->replied = e->replied;
 
       edata->msn = msn;
-      edata->uid = uid;
-      mutt_hash_int_insert(mdata->uid_hash, uid, e);
+      edata->uid = uids[i];
+      mutt_hash_int_insert(mdata->uid_hash, uids[i], e);
 
       ctx->mailbox->size += e->content->length;
       ctx->mailbox->hdrs[ctx->mailbox->msg_count++] = e;
@@ -945,7 +963,12 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
   unsigned int fetch_msn_end = 0;
   struct Progress progress;
   char *hdrreq = NULL;
+#ifdef USE_FMEMOPEN
+  char *hdr_buf = NULL;
+  size_t hdr_buflen = 0;
+#else
   char tempfile[_POSIX_PATH_MAX];
+#endif
   FILE *fp = NULL;
   struct ImapHeader h;
   static const char *const want_headers =
@@ -974,6 +997,14 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
 
   /* instead of downloading all headers and then parsing them, we parse them
    * as they come in. */
+#ifdef USE_FMEMOPEN
+  fp = open_memstream(&hdr_buf, &hdr_buflen);
+  if (!fp)
+  {
+    mutt_error(_("Error opening 'memory stream'"));
+    goto bail;
+  }
+#else
   mutt_mktemp(tempfile, sizeof(tempfile));
   fp = mutt_file_fopen(tempfile, "w+");
   if (!fp)
@@ -982,13 +1013,14 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
     goto bail;
   }
   unlink(tempfile);
+#endif
 
   mutt_progress_init(&progress, _("Fetching message headers..."),
                      MUTT_PROGRESS_MSG, ReadInc, msn_end);
 
   while ((msn_begin <= msn_end) && (fetch_msn_end < msn_end))
   {
-    struct Buffer *b = mutt_buffer_new();
+    struct Buffer *b = mutt_buffer_pool_get();
     if (evalhc)
     {
       /* In case there are holes in the header cache. */
@@ -1003,7 +1035,7 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
     safe_asprintf(&cmd, "FETCH %s (UID FLAGS INTERNALDATE RFC822.SIZE %s)", b->data, hdrreq);
     imap_cmd_start(mdata, cmd);
     FREE(&cmd);
-    mutt_buffer_free(&b);
+    mutt_buffer_pool_release(&b);
 
     rc = IMAP_CMD_CONTINUE;
     for (int msgno = msn_begin; rc == IMAP_CMD_CONTINUE; msgno++)
@@ -1080,11 +1112,26 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
         if (*maxuid < h.data->uid)
           *maxuid = h.data->uid;
 
-        rewind(fp);
         /* NOTE: if Date: header is missing, mutt_rfc822_read_header depends
          *   on h.received being set */
+#ifdef USE_FMEMOPEN
+        /* The memory stream is write-only, so parse the headers back through
+         * a read-only window onto its buffer */
+        fflush(fp);
+        FILE *hdr_fp = fmemopen(hdr_buf, ftello(fp), "r");
+        if (hdr_fp)
+        {
+          ctx->mailbox->hdrs[idx]->env =
+              mutt_rfc822_read_header(hdr_fp, ctx->mailbox->hdrs[idx], false, false);
+          mutt_file_fclose(&hdr_fp);
+        }
+        else
+          ctx->mailbox->hdrs[idx]->env = mutt_env_new();
+#else
+        rewind(fp);
         ctx->mailbox->hdrs[idx]->env =
             mutt_rfc822_read_header(fp, ctx->mailbox->hdrs[idx], false, false);
+#endif
         /* content built as a side-effect of mutt_rfc822_read_header */
         ctx->mailbox->hdrs[idx]->content->length = h.content_length;
         ctx->mailbox->size += h.content_length;
@@ -1129,6 +1176,9 @@ static int read_headers_fetch_new(struct ImapMboxData *mdata, unsigned int msn_b
 
 bail:
   mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+  FREE(&hdr_buf);
+#endif
   FREE(&hdrreq);
 
   return retval;
@@ -1183,6 +1233,7 @@ int imap_read_headers(struct ImapMboxData *mdata, unsigned int msn_begin,
 
 #ifdef USE_HCACHE
   mdata->hcache = imap_hcache_open(mdata, NULL);
+  mutt_hcache_store_begin(mdata->hcache);
 
   if (mdata->hcache && initial_download)
   {
@@ -1323,6 +1374,7 @@ int imap_read_headers(struct ImapMboxData *mdata, unsigned int msn_begin,
 
 bail:
 #ifdef USE_HCACHE
+  mutt_hcache_store_commit(mdata->hcache);
   imap_hcache_close(mdata);
   FREE(&uid_seqset);
 #endif /* USE_HCACHE */
@@ -1828,7 +1880,7 @@ int imap_msg_open(struct Context *ctx, struct Message *msg, int msgno)
 
   /* This function is called in a few places after endwin()
    * e.g. mutt_pipe_message(). */
-  output_progress = !isendwin();
+  output_progress = !isendwin() && !ctx->mailbox->quiet;
   if (output_progress)
     mutt_message(_("Fetching message..."));
 
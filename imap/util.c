@@ -361,6 +361,66 @@ struct Email *imap_hcache_get(struct ImapMboxData *mdata, unsigned int uid)
   return e;
 }
 
+/**
+ * imap_hcache_get_multi - Get a batch of header cache entries by UID
+ * @param[in]  mdata  Imap Mailbox data
+ * @param[in]  uids   UIDs to find
+ * @param[in]  count  Number of UIDs
+ * @param[out] emails Restored Emails, or NULL where absent/invalid
+ * @retval num Number of entries found
+ * @retval -1  Failure
+ *
+ * Batched version of imap_hcache_get(), built on mutt_hcache_fetch_multi().
+ */
+int imap_hcache_get_multi(struct ImapMboxData *mdata, const unsigned int *uids,
+                          size_t count, struct Email **emails)
+{
+  char keybuf[IMAP_HCACHE_BATCH][16];
+  const char *keys[IMAP_HCACHE_BATCH];
+  size_t keylens[IMAP_HCACHE_BATCH];
+  void *results[IMAP_HCACHE_BATCH];
+
+  if (!mdata->hcache)
+    return -1;
+
+  int found = 0;
+  size_t done = 0;
+
+  while (done < count)
+  {
+    size_t n = count - done;
+    if (n > IMAP_HCACHE_BATCH)
+      n = IMAP_HCACHE_BATCH;
+
+    for (size_t i = 0; i < n; i++)
+    {
+      sprintf(keybuf[i], "/%u", uids[done + i]);
+      keys[i] = keybuf[i];
+      keylens[i] = imap_hcache_keylen(keybuf[i]);
+    }
+    mutt_hcache_fetch_multi(mdata->hcache, keys, keylens, n, results);
+
+    for (size_t i = 0; i < n; i++)
+    {
+      emails[done + i] = NULL;
+      void *uv = results[i];
+      if (!uv)
+        continue;
+      if (*(unsigned int *) uv == mdata->uid_validity)
+      {
+        emails[done + i] = mutt_hcache_restore(uv);
+        found++;
+      }
+      else
+        mutt_debug(3, "hcache uidvalidity mismatch: %u\n", *(unsigned int *) uv);
+      mutt_hcache_free(mdata->hcache, &uv);
+    }
+    done += n;
+  }
+
+  return found;
+}
+
 /**
  * imap_hcache_put - Add an entry to the header cache
  * @param mdata Imap Mailbox data
@@ -413,7 +473,7 @@ int imap_hcache_store_uid_seqset(struct ImapMboxData *mdata)
   mutt_buffer_increase_size(b, HUGE_STRING);
   imap_msn_index_to_uid_seqset(b, mdata);
 
-  size_t seqset_size = b->dptr - b->data;
+  size_t seqset_size = mutt_buffer_len(b);
   if (seqset_size == 0)
     b->data[0] = '\0';
 
@@ -1046,7 +1106,14 @@ void imap_keepalive(void)
       mdata = conn->data;
       if (mdata->state >= IMAP_AUTHENTICATED && now >= mdata->lastread + ImapKeepalive)
       {
-        imap_check(mdata, true);
+        /* Only the traffic matters here, not the answer: fire the NOOP and
+         * let the next real command collect the response, so the keepalive
+         * never blocks on a network round-trip.  An idling connection still
+         * takes the full check, since it must leave IDLE first. */
+        if (mdata->state == IMAP_IDLE)
+          imap_check(mdata, true);
+        else
+          imap_exec(mdata, "NOOP", IMAP_CMD_ASYNC);
       }
     }
   }
@@ -902,11 +902,7 @@ static int parse_alias(struct Buffer *buf, struct Buffer *s, unsigned long data,
     return -1;
 
   /* check to see if an alias with this name already exists */
-  TAILQ_FOREACH(tmp, &Aliases, entries)
-  {
-    if (mutt_str_strcasecmp(tmp->name, buf->data) == 0)
-      break;
-  }
+  tmp = mutt_hash_find(AliasHash, buf->data);
 
   if (!tmp)
   {
@@ -914,6 +910,7 @@ static int parse_alias(struct Buffer *buf, struct Buffer *s, unsigned long data,
     tmp = mutt_mem_calloc(1, sizeof(struct Alias));
     tmp->name = mutt_str_strdup(buf->data);
     TAILQ_INSERT_TAIL(&Aliases, tmp, entries);
+    mutt_hash_insert(AliasHash, tmp->name, tmp);
     /* give the main addressbook code a chance */
     if (CurrentMenu == MENU_ALIAS)
       OptMenuCaller = true;
@@ -1229,14 +1226,7 @@ static int parse_ifdef(struct Buffer *buf, struct Buffer *s, unsigned long data,
   /* or a command? */
   if (!res)
   {
-    for (int i = 0; Commands[i].name; i++)
-    {
-      if (mutt_str_strcmp(buf->data, Commands[i].name) == 0)
-      {
-        res = true;
-        break;
-      }
-    }
+    res = (mutt_command_get(buf->data) != NULL);
   }
 
   /* or a my_ var? */
@@ -2152,21 +2142,18 @@ static int parse_unalias(struct Buffer *buf, struct Buffer *s,
     }
     else
     {
-      TAILQ_FOREACH(a, &Aliases, entries)
+      a = mutt_hash_find(AliasHash, buf->data);
+      if (a)
       {
-        if (mutt_str_strcasecmp(buf->data, a->name) == 0)
+        if (CurrentMenu == MENU_ALIAS)
         {
-          if (CurrentMenu == MENU_ALIAS)
-          {
-            a->del = true;
-            mutt_menu_set_current_redraw_full();
-          }
-          else
-          {
-            TAILQ_REMOVE(&Aliases, a, entries);
-            mutt_alias_free(&a);
-          }
-          break;
+          a->del = true;
+          mutt_menu_set_current_redraw_full();
+        }
+        else
+        {
+          TAILQ_REMOVE(&Aliases, a, entries);
+          mutt_alias_free(&a);
         }
       }
     }
@@ -2428,21 +2415,36 @@ static int parse_unsubscribe_from(struct Buffer *buf, struct Buffer *s,
 }
 #endif
 
-#ifdef USE_LUA
 /**
  * mutt_command_get - Get a Command by its name
  * @param s Command string to lookup
  * @retval ptr  Success, Command
  * @retval NULL Error, no such command
+ *
+ * Commands[] is kept in strcmp() order, so the lookup is a binary search.
  */
 const struct Command *mutt_command_get(const char *s)
 {
-  for (int i = 0; Commands[i].name; i++)
-    if (mutt_str_strcmp(s, Commands[i].name) == 0)
-      return &Commands[i];
+  static size_t num_commands = 0;
+
+  if (num_commands == 0)
+    while (Commands[num_commands].name)
+      num_commands++;
+
+  size_t lo = 0, hi = num_commands;
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    const int cmp = mutt_str_strcmp(s, Commands[mid].name);
+    if (cmp == 0)
+      return &Commands[mid];
+    if (cmp > 0)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
   return NULL;
 }
-#endif
 
 #ifdef USE_LUA
 /**
@@ -2786,6 +2788,7 @@ void mutt_free_opts(void)
   mutt_regexlist_free(&UnMailLists);
   mutt_regexlist_free(&UnSubscribedLists);
 
+  mutt_hash_destroy(&AliasHash);
   mutt_hash_destroy(&Groups);
   mutt_hash_destroy(&ReverseAliases);
   mutt_hash_destroy(&TagFormats);
@@ -2864,6 +2867,8 @@ int mutt_init(bool skip_sys_rc, struct ListHead *commands)
   err.dptr = err.data;
 
   Groups = mutt_hash_create(1031, 0);
+  /* keys are the alias names themselves, which the Aliases entries own */
+  AliasHash = mutt_hash_create(1031, MUTT_HASH_STRCASECMP);
   /* reverse alias keys need to be strdup'ed because of idna conversions */
   ReverseAliases = mutt_hash_create(
       1031, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS | MUTT_HASH_ALLOW_DUPS);
@@ -3114,7 +3119,7 @@ int mutt_init(bool skip_sys_rc, struct ListHead *commands)
  */
 int mutt_parse_rc_line(/* const */ char *line, struct Buffer *token, struct Buffer *err)
 {
-  int i, r = 0;
+  int r = 0;
   struct Buffer expn;
 
   if (!line || !*line)
@@ -3125,6 +3130,10 @@ int mutt_parse_rc_line(/* const */ char *line, struct Buffer *token, struct Buff
   expn.dptr = line;
   expn.dsize = mutt_str_strlen(line);
 
+  /* any command may change how messages are rendered; caches keyed on
+   * ConfigRevision treat their contents as stale from here on */
+  ConfigRevision++;
+
   *err->data = 0;
 
   SKIPWS(expn.dptr);
@@ -3138,19 +3147,17 @@ int mutt_parse_rc_line(/* const */ char *line, struct Buffer *token, struct Buff
       continue;
     }
     mutt_extract_token(token, &expn, 0);
-    for (i = 0; Commands[i].name; i++)
+    const struct Command *cmd = mutt_command_get(token->data);
+    if (cmd)
     {
-      if (mutt_str_strcmp(token->data, Commands[i].name) == 0)
-      {
-        r = Commands[i].func(token, &expn, Commands[i].data, err);
-        if (r != 0)
-        {              /* -1 Error, +1 Finish */
-          goto finish; /* Propagate return code */
-        }
-        break; /* Continue with next command */
+      r = cmd->func(token, &expn, cmd->data, err);
+      if (r != 0)
+      {              /* -1 Error, +1 Finish */
+        goto finish; /* Propagate return code */
       }
+      /* Continue with next command */
     }
-    if (!Commands[i].name)
+    else
     {
       mutt_buffer_printf(err, _("%s: unknown command"), NONULL(token->data));
       r = -1;
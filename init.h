@@ -703,6 +703,15 @@ struct ConfigDef MuttVars[] = {
   ** (see http://www.g10code.de/docs/pka-intro.de.pdf) during signature
   ** verification (only supported by the GPGME backend).
   */
+  { "crypt_verify_cache_ttl", DT_NUMBER, R_NONE, &CryptVerifyCacheTtl, 300 },
+  /*
+  ** .pp
+  ** How long, in seconds, a signature verification result may be replayed
+  ** from memory when the same signed message is redisplayed, instead of
+  ** invoking the crypto backend again.  After the interval expires, or if
+  ** this is set to 0, every display verifies the signature afresh.
+  ** (Supported by the GPGME and classic S/MIME backends)
+  */
   { "crypt_verify_sig", DT_QUAD, R_NONE, &CryptVerifySig, MUTT_YES },
   /*
   ** .pp
@@ -1217,7 +1226,7 @@ struct ConfigDef MuttVars[] = {
   ** .pp
   ** This variable specifies the header cache backend.
   */
-#if defined(HAVE_QDBM) || defined(HAVE_TC) || defined(HAVE_KC)
+#if defined(HAVE_QDBM) || defined(HAVE_TC) || defined(HAVE_KC) || defined(USE_ZLIB)
   { "header_cache_compress", DT_BOOL, R_NONE, &HeaderCacheCompress, true },
   /*
   ** .pp
@@ -1228,6 +1237,10 @@ struct ConfigDef MuttVars[] = {
   ** decompression can result in a slower opening of cached folder(s)
   ** which in general is still much faster than opening non header
   ** cached folders.
+  ** .pp
+  ** With other backends, when NeoMutt is compiled with zlib, this
+  ** option determines whether each cached header is deflated before
+  ** it is written to the database.
   */
 #endif /* HAVE_QDBM */
 #if defined(HAVE_GDBM) || defined(HAVE_BDB)
@@ -1433,6 +1446,17 @@ struct ConfigDef MuttVars[] = {
   ** those, and displays worse performance when enabled.  Your
   ** mileage may vary.
   */
+#ifdef USE_ZLIB
+  { "imap_deflate",             DT_BOOL, R_NONE, &ImapDeflate, false },
+  /*
+  ** .pp
+  ** When \fIset\fP, mutt will use the COMPRESS=DEFLATE extension (RFC 4978)
+  ** if advertised by the server.
+  ** .pp
+  ** In general a good compression efficiency can be achieved, which
+  ** speeds up reading large mailboxes also on fairly good connections.
+  */
+#endif
   { "imap_delim_chars",         DT_STRING, R_NONE, &ImapDelimChars, IP "/." },
   /*
   ** .pp
@@ -2217,6 +2241,15 @@ struct ConfigDef MuttVars[] = {
   ** number, oldest articles will be ignored.  Also controls how many
   ** articles headers will be saved in cache when you quit newsgroup.
   */
+#ifdef USE_ZLIB
+  { "nntp_deflate",     DT_BOOL, R_NONE, &NntpDeflate, false },
+  /*
+  ** .pp
+  ** When \fIset\fP, mutt will use the COMPRESS DEFLATE extension (RFC 8054)
+  ** if advertised by the server.  This compresses the whole connection,
+  ** including overview feeds fetched when entering large newsgroups.
+  */
+#endif
   { "nntp_listgroup",   DT_BOOL, R_NONE, &NntpListgroup, true },
   /*
   ** .pp
@@ -2946,6 +2979,14 @@ struct ConfigDef MuttVars[] = {
   ** than returning to the index menu.  If \fIunset\fP, NeoMutt will return to the
   ** index menu when the external pager exits.
   */
+  { "query_cache_ttl", DT_NUMBER, R_NONE, &QueryCacheTtl, 300 },
+  /*
+  ** .pp
+  ** How long (in seconds) the results of a $$query_command run are
+  ** remembered.  Within that time, repeating a query serves the cached
+  ** results instantly instead of running the (potentially slow) external
+  ** command again.  Set to 0 to disable caching.
+  */
   { "query_command", DT_COMMAND, R_NONE, &QueryCommand, 0 },
   /*
   ** .pp
@@ -4633,6 +4674,8 @@ static int parse_unsubscribe_from(struct Buffer *buf, struct Buffer *s, unsigned
 static int parse_group_context   (struct GroupContext **ctx,
                                   struct Buffer *buf, struct Buffer *s, unsigned long data, struct Buffer *err);
 
+/* This table must be kept sorted by name (strcmp order):
+ * mutt_command_get() relies on it for binary search. */
 const struct Command Commands[] = {
 #ifdef USE_SOCKET
   { "account-hook",        mutt_parse_hook,        MUTT_ACCOUNT_HOOK },
@@ -139,6 +139,13 @@ int LastKey; /**< contains the last key the user pressed */
 
 struct Keymap *Keymaps[MENU_MAX];
 
+/* Per-menu array of the Keymap entries in list (i.e. sorted) order, so
+ * km_dokey() can binary search the first key of a sequence instead of
+ * scanning the whole list.  Rebuilt lazily after any binding change. */
+static struct Keymap **KeymapIndex[MENU_MAX];
+static size_t KeymapIndexLen[MENU_MAX];
+static bool KeymapIndexStale[MENU_MAX];
+
 /**
  * alloc_keys - Allocate space for a sequence of keys
  * @param len  Number of keys
@@ -370,6 +377,7 @@ static int km_bind_err(const char *s, int menu, int op, char *macro, char *desc,
   {
     Keymaps[menu] = map;
   }
+  KeymapIndexStale[menu] = true;
 
   return retval;
 }
@@ -555,6 +563,47 @@ static int retry_generic(int menu, keycode_t *keys, int keyslen, int lastkey)
   return OP_NULL;
 }
 
+/**
+ * km_index_find - Find the first binding whose sequence starts at/after a key
+ * @param menu Menu ID, e.g. #MENU_EDITOR
+ * @param key  First key of the sequence being resolved
+ * @retval ptr  First Keymap with keys[0] >= key
+ * @retval NULL All bindings have keys[0] < key
+ *
+ * The Keymaps lists are kept sorted by key sequence, so the first keystroke
+ * can be resolved by binary search over an array snapshot of the list.
+ */
+static struct Keymap *km_index_find(int menu, int key)
+{
+  if (KeymapIndexStale[menu])
+  {
+    size_t num = 0;
+    for (struct Keymap *map = Keymaps[menu]; map; map = map->next)
+      num++;
+    if (num != 0)
+    {
+      mutt_mem_realloc(&KeymapIndex[menu], num * sizeof(struct Keymap *));
+      size_t i = 0;
+      for (struct Keymap *map = Keymaps[menu]; map; map = map->next)
+        KeymapIndex[menu][i++] = map;
+    }
+    KeymapIndexLen[menu] = num;
+    KeymapIndexStale[menu] = false;
+  }
+
+  struct Keymap **index = KeymapIndex[menu];
+  size_t lo = 0, hi = KeymapIndexLen[menu];
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (index[mid]->keys[0] < key)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return (lo < KeymapIndexLen[menu]) ? index[lo] : NULL;
+}
+
 /**
  * km_dokey - Determine what a keypress should do
  * @param menu Menu ID, e.g. #MENU_EDITOR
@@ -666,15 +715,26 @@ int km_dokey(int menu)
     }
 
     /* Nope. Business as usual */
-    while (LastKey > map->keys[pos])
+    if (pos == 0)
     {
-      if (pos > map->eq || !map->next)
-        return retry_generic(menu, map->keys, pos, LastKey);
-      map = map->next;
+      /* start of a sequence: binary search the first key instead of
+       * scanning the map list */
+      map = km_index_find(menu, LastKey);
+      if (!map || (LastKey != map->keys[0]))
+        return retry_generic(menu, NULL, 0, LastKey);
     }
+    else
+    {
+      while (LastKey > map->keys[pos])
+      {
+        if (pos > map->eq || !map->next)
+          return retry_generic(menu, map->keys, pos, LastKey);
+        map = map->next;
+      }
 
-    if (LastKey != map->keys[pos])
-      return retry_generic(menu, map->keys, pos, LastKey);
+      if (LastKey != map->keys[pos])
+        return retry_generic(menu, map->keys, pos, LastKey);
+    }
 
     if (++pos == map->len)
     {
@@ -1464,5 +1524,8 @@ void mutt_free_keys(void)
     }
 
     Keymaps[i] = NULL;
+    FREE(&KeymapIndex[i]);
+    KeymapIndexLen[i] = 0;
+    KeymapIndexStale[i] = true;
   }
 }
@@ -29,6 +29,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <utime.h>
 #include "mutt/mutt.h"
 #include "config/lib.h"
@@ -49,6 +50,9 @@
 #ifdef USE_IMAP
 #include "imap/imap.h"
 #endif
+#ifdef USE_HCACHE
+#include "hcache/hcache.h"
+#endif
 #ifdef USE_NOTMUCH
 #include "notmuch/mutt_notmuch.h"
 #endif
@@ -70,6 +74,11 @@ bool MaildirCheckCur; ///< Config: Check both 'new' and 'cur' directories for ne
 
 static time_t MailboxTime = 0; /**< last time we started checking for mail */
 static time_t MailboxStatsTime = 0; /**< last time we check performed mail_check_stats */
+
+/* A mailbox whose poll takes longer than this (e.g. on a stalled NFS mount)
+ * is backed off, so one slow mailbox doesn't stall every check */
+#define MAILBOX_SLOW_MS 1000
+#define MAILBOX_BACKOFF_SECS 60
 static short MailboxCount = 0;  /**< how many boxes with new mail */
 static short MailboxNotify = 0; /**< # of unnotified new boxes */
 
@@ -314,9 +323,34 @@ static int mailbox_maildir_check(struct Mailbox *mailbox, bool check_stats)
 
   if (check_stats)
   {
-    mailbox->msg_count = 0;
-    mailbox->msg_unread = 0;
-    mailbox->msg_flagged = 0;
+    char path[PATH_MAX];
+    struct stat st_new;
+    struct stat st_cur;
+
+    /* the counts can only change when one of the subdirectories does; if
+     * neither has been modified since the last count, keep the old values
+     * instead of re-walking both directories */
+    snprintf(path, sizeof(path), "%s/new", mailbox->path);
+    const bool have_new = (stat(path, &st_new) == 0);
+    snprintf(path, sizeof(path), "%s/cur", mailbox->path);
+    const bool have_cur = (stat(path, &st_cur) == 0);
+
+    if (have_new && have_cur &&
+        (mutt_stat_timespec_compare(&st_new, MUTT_STAT_MTIME, &mailbox->stats_mtime_new) <= 0) &&
+        (mutt_stat_timespec_compare(&st_cur, MUTT_STAT_MTIME, &mailbox->stats_mtime_cur) <= 0))
+    {
+      check_stats = false;
+    }
+    else
+    {
+      mailbox->msg_count = 0;
+      mailbox->msg_unread = 0;
+      mailbox->msg_flagged = 0;
+      if (have_new)
+        mutt_get_stat_timespec(&mailbox->stats_mtime_new, &st_new, MUTT_STAT_MTIME);
+      if (have_cur)
+        mutt_get_stat_timespec(&mailbox->stats_mtime_cur, &st_cur, MUTT_STAT_MTIME);
+    }
   }
 
   rc = mailbox_maildir_check_dir(mailbox, "new", check_new, check_stats);
@@ -341,6 +375,20 @@ static int mailbox_mbox_check(struct Mailbox *mailbox, struct stat *sb, bool che
   int rc = 0;
   bool new_or_changed;
 
+  /* If nothing has touched the file since the last check and the user hasn't
+   * visited the mailbox in between, the previous verdict still holds.  This
+   * also sidesteps the atime heuristic below, which goes stale on relatime
+   * mounts where reading the mbox doesn't reliably update atime. */
+  if (!mailbox->newly_created && (mailbox->check_time != 0) &&
+      (mailbox->check_time > mailbox->last_visited.tv_sec) &&
+      (mutt_stat_timespec_compare(sb, MUTT_STAT_MTIME, &mailbox->check_mtime) == 0) &&
+      (sb->st_size == mailbox->check_size))
+  {
+    mailbox->has_new = mailbox->check_has_new;
+    rc = mailbox->check_has_new ? 1 : 0;
+    goto stats;
+  }
+
   if (CheckMboxSize)
     new_or_changed = (sb->st_size > mailbox->size);
   else
@@ -370,6 +418,13 @@ static int mailbox_mbox_check(struct Mailbox *mailbox, struct stat *sb, bool che
   if (mailbox->newly_created && (sb->st_ctime != sb->st_mtime || sb->st_ctime != sb->st_atime))
     mailbox->newly_created = false;
 
+  /* remember what this check saw and decided, for the next cycle */
+  mutt_get_stat_timespec(&mailbox->check_mtime, sb, MUTT_STAT_MTIME);
+  mailbox->check_size = sb->st_size;
+  mailbox->check_time = time(NULL);
+  mailbox->check_has_new = mailbox->has_new;
+
+stats:
   if (check_stats &&
       (mutt_stat_timespec_compare(sb, MUTT_STAT_MTIME, &mailbox->stats_last_checked) > 0))
   {
@@ -873,7 +928,23 @@ int mutt_mailbox_check(int force)
   struct MailboxNode *np = NULL;
   STAILQ_FOREACH(np, &AllMailboxes, entries)
   {
+    if (!force && (np->m->backoff_until > t))
+    {
+      /* this mailbox answered slowly last time; leave its counts alone
+       * until the backoff expires */
+      if (np->m->has_new)
+        MailboxCount++;
+      continue;
+    }
+
+    struct timeval pre_t, post_t;
+    gettimeofday(&pre_t, NULL);
     mailbox_check(np->m, &contex_sb, check_stats);
+    gettimeofday(&post_t, NULL);
+
+    const long elapsed_ms = (post_t.tv_sec - pre_t.tv_sec) * 1000 +
+                            (post_t.tv_usec - pre_t.tv_usec) / 1000;
+    np->m->backoff_until = (elapsed_ms >= MAILBOX_SLOW_MS) ? (t + MAILBOX_BACKOFF_SECS) : 0;
   }
 
   return MailboxCount;
@@ -940,6 +1011,42 @@ bool mutt_mailbox_list(void)
   return false;
 }
 
+/**
+ * mutt_mailbox_stats - Write per-mailbox statistics to a file
+ * @param fp File to write to
+ *
+ * One line per known mailbox: the message counts, the mailbox size, and the
+ * cost of the last open - time spent parsing and sorting, plus the network
+ * round trips made since then for IMAP mailboxes.
+ */
+void mutt_mailbox_stats(FILE *fp)
+{
+  char path[PATH_MAX];
+
+  fprintf(fp, "%-40s %8s %8s %8s %12s %9s %8s %5s\n", _("Mailbox"), _("msgs"),
+          _("unread"), _("flagged"), _("bytes"), _("parse-ms"), _("sort-ms"), _("rtt"));
+
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &AllMailboxes, entries)
+  {
+    mutt_str_strfcpy(path, np->m->path, sizeof(path));
+    mutt_pretty_mailbox(path, sizeof(path));
+    fprintf(fp, "%-40s %8d %8d %8d %12lld %9lu %8lu %5d\n", path,
+            np->m->msg_count, np->m->msg_unread, np->m->msg_flagged,
+            (long long) np->m->size, np->m->open_parse_ms, np->m->open_sort_ms,
+            np->m->open_rtt);
+  }
+
+#ifdef USE_HCACHE
+  if ((HcacheHits + HcacheMisses) > 0)
+  {
+    fprintf(fp, "\n");
+    fprintf(fp, _("Header cache: %d hits, %d misses (%d%% hit rate)\n"), HcacheHits,
+            HcacheMisses, (100 * HcacheHits) / (HcacheHits + HcacheMisses));
+  }
+#endif
+}
+
 /**
  * mutt_mailbox_setnotified - Note when the user was last notified of new mail
  * @param path Path to the mailbox
@@ -25,6 +25,7 @@
 
 #include <limits.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <sys/types.h>
 #include <time.h>
 #include "mutt/mutt.h"
@@ -97,6 +98,16 @@ struct Mailbox
   struct timespec mtime;
   struct timespec last_visited;       /**< time of last exit from this mailbox */
   struct timespec stats_last_checked; /**< mtime of mailbox the last time stats where checked. */
+  struct timespec stats_mtime_new; /**< mtime of "new" when maildir stats were last counted */
+  struct timespec stats_mtime_cur; /**< mtime of "cur" when maildir stats were last counted */
+  time_t backoff_until; /**< skip polling this slow mailbox until this time */
+  struct timespec check_mtime; /**< mbox mtime at the last new-mail check */
+  off_t check_size;     /**< mbox size at the last new-mail check */
+  time_t check_time;    /**< when the last new-mail check ran */
+  bool check_has_new;   /**< verdict of the last new-mail check */
+  unsigned long open_parse_ms; /**< time the last open spent reading and parsing */
+  unsigned long open_sort_ms;  /**< time the last open spent sorting and threading */
+  int open_rtt;         /**< network round trips since the last open (IMAP) */
 
   void *data;                 /**< driver specific data */
   void (*free_data)(void **); /**< driver-specific data free function */
@@ -155,6 +166,7 @@ void mutt_mailbox_setnotified(const char *path);
 
 void mutt_mailbox(char *s, size_t slen);
 bool mutt_mailbox_list(void);
+void mutt_mailbox_stats(FILE *fp);
 int mutt_mailbox_check(int force);
 bool mutt_mailbox_notify(void);
 int mutt_parse_mailboxes(struct Buffer *path, struct Buffer *s, unsigned long data, struct Buffer *err);
@@ -56,6 +56,7 @@ extern struct MxOps mx_maildir_ops;
 extern struct MxOps mx_mh_ops;
 
 int            maildir_check_empty(const char *path);
+int            maildir_fast_trash(struct Mailbox *mailbox, const char *dest);
 void           maildir_gen_flags(char *dest, size_t destlen, struct Email *e);
 FILE *         maildir_open_find_message(const char *folder, const char *msg, char **newname);
 void           maildir_parse_flags(struct Email *e, const char *path);
@@ -78,6 +78,11 @@ char *MhSeqUnseen;  ///< Config: MH sequence for unseen messages
 
 #define INS_SORT_THRESHOLD 6
 
+#ifdef USE_HCACHE
+/* Number of keys fetched per mutt_hcache_fetch_multi() call */
+#define MH_HCACHE_BATCH 128
+#endif
+
 #define MH_SEQ_UNSEEN (1 << 0)
 #define MH_SEQ_REPLIED (1 << 1)
 #define MH_SEQ_FLAGGED (1 << 2)
@@ -662,37 +667,62 @@ static void mh_update_maildir(struct Maildir *md, struct MhSequences *mhs)
 }
 
 /**
- * maildir_free_entry - Free a Maildir object
- * @param md Maildir to free
+ * struct MaildirBlock - Slab of Maildir list entries
+ *
+ * Scan entries are only ever freed all at once (the whole scan list), so
+ * they're carved out of large blocks instead of being calloc'd one by one.
  */
-static void maildir_free_entry(struct Maildir **md)
+struct MaildirBlock
 {
-  if (!md || !*md)
-    return;
+  struct Maildir entries[256];
+  size_t used;
+  struct MaildirBlock *next;
+};
 
-  FREE(&(*md)->canon_fname);
-  if ((*md)->email)
-    mutt_email_free(&(*md)->email);
+/**
+ * maildir_new_entry - Allocate a Maildir list entry from a slab
+ * @param blocks Head of the slab list, updated as blocks fill up
+ * @retval ptr New zeroed entry
+ */
+static struct Maildir *maildir_new_entry(struct MaildirBlock **blocks)
+{
+  struct MaildirBlock *b = *blocks;
+
+  if (!b || (b->used == mutt_array_size(b->entries)))
+  {
+    b = mutt_mem_calloc(1, sizeof(struct MaildirBlock));
+    b->next = *blocks;
+    *blocks = b;
+  }
 
-  FREE(md);
+  return &b->entries[b->used++];
 }
 
 /**
  * maildir_free_maildir - Free a Maildir list
- * @param md Maildir list to free
+ * @param md     Maildir list to free
+ * @param blocks Slabs the entries were allocated from
  */
-static void maildir_free_maildir(struct Maildir **md)
+static void maildir_free_maildir(struct Maildir **md, struct MaildirBlock **blocks)
 {
-  if (!md || !*md)
-    return;
-
-  struct Maildir *p = NULL, *q = NULL;
+  if (md)
+  {
+    for (struct Maildir *p = *md; p; p = p->next)
+    {
+      FREE(&p->canon_fname);
+      if (p->email)
+        mutt_email_free(&p->email);
+    }
+    *md = NULL;
+  }
 
-  for (p = *md; p; p = q)
+  struct MaildirBlock *q = NULL;
+  for (struct MaildirBlock *b = *blocks; b; b = q)
   {
-    q = p->next;
-    maildir_free_entry(&p);
+    q = b->next;
+    FREE(&b);
   }
+  *blocks = NULL;
 }
 
 /**
@@ -729,6 +759,7 @@ static void maildir_update_mtime(struct Mailbox *mailbox)
  * maildir_parse_dir - Read a Maildir mailbox
  * @param mailbox  Mailbox
  * @param last     Last Maildir
+ * @param blocks   Slabs to allocate list entries from
  * @param subdir   Subdirectory, e.g. 'new'
  * @param count    Counter for the progress bar
  * @param progress Progress bar
@@ -737,10 +768,13 @@ static void maildir_update_mtime(struct Mailbox *mailbox)
  * @retval -2 Aborted
  */
 static int maildir_parse_dir(struct Mailbox *mailbox, struct Maildir ***last,
-                             const char *subdir, int *count, struct Progress *progress)
+                             struct MaildirBlock **blocks, const char *subdir,
+                             int *count, struct Progress *progress)
 {
   struct dirent *de = NULL;
   char buf[PATH_MAX];
+  char prefix[STRING] = "";
+  size_t prefix_len = 0;
   int is_old = 0;
   struct Maildir *entry = NULL;
   struct Email *e = NULL;
@@ -748,6 +782,7 @@ static int maildir_parse_dir(struct Mailbox *mailbox, struct Maildir ***last,
   if (subdir)
   {
     snprintf(buf, sizeof(buf), "%s/%s", mailbox->path, subdir);
+    prefix_len = snprintf(prefix, sizeof(prefix), "%s/", subdir);
     is_old = MarkOld ? (mutt_str_strcmp("cur", subdir) == 0) : false;
   }
   else
@@ -765,6 +800,14 @@ static int maildir_parse_dir(struct Mailbox *mailbox, struct Maildir ***last,
       continue;
     }
 
+#ifdef _DIRENT_HAVE_D_TYPE
+    /* skip subdirectories and other non-files without paying for a stat;
+     * DT_UNKNOWN (and symlinks) still go through - the open in the parsing
+     * pass sorts those out */
+    if ((de->d_type != DT_REG) && (de->d_type != DT_LNK) && (de->d_type != DT_UNKNOWN))
+      continue;
+#endif
+
     /* FOO - really ignore the return value? */
     mutt_debug(2, "queueing %s\n", de->d_name);
 
@@ -780,16 +823,15 @@ static int maildir_parse_dir(struct Mailbox *mailbox, struct Maildir ***last,
         mutt_progress_update(progress, *count, -1);
     }
 
-    if (subdir)
-    {
-      char tmp[LONG_STRING];
-      snprintf(tmp, sizeof(tmp), "%s/%s", subdir, de->d_name);
-      e->path = mutt_str_strdup(tmp);
-    }
-    else
-      e->path = mutt_str_strdup(de->d_name);
+    /* Assemble the path in one allocation instead of formatting into a
+     * temporary buffer and copying it out again */
+    const size_t name_len = strlen(de->d_name);
+    e->path = mutt_mem_malloc(prefix_len + name_len + 1);
+    if (prefix_len != 0)
+      memcpy(e->path, prefix, prefix_len);
+    memcpy(e->path + prefix_len, de->d_name, name_len + 1);
 
-    entry = mutt_mem_calloc(1, sizeof(struct Maildir));
+    entry = maildir_new_entry(blocks);
     entry->email = e;
     entry->inode = de->d_ino;
     **last = entry;
@@ -856,15 +898,17 @@ static bool maildir_add_to_context(struct Context *ctx, struct Maildir *md)
 
 /**
  * maildir_move_to_context - Copy the Maildir list to the Mailbox
- * @param ctx Mailbox
- * @param md  Maildir list to copy, then free
+ * @param ctx    Mailbox
+ * @param md     Maildir list to copy, then free
+ * @param blocks Slabs the list entries were allocated from
  * @retval 1 If there's new mail
  * @retval 0 Otherwise
  */
-static int maildir_move_to_context(struct Context *ctx, struct Maildir **md)
+static int maildir_move_to_context(struct Context *ctx, struct Maildir **md,
+                                   struct MaildirBlock **blocks)
 {
   int r = maildir_add_to_context(ctx, *md);
-  maildir_free_maildir(md);
+  maildir_free_maildir(md, blocks);
   return r;
 }
 
@@ -1085,12 +1129,105 @@ static struct Maildir *skip_duplicates(struct Maildir *p, struct Maildir **last)
   return p;
 }
 
+/**
+ * maildir_readahead - Hint the kernel to prefetch a message file
+ * @param mailbox Mailbox the message belongs to
+ * @param path    Message path, relative to the mailbox
+ *
+ * Used by maildir_delayed_parsing() to overlap disk reads with parsing:
+ * files we know we are about to parse are advised ahead of time so the
+ * kernel can fetch them while we are busy with the current message.
+ */
+static void maildir_readahead(struct Mailbox *mailbox, const char *path)
+{
+#ifdef POSIX_FADV_WILLNEED
+  char fn[PATH_MAX];
+
+  snprintf(fn, sizeof(fn), "%s/%s", mailbox->path, path);
+  const int fd = open(fn, O_RDONLY | O_NONBLOCK);
+  if (fd >= 0)
+  {
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    close(fd);
+  }
+#endif
+}
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
  * @param mailbox  Mailbox
  * @param md       Maildir to parse
  * @param progress Progress bar
  */
+/**
+ * maildir_parse_message_at - Parse a message opened relative to the mailbox
+ * @param dirfd   Descriptor of the mailbox directory
+ * @param magic   Mailbox type, e.g. #MUTT_MAILDIR
+ * @param relpath Message path relative to the mailbox
+ * @param fname   Full message path, for the flags parser
+ * @param is_old  true, if the email is old (read)
+ * @param e       Email
+ * @retval ptr Populated email, or NULL on error
+ *
+ * openat() spares the kernel re-walking the mailbox path for every one of
+ * the thousands of opens a big folder scan performs.
+ */
+static struct Email *maildir_parse_message_at(int dirfd, enum MailboxType magic,
+                                              const char *relpath, const char *fname,
+                                              bool is_old, struct Email *e)
+{
+  int fd = openat(dirfd, relpath, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+
+  FILE *f = fdopen(fd, "r");
+  if (!f)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  e = maildir_parse_stream(magic, f, fname, is_old, e);
+  mutt_file_fclose(&f);
+  return e;
+}
+
+#ifdef USE_HCACHE
+/**
+ * mh_flush_pending_stores - Store parsed headers queued during a fetch window
+ * @param[in]     hc      Header cache handle
+ * @param[in]     magic   Mailbox type, e.g. #MUTT_MAILDIR
+ * @param[in]     pending Entries whose headers were parsed from disk
+ * @param[in,out] len     Number of pending entries, reset to 0
+ *
+ * Stores are deferred until every blob fetched in the window has been
+ * consumed: some backends (LMDB) hand out pointers into a read transaction
+ * that the first write invalidates.
+ */
+static void mh_flush_pending_stores(header_cache_t *hc, enum MailboxType magic,
+                                    struct Maildir **pending, size_t *len)
+{
+  const char *key = NULL;
+  size_t keylen;
+
+  for (size_t i = 0; i < *len; i++)
+  {
+    if (magic == MUTT_MH)
+    {
+      key = pending[i]->email->path;
+      keylen = strlen(key);
+    }
+    else
+    {
+      key = pending[i]->email->path + 3;
+      keylen = maildir_hcache_keylen(key);
+    }
+    mutt_hcache_store(hc, key, keylen, pending[i]->email, 0);
+  }
+  *len = 0;
+}
+#endif
+
 static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md,
                                     struct Progress *progress)
 {
@@ -1099,14 +1236,31 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
   int count;
   bool sort = false;
 #ifdef USE_HCACHE
-  const char *key = NULL;
-  size_t keylen;
   struct stat lastchanged;
   int ret;
+
+  /* Prefetch window for mutt_hcache_fetch_multi(), filled by walking ahead of
+   * the entry being parsed */
+  const char *keys[MH_HCACHE_BATCH];
+  size_t keylens[MH_HCACHE_BATCH];
+  void *batch[MH_HCACHE_BATCH];
+  struct Maildir *batch_md[MH_HCACHE_BATCH];
+  /* cache-verify stat results for the window, gathered at refill time */
+  struct stat batch_st[MH_HCACHE_BATCH];
+  int batch_st_rc[MH_HCACHE_BATCH];
+  size_t batch_pos = 0, batch_len = 0;
+  struct Maildir *batch_next = NULL;
+  /* misses parsed from disk, stored once the window's blobs are consumed */
+  struct Maildir *pending[MH_HCACHE_BATCH];
+  size_t pending_len = 0;
 #endif
 
+  /* resolve the mailbox path once; all message access is relative to it */
+  int dirfd = open(mailbox->path, O_RDONLY | O_DIRECTORY);
+
 #ifdef USE_HCACHE
   header_cache_t *hc = mutt_hcache_open(HeaderCache, mailbox->path, NULL);
+  mutt_hcache_store_begin(hc);
 #endif
 
   for (p = *md, count = 0; p; p = p->next, count++)
@@ -1135,10 +1289,69 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
 
     snprintf(fn, sizeof(fn), "%s/%s", mailbox->path, p->email->path);
 
+#ifndef USE_HCACHE
+    /* no header cache: every file will be read, so prime the next one */
+    if (p->next && p->next->email && !p->next->header_parsed)
+      maildir_readahead(mailbox, p->next->email->path);
+#endif
+
 #ifdef USE_HCACHE
+    /* Refill the prefetch window: collect the keys of the next batch of
+     * unparsed entries and fetch them with a single hcache call */
+    if (batch_pos == batch_len)
+    {
+      mh_flush_pending_stores(hc, mailbox->magic, pending, &pending_len);
+      batch_pos = 0;
+      batch_len = 0;
+      if (!batch_next)
+        batch_next = p;
+      for (; batch_next && (batch_len < MH_HCACHE_BATCH); batch_next = batch_next->next)
+      {
+        if (!batch_next->email || batch_next->header_parsed)
+          continue;
+        if (mailbox->magic == MUTT_MH)
+        {
+          keys[batch_len] = batch_next->email->path;
+          keylens[batch_len] = strlen(keys[batch_len]);
+        }
+        else
+        {
+          keys[batch_len] = batch_next->email->path + 3;
+          keylens[batch_len] = maildir_hcache_keylen(keys[batch_len]);
+        }
+        if (MaildirHeaderCacheVerify)
+        {
+          /* verify the whole window in one burst of stats - the entries are
+           * in inode order, so this runs down the attribute/dentry caches
+           * instead of interleaving each round-trip with parsing work */
+          if (dirfd >= 0)
+            batch_st_rc[batch_len] =
+                fstatat(dirfd, batch_next->email->path, &batch_st[batch_len], 0);
+          else
+          {
+            char sfn[PATH_MAX];
+            snprintf(sfn, sizeof(sfn), "%s/%s", mailbox->path, batch_next->email->path);
+            batch_st_rc[batch_len] = stat(sfn, &batch_st[batch_len]);
+          }
+        }
+        batch_md[batch_len] = batch_next;
+        batch_len++;
+      }
+      mutt_hcache_fetch_multi(hc, keys, keylens, batch_len, batch);
+
+      /* every miss in this window will hit the disk; start those reads now,
+       * while we restore/parse the rest of the window */
+      for (size_t i = 0; i < batch_len; i++)
+      {
+        if (!batch[i])
+          maildir_readahead(mailbox, batch_md[i]->email->path);
+      }
+    }
+
     if (MaildirHeaderCacheVerify)
     {
-      ret = stat(fn, &lastchanged);
+      ret = batch_st_rc[batch_pos];
+      lastchanged = batch_st[batch_pos];
     }
     else
     {
@@ -1146,17 +1359,7 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
       ret = 0;
     }
 
-    if (mailbox->magic == MUTT_MH)
-    {
-      key = p->email->path;
-      keylen = strlen(key);
-    }
-    else
-    {
-      key = p->email->path + 3;
-      keylen = maildir_hcache_keylen(key);
-    }
-    void *data = mutt_hcache_fetch(hc, key, keylen);
+    void *data = batch[batch_pos++];
     struct timeval *when = data;
 
     if (data && !ret && lastchanged.st_mtime <= when->tv_sec)
@@ -1173,21 +1376,15 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
     {
 #endif
 
-      if (maildir_parse_message(mailbox->magic, fn, p->email->old, p->email))
+      struct Email *parsed =
+          (dirfd >= 0) ? maildir_parse_message_at(dirfd, mailbox->magic, p->email->path,
+                                                  fn, p->email->old, p->email) :
+                         maildir_parse_message(mailbox->magic, fn, p->email->old, p->email);
+      if (parsed)
       {
         p->header_parsed = 1;
 #ifdef USE_HCACHE
-        if (mailbox->magic == MUTT_MH)
-        {
-          key = p->email->path;
-          keylen = strlen(key);
-        }
-        else
-        {
-          key = p->email->path + 3;
-          keylen = maildir_hcache_keylen(key);
-        }
-        mutt_hcache_store(hc, key, keylen, p->email, 0);
+        pending[pending_len++] = p;
 #endif
       }
       else
@@ -1199,8 +1396,12 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
     last = p;
   }
 #ifdef USE_HCACHE
+  mh_flush_pending_stores(hc, mailbox->magic, pending, &pending_len);
+  mutt_hcache_store_commit(hc);
   mutt_hcache_close(hc);
 #endif
+  if (dirfd >= 0)
+    close(dirfd);
 
   mh_sort_natural(mailbox, md);
 }
@@ -1216,6 +1417,7 @@ static void maildir_delayed_parsing(struct Mailbox *mailbox, struct Maildir **md
 static int mh_read_dir(struct Context *ctx, const char *subdir)
 {
   struct Maildir *md = NULL;
+  struct MaildirBlock *blocks = NULL;
   struct MhSequences mhs = { 0 };
   struct Maildir **last = NULL;
   char msgbuf[STRING];
@@ -1238,8 +1440,11 @@ static int mh_read_dir(struct Context *ctx, const char *subdir)
   md = NULL;
   last = &md;
   int count = 0;
-  if (maildir_parse_dir(ctx->mailbox, &last, subdir, &count, &progress) < 0)
+  if (maildir_parse_dir(ctx->mailbox, &last, &blocks, subdir, &count, &progress) < 0)
+  {
+    maildir_free_maildir(&md, &blocks);
     return -1;
+  }
 
   if (!ctx->mailbox->quiet)
   {
@@ -1252,14 +1457,14 @@ static int mh_read_dir(struct Context *ctx, const char *subdir)
   {
     if (mh_read_sequences(&mhs, ctx->mailbox->path) < 0)
     {
-      maildir_free_maildir(&md);
+      maildir_free_maildir(&md, &blocks);
       return -1;
     }
     mh_update_maildir(md, &mhs);
     mhs_free_sequences(&mhs);
   }
 
-  maildir_move_to_context(ctx, &md);
+  maildir_move_to_context(ctx, &md, &blocks);
 
   if (!data->mh_umask)
     data->mh_umask = mh_umask(ctx->mailbox);
@@ -2242,6 +2447,70 @@ int maildir_check_empty(const char *path)
   return r;
 }
 
+/**
+ * maildir_fast_trash - Link deleted messages into a maildir trash folder
+ * @param mailbox Mailbox being expunged
+ * @param dest    Path of the trash maildir
+ * @retval  0 Success, all deleted messages now exist in the trash
+ * @retval -1 Failure, nothing was moved, caller should copy instead
+ *
+ * When the trash folder is a maildir on the same filesystem, the message
+ * files can be hardlinked into it instead of being read and rewritten.  The
+ * expunge that follows unlinks the originals, completing the move without
+ * copying any data.  Any failure (most likely EXDEV) rolls back the links
+ * already made so that the caller's fallback to mutt_append_message() won't
+ * leave duplicates in the trash.
+ */
+int maildir_fast_trash(struct Mailbox *mailbox, const char *dest)
+{
+  char src[PATH_MAX];
+  char target[PATH_MAX];
+  char **linked = mutt_mem_calloc(mailbox->msg_count, sizeof(char *));
+  int num_linked = 0;
+  int rc = 0;
+
+  for (int i = 0; (rc == 0) && (i < mailbox->msg_count); i++)
+  {
+    struct Email *e = mailbox->hdrs[i];
+    if (!e->deleted || e->purge)
+      continue;
+
+    snprintf(src, sizeof(src), "%s/%s", mailbox->path, e->path);
+
+    /* keep the flags suffix so read/replied state survives the move */
+    const char *suffix = strchr(e->path, ':');
+    if (!suffix)
+      suffix = "";
+
+    while (true)
+    {
+      snprintf(target, sizeof(target), "%s/%s/%lld.R%" PRIu64 ".%s%s", dest,
+               suffix[0] ? "cur" : "new", (long long) time(NULL),
+               mutt_rand64(), NONULL(ShortHostname), suffix);
+      if (link(src, target) == 0)
+      {
+        linked[num_linked++] = mutt_str_strdup(target);
+        break;
+      }
+      if (errno != EEXIST)
+      {
+        mutt_debug(1, "link %s to %s failed: %s\n", src, target, strerror(errno));
+        rc = -1;
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < num_linked; i++)
+  {
+    if (rc != 0)
+      unlink(linked[i]);
+    FREE(&linked[i]);
+  }
+  FREE(&linked);
+  return rc;
+}
+
 /**
  * mh_check_empty - Is mailbox empty
  * @param path Mailbox to check
@@ -2349,6 +2618,7 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
   int have_new = 0;           /* messages were added to the mailbox */
   bool flags_changed = false; /* message flags were changed in the mailbox */
   struct Maildir *md = NULL;  /* list of messages in the mailbox */
+  struct MaildirBlock *blocks = NULL;
   struct Maildir **last = NULL, *p = NULL;
   int count = 0;
   struct Hash *fnames = NULL; /* hash table for quickly looking up the base filename
@@ -2383,6 +2653,7 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
    * noticed during the SAME group of mtime stat updates.  To work around
    * the problem, don't update the stat times for a monitor caused check. */
 #ifdef USE_INOTIFY
+  const bool monitor_check = (MonitorContextChanged != 0);
   if (MonitorContextChanged)
     MonitorContextChanged = 0;
   else
@@ -2392,21 +2663,80 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
     mutt_get_stat_timespec(&ctx->mailbox->mtime, &st_new, MUTT_STAT_MTIME);
   }
 
+#ifdef USE_INOTIFY
+  /* If the monitor saw every change since the last check, process just the
+   * named files instead of re-walking the whole directory.  Only "new" is
+   * watched, so a change in "cur" always forces the full scan.  The list is
+   * trusted only for a monitor-triggered check: a stat-triggered one may run
+   * before events still queued on the inotify fd have been drained, and it
+   * records the mtimes above, so a file it skipped would never be seen -
+   * the monitor path leaves the mtimes alone and can't lose anything. */
+  struct ListHead monitored = STAILQ_HEAD_INITIALIZER(monitored);
+  struct Hash *removed = NULL;
+  bool delta = mutt_monitor_take_changes(&monitored) && monitor_check && (changed == 1);
+#endif
+
   /* do a fast scan of just the filenames in
    * the subdirectories that have changed.
    */
   md = NULL;
   last = &md;
-  if (changed & 1)
-    maildir_parse_dir(ctx->mailbox, &last, "new", &count, NULL);
-  if (changed & 2)
-    maildir_parse_dir(ctx->mailbox, &last, "cur", &count, NULL);
+#ifdef USE_INOTIFY
+  if (delta)
+  {
+    struct stat sb;
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, &monitored, entries)
+    {
+      if (*np->data == '.')
+        continue;
+      snprintf(buf, sizeof(buf), "%s/new/%s", ctx->mailbox->path, np->data);
+      if (stat(buf, &sb) == 0)
+      {
+        struct Email *e = mutt_email_new();
+        e->old = false;
+        maildir_parse_flags(e, np->data);
+        count++;
+
+        const size_t name_len = strlen(np->data);
+        e->path = mutt_mem_malloc(4 + name_len + 1);
+        memcpy(e->path, "new/", 4);
+        memcpy(e->path + 4, np->data, name_len + 1);
+
+        p = maildir_new_entry(&blocks);
+        p->email = e;
+        p->inode = sb.st_ino;
+        *last = p;
+        last = &p->next;
+      }
+      else
+      {
+        /* the named file is gone; remember it so the merge loop below can
+         * spot the disappearance without a directory walk */
+        if (!removed)
+          removed = mutt_hash_create(32, MUTT_HASH_STRDUP_KEYS);
+        maildir_canon_filename(np->data, buf, sizeof(buf));
+        mutt_hash_insert(removed, buf, NULL);
+      }
+    }
+  }
+  else
+#endif
+  {
+    if (changed & 1)
+      maildir_parse_dir(ctx->mailbox, &last, &blocks, "new", &count, NULL);
+    if (changed & 2)
+      maildir_parse_dir(ctx->mailbox, &last, &blocks, "cur", &count, NULL);
+  }
+#ifdef USE_INOTIFY
+  mutt_list_free(&monitored);
+#endif
 
   /* we create a hash table keyed off the canonical (sans flags) filename
    * of each message we scanned.  This is used in the loop over the
    * existing messages below to do some correlation.
    */
-  fnames = mutt_hash_create(count, 0);
+  fnames = mutt_hash_create(count, MUTT_HASH_OPEN_ADDR);
 
   for (p = md; p; p = p->next)
   {
@@ -2452,6 +2782,21 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
       /* this is a duplicate of an existing header, so remove it */
       mutt_email_free(&p->email);
     }
+#ifdef USE_INOTIFY
+    /* On a delta scan, only the files named by the monitor were inspected:
+     * a message missing from the hash is still present unless the monitor
+     * reported its file gone.  buf still holds the canonical name. */
+    else if (delta)
+    {
+      if (removed && (strncmp(ctx->mailbox->hdrs[i]->path, "new/", 4) == 0) &&
+          mutt_hash_find_elem(removed, buf))
+      {
+        occult = true;
+      }
+      else
+        ctx->mailbox->hdrs[i]->active = true;
+    }
+#endif
     /* This message was not in the list of messages we just scanned.
      * Check to see if we have enough information to know if the
      * message has disappeared out from underneath us.
@@ -2477,6 +2822,9 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
 
   /* destroy the file name hash */
   mutt_hash_destroy(&fnames);
+#ifdef USE_INOTIFY
+  mutt_hash_destroy(&removed);
+#endif
 
   /* If we didn't just get new mail, update the tables. */
   if (occult)
@@ -2486,7 +2834,7 @@ static int maildir_mbox_check(struct Context *ctx, int *index_hint)
   maildir_delayed_parsing(ctx->mailbox, &md, NULL);
 
   /* Incorporate new messages */
-  have_new = maildir_move_to_context(ctx, &md);
+  have_new = maildir_move_to_context(ctx, &md, &blocks);
 
   if (occult)
     return MUTT_REOPENED;
@@ -2718,6 +3066,7 @@ static int mh_mbox_check(struct Context *ctx, int *index_hint)
   struct stat st, st_cur;
   bool modified = false, have_new = false, occult = false, flags_changed = false;
   struct Maildir *md = NULL, *p = NULL;
+  struct MaildirBlock *blocks = NULL;
   struct Maildir **last = NULL;
   struct MhSequences mhs = { 0 };
   int count = 0;
@@ -2779,7 +3128,7 @@ static int mh_mbox_check(struct Context *ctx, int *index_hint)
   md = NULL;
   last = &md;
 
-  maildir_parse_dir(ctx->mailbox, &last, NULL, &count, NULL);
+  maildir_parse_dir(ctx->mailbox, &last, &blocks, NULL, &count, NULL);
   maildir_delayed_parsing(ctx->mailbox, &md, NULL);
 
   if (mh_read_sequences(&mhs, ctx->mailbox->path) < 0)
@@ -2788,7 +3137,7 @@ static int mh_mbox_check(struct Context *ctx, int *index_hint)
   mhs_free_sequences(&mhs);
 
   /* check for modifications and adjust flags */
-  fnames = mutt_hash_create(count, 0);
+  fnames = mutt_hash_create(count, MUTT_HASH_OPEN_ADDR);
 
   for (p = md; p; p = p->next)
   {
@@ -2825,7 +3174,7 @@ static int mh_mbox_check(struct Context *ctx, int *index_hint)
     maildir_update_tables(ctx, index_hint);
 
   /* Incorporate new messages */
-  have_new = maildir_move_to_context(ctx, &md);
+  have_new = maildir_move_to_context(ctx, &md, &blocks);
 
   if (occult)
     return MUTT_REOPENED;
@@ -2858,7 +3207,10 @@ static int mh_mbox_sync(struct Context *ctx, int *index_hint)
 
 #ifdef USE_HCACHE
   if (ctx->mailbox->magic == MUTT_MAILDIR || ctx->mailbox->magic == MUTT_MH)
+  {
     hc = mutt_hcache_open(HeaderCache, ctx->mailbox->path, NULL);
+    mutt_hcache_store_begin(hc);
+  }
 #endif
 
   if (!ctx->mailbox->quiet)
@@ -2884,7 +3236,10 @@ static int mh_mbox_sync(struct Context *ctx, int *index_hint)
 
 #ifdef USE_HCACHE
   if (ctx->mailbox->magic == MUTT_MAILDIR || ctx->mailbox->magic == MUTT_MH)
+  {
+    mutt_hcache_store_commit(hc);
     mutt_hcache_close(hc);
+  }
 #endif
 
   if (ctx->mailbox->magic == MUTT_MH)
@@ -2910,7 +3265,10 @@ static int mh_mbox_sync(struct Context *ctx, int *index_hint)
 err:
 #ifdef USE_HCACHE
   if (ctx->mailbox->magic == MUTT_MAILDIR || ctx->mailbox->magic == MUTT_MH)
+  {
+    mutt_hcache_store_commit(hc);
     mutt_hcache_close(hc);
+  }
 #endif
   return -1;
 }
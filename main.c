@@ -50,6 +50,7 @@
 #include "alias.h"
 #include "browser.h"
 #include "color.h"
+#include "commands.h"
 #include "context.h"
 #include "curs_lib.h"
 #include "curs_main.h"
@@ -592,7 +593,9 @@ int main(int argc, char *argv[], char *envp[])
     goto main_ok; // TEST04: neomutt -v
   }
 
-  Config = init_config(500);
+  /* MuttVars has well over 500 entries, and synonyms and account-inherited
+   * variables land in the same table - size it so lookups stay collision-free */
+  Config = init_config(1031);
   if (!Config)
     goto main_curses;
 
@@ -1238,11 +1241,13 @@ main_curses:
   if (repeat_error && ErrorBufMessage)
     puts(ErrorBuf);
 main_exit:
+  mutt_decoded_cache_free();
   crypto_module_free();
   mutt_window_free();
   mutt_envlist_free();
   mutt_free_opts();
   mutt_free_keys();
   cs_free(&Config);
+  mutt_buffer_pool_free();
   return rc;
 }
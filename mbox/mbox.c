@@ -34,6 +34,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -54,6 +55,10 @@
 #include "protos.h"
 #include "sort.h"
 
+/* stdio buffer size for parsing the mailbox; the default BUFSIZ means a
+ * read() per few lines on large folders */
+#define MBOX_READ_BUFSZ 65536
+
 /**
  * struct MUpdate - Store of new offsets, used by mutt_sync_mailbox()
  */
@@ -479,15 +484,26 @@ static int mbox_parse_mailbox(struct Context *ctx)
            */
           if (curhdr->lines == 0)
           {
-            int cl = curhdr->content->length;
+            LOFF_T cl = curhdr->content->length;
 
-            /* count the number of lines in this message */
+            /* count the number of lines in this message, a block at a time
+             * rather than with fgetc() per byte */
             if ((loc < 0) || (fseeko(mdata->fp, loc, SEEK_SET) != 0))
               mutt_debug(1, "#2 fseek() failed\n");
-            while (cl-- > 0)
+            while (cl > 0)
             {
-              if (fgetc(mdata->fp) == '\n')
+              size_t chunk = (cl > (LOFF_T) sizeof(buf)) ? sizeof(buf) : (size_t) cl;
+              chunk = fread(buf, 1, chunk, mdata->fp);
+              if (chunk == 0)
+                break;
+              const char *p = buf;
+              const char *end = buf + chunk;
+              while ((p = memchr(p, '\n', end - p)))
+              {
                 curhdr->lines++;
+                p++;
+              }
+              cl -= chunk;
             }
           }
 
@@ -631,8 +647,11 @@ static int reopen_mailbox(struct Context *ctx, int *index_hint)
       if (!mdata->fp)
         rc = -1;
       else
+      {
+        setvbuf(mdata->fp, NULL, _IOFBF, MBOX_READ_BUFSZ);
         rc = ((ctx->mailbox->magic == MUTT_MBOX) ? mbox_parse_mailbox :
                                                    mmdf_parse_mailbox)(ctx);
+      }
       break;
 
     default:
@@ -659,10 +678,20 @@ static int reopen_mailbox(struct Context *ctx, int *index_hint)
 
   if (!ctx->mailbox->readonly)
   {
+    int old_remaining = old_msgcount;
+
     for (i = 0; i < ctx->mailbox->msg_count; i++)
     {
       bool found = false;
 
+      /* once every old header has been claimed, the rest of the new
+       * messages are appended mail and there is nothing left to match;
+       * this keeps a delivery to a large folder linear instead of
+       * rescanning the whole old header array per new message
+       */
+      if (old_remaining == 0)
+        break;
+
       /* some messages have been deleted, and new  messages have been
        * appended at the end; the heuristic is that old messages have then
        * "advanced" towards the beginning of the folder, so we begin the
@@ -715,6 +744,7 @@ static int reopen_mailbox(struct Context *ctx, int *index_hint)
 
         /* we don't need this header any more */
         mutt_email_free(&(old_hdrs[j]));
+        old_remaining--;
       }
     }
 
@@ -804,6 +834,7 @@ static int mbox_mbox_open(struct Context *ctx)
     mutt_perror(mailbox->path);
     return -1;
   }
+  setvbuf(mdata->fp, NULL, _IOFBF, MBOX_READ_BUFSZ);
   mutt_sig_block();
   if (mbox_lock_mailbox(mailbox, false, true) == -1)
   {
@@ -1356,6 +1387,39 @@ bail: /* Come here in case of disaster */
   return rc;
 }
 
+/**
+ * mbox_flush_append - Sync a batch of appends to disk
+ * @param ctx Mailbox
+ * @retval  0 Success, or nothing to flush
+ * @retval -1 Error, the appended messages may not be durable
+ *
+ * Ends a #Context::batch_append run: the per-message commits skipped their
+ * fsync, so the whole batch hits the disk here.  Callers must check the
+ * result before recording any destructive follow-up (e.g. deleting the
+ * saved messages from their source mailbox).
+ */
+int mbox_flush_append(struct Context *ctx)
+{
+  if (!ctx->batch_append ||
+      ((ctx->mailbox->magic != MUTT_MBOX) && (ctx->mailbox->magic != MUTT_MMDF)))
+  {
+    return 0;
+  }
+
+  struct MboxData *mdata = get_mboxdata(ctx->mailbox);
+  if (!mdata || !mdata->fp)
+    return 0;
+
+  ctx->batch_append = false;
+  if ((fflush(mdata->fp) == EOF) || (fsync(fileno(mdata->fp)) == -1))
+  {
+    mutt_perror(_("Can't write message"));
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
  * mbox_mbox_close - Implements MxOps::mbox_close()
  * @retval 0 Always
@@ -1371,6 +1435,9 @@ static int mbox_mbox_close(struct Context *ctx)
 
   if (mdata->append)
   {
+    /* flush the appends whose commit skipped the per-message fsync */
+    if (ctx->batch_append && ((fflush(mdata->fp) == EOF) || (fsync(fileno(mdata->fp)) == -1)))
+      mutt_perror(_("Can't write message"));
     mutt_file_unlock(fileno(mdata->fp));
     mutt_sig_unblock();
   }
@@ -1433,7 +1500,9 @@ static int mbox_msg_commit(struct Context *ctx, struct Message *msg)
   if (fputc('\n', msg->fp) == EOF)
     return -1;
 
-  if ((fflush(msg->fp) == EOF) || (fsync(fileno(msg->fp)) == -1))
+  /* in a batch append, one fsync at close covers all the messages */
+  if ((fflush(msg->fp) == EOF) ||
+      (!ctx->batch_append && (fsync(fileno(msg->fp)) == -1)))
   {
     mutt_perror(_("Can't write message"));
     return -1;
@@ -1590,7 +1659,9 @@ static int mmdf_msg_commit(struct Context *ctx, struct Message *msg)
   if (fputs(MMDF_SEP, msg->fp) == EOF)
     return -1;
 
-  if ((fflush(msg->fp) == EOF) || (fsync(fileno(msg->fp)) == -1))
+  /* in a batch append, one fsync at close covers all the messages */
+  if ((fflush(msg->fp) == EOF) ||
+      (!ctx->batch_append && (fsync(fileno(msg->fp)) == -1)))
   {
     mutt_perror(_("Can't write message"));
     return -1;
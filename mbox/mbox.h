@@ -33,6 +33,7 @@
 #ifndef MUTT_MBOX_MBOX_H
 #define MUTT_MBOX_MBOX_H
 
+struct Context;
 struct Mailbox;
 struct stat;
 
@@ -42,6 +43,7 @@ extern struct MxOps mx_mmdf_ops;
 #define MMDF_SEP "\001\001\001\001\n"
 
 void mbox_reset_atime(struct Mailbox *mailbox, struct stat *st);
+int mbox_flush_append(struct Context *ctx);
 int mbox_path_probe(const char *path, const struct stat *st);
 
 #endif /* MUTT_MBOX_MBOX_H */
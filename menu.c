@@ -403,16 +403,25 @@ void menu_redraw_sidebar(struct Menu *menu)
 #endif
 
 /**
- * menu_redraw_index - Force the redraw of the index
- * @param menu Current Menu
+ * menu_redraw_rows_range - Repaint a range of rows of the menu
+ * @param menu  Current Menu
+ * @param first First row to repaint
+ * @param last  Last row to repaint
+ *
+ * The range is given in menu entries and is clamped to the visible page.
  */
-void menu_redraw_index(struct Menu *menu)
+static void menu_redraw_rows_range(struct Menu *menu, int first, int last)
 {
   char buf[LONG_STRING];
   bool do_color;
   int attr;
 
-  for (int i = menu->top; i < menu->top + menu->pagelen; i++)
+  if (first < menu->top)
+    first = menu->top;
+  if (last > menu->top + menu->pagelen - 1)
+    last = menu->top + menu->pagelen - 1;
+
+  for (int i = first; i <= last; i++)
   {
     if (i < menu->max)
     {
@@ -449,9 +458,57 @@ void menu_redraw_index(struct Menu *menu)
     }
   }
   NORMAL_COLOR;
+}
+
+/**
+ * menu_redraw_index - Force the redraw of the index
+ * @param menu Current Menu
+ */
+void menu_redraw_index(struct Menu *menu)
+{
+  menu_redraw_rows_range(menu, menu->top, menu->top + menu->pagelen - 1);
   menu->redraw = 0;
 }
 
+/**
+ * menu_redraw_rows - Repaint only the rows marked dirty
+ * @param menu Current Menu
+ *
+ * See mutt_menu_mark_dirty_rows().
+ */
+void menu_redraw_rows(struct Menu *menu)
+{
+  menu_redraw_rows_range(menu, menu->dirty_first, menu->dirty_last);
+  menu->redraw &= ~REDRAW_ROWS;
+}
+
+/**
+ * mutt_menu_mark_dirty_rows - Note a range of rows that needs repainting
+ * @param menu  Current Menu
+ * @param first First changed row
+ * @param last  Last changed row
+ *
+ * Operations that touch a known, limited set of entries can use this instead
+ * of #REDRAW_INDEX, so the next redraw only re-formats the changed rows
+ * instead of the whole page.
+ */
+void mutt_menu_mark_dirty_rows(struct Menu *menu, int first, int last)
+{
+  if (menu->redraw & REDRAW_ROWS)
+  {
+    if (first < menu->dirty_first)
+      menu->dirty_first = first;
+    if (last > menu->dirty_last)
+      menu->dirty_last = last;
+  }
+  else
+  {
+    menu->dirty_first = first;
+    menu->dirty_last = last;
+    menu->redraw |= REDRAW_ROWS;
+  }
+}
+
 /**
  * menu_redraw_motion - Force the redraw of the list part of the menu
  * @param menu Current Menu
@@ -1280,6 +1337,9 @@ static int menu_dialog_dokey(struct Menu *menu, int *ip)
  */
 int menu_redraw(struct Menu *menu)
 {
+  if (menu->redraw & REDRAW_FULL)
+    log_trace_add("menu_redraw: full");
+
   if (menu->custom_menu_redraw)
   {
     menu->custom_menu_redraw(menu);
@@ -1305,6 +1365,8 @@ int menu_redraw(struct Menu *menu)
 #endif
   if (menu->redraw & REDRAW_INDEX)
     menu_redraw_index(menu);
+  else if (menu->redraw & REDRAW_ROWS)
+    menu_redraw_rows(menu);
   else if (menu->redraw & (REDRAW_MOTION | REDRAW_MOTION_RESYNCH))
     menu_redraw_motion(menu);
   else if (menu->redraw == REDRAW_CURRENT)
@@ -1588,6 +1650,10 @@ bool mutt_menu_listener(const struct ConfigSet *cs, struct HashElem *he,
   if (flags == 0)
     return true;
 
+  /* any setting that forces a redraw may also change how index lines are
+   * rendered, so retire the cached ones */
+  IndexLineGen++;
+
   if (flags & R_INDEX)
     mutt_menu_set_redraw_full(MENU_MAIN);
   if (flags & R_PAGER)
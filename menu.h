@@ -47,6 +47,7 @@ struct HashElem;
 #ifdef USE_SIDEBAR
 #define REDRAW_SIDEBAR        (1 << 8)
 #endif
+#define REDRAW_ROWS           (1 << 9) /* Repaint only Menu::dirty_first..dirty_last */
 
 #define MUTT_MODEFMT "-- NeoMutt: %s"
 
@@ -98,8 +99,10 @@ struct Menu
   int (*color)(int i);
 
   /* the following are used only by mutt_menu_loop() */
-  int top;        /**< entry that is the top of the current page */
-  int oldcurrent; /**< for driver use only. */
+  int top;         /**< entry that is the top of the current page */
+  int oldcurrent;  /**< for driver use only. */
+  int dirty_first; /**< first row to repaint for #REDRAW_ROWS */
+  int dirty_last;  /**< last row to repaint for #REDRAW_ROWS */
   int search_dir;  /**< direction of search */
   int tagged;     /**< number of tagged entries */
 };
@@ -122,6 +125,7 @@ void         menu_redraw_current(struct Menu *menu);
 void         menu_redraw_full(struct Menu *menu);
 void         menu_redraw_index(struct Menu *menu);
 void         menu_redraw_motion(struct Menu *menu);
+void         menu_redraw_rows(struct Menu *menu);
 #ifdef USE_SIDEBAR
 void         menu_redraw_sidebar(struct Menu *menu);
 #endif
@@ -132,6 +136,7 @@ void         mutt_menu_current_redraw(void);
 void         mutt_menu_destroy(struct Menu **p);
 void         mutt_menu_init(void);
 int          mutt_menu_loop(struct Menu *menu);
+void         mutt_menu_mark_dirty_rows(struct Menu *menu, int first, int last);
 struct Menu *mutt_menu_new(int menu);
 void         mutt_menu_pop_current(struct Menu *menu);
 void         mutt_menu_push_current(struct Menu *menu);
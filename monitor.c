@@ -50,10 +50,21 @@ static size_t PollFdsLen = 0;
 static struct pollfd *PollFds = NULL;
 
 static int MonitorContextDescriptor = -1;
+static int MonitorConnFd = -1;
 
-#define INOTIFY_MASK_DIR (IN_MOVED_TO | IN_ATTRIB | IN_CLOSE_WRITE | IN_ISDIR)
+#define INOTIFY_MASK_DIR                                                       \
+  (IN_MOVED_TO | IN_ATTRIB | IN_CLOSE_WRITE | IN_ISDIR | IN_CREATE |           \
+   IN_DELETE | IN_MOVED_FROM)
 #define INOTIFY_MASK_FILE IN_CLOSE_WRITE
 
+/* Stop collecting per-file change names once this many have piled up;
+ * beyond that a full directory scan is cheaper anyway */
+#define MONITOR_CHANGES_MAX 512
+
+static struct ListHead MonitorContextChanges = STAILQ_HEAD_INITIALIZER(MonitorContextChanges);
+static int MonitorContextChangesCount = 0;
+static bool MonitorContextChangesValid = true;
+
 #define EVENT_BUFLEN MAX(4096, sizeof(struct inotify_event) + NAME_MAX + 1)
 
 #define RESOLVERES_FAIL_NOMAILBOX -3
@@ -337,6 +348,120 @@ static int monitor_resolve(struct MonitorInfo *info, struct Mailbox *mailbox)
   return iter ? RESOLVERES_OK_EXISTING : RESOLVERES_OK_NOTEXISTING;
 }
 
+/**
+ * monitor_reset_changes - Restart per-file change tracking for the Context
+ */
+static void monitor_reset_changes(void)
+{
+  mutt_list_free(&MonitorContextChanges);
+  MonitorContextChangesCount = 0;
+  MonitorContextChangesValid = true;
+}
+
+/**
+ * monitor_abandon_changes - Give up per-file change tracking for the Context
+ *
+ * Called when we can no longer be sure we saw every change, e.g. after the
+ * kernel dropped events.  The next mailbox check falls back to a full scan.
+ */
+static void monitor_abandon_changes(void)
+{
+  mutt_list_free(&MonitorContextChanges);
+  MonitorContextChangesCount = 0;
+  MonitorContextChangesValid = false;
+}
+
+/**
+ * monitor_record_change - Remember the file named in a Context watch event
+ * @param event Event naming a changed file
+ *
+ * Collect the file names the kernel reports for the open mailbox, so the
+ * mailbox checker can process just those files.  If an event carries no name
+ * or too many names pile up, tracking is abandoned for this round.
+ */
+static void monitor_record_change(const struct inotify_event *event)
+{
+  if (!MonitorContextChangesValid)
+    return;
+
+  if ((event->len == 0) || (MonitorContextChangesCount == MONITOR_CHANGES_MAX))
+  {
+    monitor_abandon_changes();
+    return;
+  }
+
+  /* a file often triggers several events (e.g. create, then close); keep
+   * each name only once */
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &MonitorContextChanges, entries)
+  {
+    if (mutt_str_strcmp(np->data, event->name) == 0)
+      return;
+  }
+
+  mutt_list_insert_tail(&MonitorContextChanges, mutt_str_strdup(event->name));
+  MonitorContextChangesCount++;
+}
+
+/**
+ * mutt_monitor_take_changes - Hand over the recorded changes for the Context
+ * @param dst List the file names are appended to
+ * @retval true  dst holds every name changed since the last call
+ * @retval false tracking was interrupted; the caller must do a full scan
+ *
+ * Ownership of the names passes to the caller.  Tracking restarts afresh
+ * either way.
+ */
+bool mutt_monitor_take_changes(struct ListHead *dst)
+{
+  bool valid = MonitorContextChangesValid && (MonitorContextDescriptor != -1) &&
+               !STAILQ_EMPTY(&MonitorContextChanges);
+
+  if (valid)
+    STAILQ_CONCAT(dst, &MonitorContextChanges);
+  monitor_reset_changes();
+  return valid;
+}
+
+/**
+ * mutt_monitor_watch_fd - Watch a descriptor on behalf of the open mailbox
+ * @param fd Descriptor to watch for readability
+ * @retval  0 success
+ * @retval -1 monitoring inactive or fd invalid
+ *
+ * Lets a server connection belonging to the Context (e.g. an idling IMAP
+ * socket) wake the event loop the moment data arrives, instead of waiting
+ * for the next timeout-driven poll.  Only one such descriptor is tracked;
+ * watching a new one replaces the old.
+ */
+int mutt_monitor_watch_fd(int fd)
+{
+  if ((fd < 0) || ((INotifyFd == -1) && (monitor_init() == -1)))
+    return -1;
+
+  if (MonitorConnFd != -1)
+    mutt_poll_fd_remove(MonitorConnFd);
+  MonitorConnFd = fd;
+  mutt_poll_fd_add(fd, POLLIN);
+  return 0;
+}
+
+/**
+ * mutt_monitor_unwatch_fd - Stop watching a descriptor
+ * @param fd Descriptor passed to mutt_monitor_watch_fd()
+ *
+ * Unknown descriptors are ignored, so callers needn't track whether the
+ * watch is still current.
+ */
+void mutt_monitor_unwatch_fd(int fd)
+{
+  if ((fd != -1) && (fd == MonitorConnFd))
+  {
+    mutt_poll_fd_remove(fd);
+    MonitorConnFd = -1;
+  }
+}
+
 /**
  * mutt_monitor_poll - Check for filesystem changes
  * @retval -3 unknown/unexpected events: poll timeout / fds not handled by us
@@ -382,6 +507,14 @@ int mutt_monitor_poll(void)
           {
             inputReady = true;
           }
+          else if (PollFds[i].fd == MonitorConnFd)
+          {
+            /* data on the watched connection, e.g. an idling IMAP server
+             * announcing new mail: treat it like a Context change */
+            MonitorFilesChanged = 1;
+            MonitorContextChanged = 1;
+            mutt_debug(3, "connection data detected\n");
+          }
           else if (PollFds[i].fd == INotifyFd)
           {
             MonitorFilesChanged = 1;
@@ -406,10 +539,20 @@ int mutt_monitor_poll(void)
                 event = (const struct inotify_event *) ptr;
                 mutt_debug(5, "+ detail: descriptor=%d mask=0x%x\n", event->wd,
                            event->mask);
-                if (event->mask & IN_IGNORED)
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                  /* the kernel dropped events; assume the Context changed
+                   * and force the checker to do a full scan */
+                  MonitorContextChanged = 1;
+                  monitor_abandon_changes();
+                }
+                else if (event->mask & IN_IGNORED)
                   monitor_handle_ignore(event->wd);
                 else if (event->wd == MonitorContextDescriptor)
+                {
                   MonitorContextChanged = 1;
+                  monitor_record_change(event);
+                }
                 ptr += sizeof(struct inotify_event) + event->len;
               }
             }
@@ -440,7 +583,10 @@ int mutt_monitor_add(struct Mailbox *mailbox)
   if (desc != RESOLVERES_OK_NOTEXISTING)
   {
     if (!mailbox && (desc == RESOLVERES_OK_EXISTING))
+    {
       MonitorContextDescriptor = info.monitor->desc;
+      monitor_reset_changes();
+    }
     return (desc == RESOLVERES_OK_EXISTING) ? 0 : -1;
   }
 
@@ -455,7 +601,10 @@ int mutt_monitor_add(struct Mailbox *mailbox)
 
   mutt_debug(3, "inotify_add_watch descriptor=%d for '%s'\n", desc, info.path);
   if (!mailbox)
+  {
     MonitorContextDescriptor = desc;
+    monitor_reset_changes();
+  }
 
   monitor_create(&info, desc);
   return 0;
@@ -478,6 +627,7 @@ int mutt_monitor_remove(struct Mailbox *mailbox)
   {
     MonitorContextDescriptor = -1;
     MonitorContextChanged = 0;
+    monitor_reset_changes();
   }
 
   if (monitor_resolve(&info, mailbox) != RESOLVERES_OK_EXISTING)
@@ -23,13 +23,19 @@
 #ifndef MUTT_MONITOR_H
 #define MUTT_MONITOR_H
 
+#include <stdbool.h>
+
 extern int MonitorFilesChanged;
 extern int MonitorContextChanged;
 
+struct ListHead;
 struct Mailbox;
 
 int mutt_monitor_add(struct Mailbox *m);
 int mutt_monitor_remove(struct Mailbox *m);
 int mutt_monitor_poll(void);
+bool mutt_monitor_take_changes(struct ListHead *dst);
+int mutt_monitor_watch_fd(int fd);
+void mutt_monitor_unwatch_fd(int fd);
 
 #endif /* MUTT_MONITOR_H */
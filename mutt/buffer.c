@@ -36,6 +36,13 @@
 #include "memory.h"
 #include "string2.h"
 
+/* recycled Buffers, see mutt_buffer_pool_get() */
+#define BUFFER_POOL_GROW 16
+#define BUFFER_POOL_INITIAL_SIZE 1024
+static size_t BufferPoolCount = 0;
+static size_t BufferPoolLen = 0;
+static struct Buffer **BufferPool = NULL;
+
 /**
  * mutt_buffer_new - Create and initialise a Buffer
  * @retval ptr New Buffer
@@ -255,6 +262,67 @@ struct Buffer *mutt_buffer_alloc(size_t size)
   return b;
 }
 
+/**
+ * mutt_buffer_len - Calculate the length of a Buffer
+ * @param buf Buffer
+ * @retval num Length of data in the Buffer
+ *
+ * The length is tracked in the write position, so this is O(1).
+ */
+size_t mutt_buffer_len(const struct Buffer *buf)
+{
+  if (!buf || !buf->data || !buf->dptr)
+    return 0;
+
+  return buf->dptr - buf->data;
+}
+
+/**
+ * mutt_buffer_pool_get - Get a Buffer from the pool
+ * @retval ptr Empty Buffer
+ *
+ * Avoids allocation churn for short-lived Buffers, e.g. one per index line
+ * during a redraw.  Give the Buffer back with mutt_buffer_pool_release().
+ */
+struct Buffer *mutt_buffer_pool_get(void)
+{
+  if (BufferPoolCount)
+    return BufferPool[--BufferPoolCount];
+
+  return mutt_buffer_alloc(BUFFER_POOL_INITIAL_SIZE);
+}
+
+/**
+ * mutt_buffer_pool_release - Return a Buffer to the pool
+ * @param pbuf Buffer to release
+ */
+void mutt_buffer_pool_release(struct Buffer **pbuf)
+{
+  if (!pbuf || !*pbuf)
+    return;
+
+  if (BufferPoolCount >= BufferPoolLen)
+  {
+    BufferPoolLen += BUFFER_POOL_GROW;
+    mutt_mem_realloc(&BufferPool, BufferPoolLen * sizeof(struct Buffer *));
+  }
+  mutt_buffer_reset(*pbuf);
+  BufferPool[BufferPoolCount++] = *pbuf;
+
+  *pbuf = NULL;
+}
+
+/**
+ * mutt_buffer_pool_free - Release the Buffer pool
+ */
+void mutt_buffer_pool_free(void)
+{
+  while (BufferPoolCount)
+    mutt_buffer_free(&BufferPool[--BufferPoolCount]);
+  FREE(&BufferPool);
+  BufferPoolLen = 0;
+}
+
 /**
  * mutt_buffer_increase_size - Increase the allocated size of a buffer
  * @param buf      Buffer to change
@@ -49,7 +49,11 @@ struct Buffer *mutt_buffer_from(const char *seed);
 void           mutt_buffer_increase_size(struct Buffer *buf, size_t new_size);
 struct Buffer *mutt_buffer_init(struct Buffer *b);
 bool           mutt_buffer_is_empty(const struct Buffer *buf);
+size_t         mutt_buffer_len(const struct Buffer *buf);
 struct Buffer *mutt_buffer_new(void);
+void           mutt_buffer_pool_free(void);
+struct Buffer *mutt_buffer_pool_get(void);
+void           mutt_buffer_pool_release(struct Buffer **pbuf);
 int            mutt_buffer_printf(struct Buffer *buf, const char *fmt, ...);
 void           mutt_buffer_reset(struct Buffer *b);
 
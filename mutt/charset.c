@@ -61,6 +61,33 @@ wchar_t ReplacementChar = '?';
  */
 bool CharsetIsUtf8 = false;
 
+/* Number of conversion descriptors to keep open */
+#define ICONV_CACHE_SIZE 16
+
+/**
+ * struct IconvCacheEntry - Cached iconv conversion descriptor
+ *
+ * Header decoding opens the same few conversions over and over; iconv_open()
+ * is expensive on most systems, so open descriptors are kept in a small
+ * least-recently-used cache and reset for reuse instead of being closed.
+ */
+struct IconvCacheEntry
+{
+  char *fromcode;    /**< requested 'from' character set */
+  char *tocode;      /**< requested 'to' character set */
+  int flags;         /**< hook flags the conversion was opened with */
+  unsigned int gen;  /**< value of #LookupsGeneration at resolution time */
+  iconv_t cd;        /**< open conversion descriptor */
+  unsigned int used; /**< tick of the last use, for eviction */
+};
+
+static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
+static unsigned int IconvCacheTick = 0;
+
+/* bumped whenever the charset-hook/iconv-hook lookups change, so that
+ * cached resolutions of the raw charset names cannot go stale */
+static unsigned int LookupsGeneration = 0;
+
 /**
  * struct Lookup - Regex to String lookup table
  *
@@ -455,6 +482,8 @@ bool mutt_ch_lookup_add(enum LookupType type, const char *pat,
     return false;
   }
 
+  LookupsGeneration++;
+
   struct Lookup *l = mutt_mem_calloc(1, sizeof(struct Lookup));
   l->type = type;
   l->replacement = mutt_str_strdup(replace);
@@ -477,6 +506,8 @@ void mutt_ch_lookup_remove(void)
   struct Lookup *l = NULL;
   struct Lookup *tmp = NULL;
 
+  LookupsGeneration++;
+
   TAILQ_FOREACH_SAFE(l, &Lookups, entries, tmp)
   {
     TAILQ_REMOVE(&Lookups, l, entries);
@@ -524,6 +555,12 @@ const char *mutt_ch_charset_lookup(const char *chs)
  *
  * @note The top-well-named MUTT_ICONV_HOOK_FROM acts on charset-hooks,
  * not at all on iconv-hooks.
+ *
+ * @note The descriptor is owned by a cache: do not iconv_close() it, it is
+ * reset and handed out again when the same conversion is requested.  The LRU
+ * eviction assumes at most one cached descriptor is live at a time; callers
+ * holding several concurrently must pass #MUTT_ICONV_NO_CACHE and close the
+ * descriptors themselves, or an eviction may close one still in use.
  */
 iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, int flags)
 {
@@ -534,6 +571,30 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, int flags)
 
   iconv_t cd;
 
+  /* a cache hit on the raw names also skips the canonicalisation and the
+   * hook lookups below; entries resolved before the hooks last changed do
+   * not match and are re-resolved */
+  int empty = -1;
+  int lru = 0;
+  for (int i = 0; !(flags & MUTT_ICONV_NO_CACHE) && (i < ICONV_CACHE_SIZE); i++)
+  {
+    if (!IconvCache[i].fromcode)
+    {
+      empty = i;
+      continue;
+    }
+    if ((IconvCache[i].gen == LookupsGeneration) && (IconvCache[i].flags == flags) &&
+        (strcmp(IconvCache[i].tocode, tocode) == 0) &&
+        (strcmp(IconvCache[i].fromcode, fromcode) == 0))
+    {
+      IconvCache[i].used = ++IconvCacheTick;
+      iconv(IconvCache[i].cd, NULL, NULL, NULL, NULL); /* reset shift state */
+      return IconvCache[i].cd;
+    }
+    if (IconvCache[i].used < IconvCache[lru].used)
+      lru = i;
+  }
+
   /* transform to MIME preferred charset names */
   mutt_ch_canonical_charset(tocode1, sizeof(tocode1), tocode);
   mutt_ch_canonical_charset(fromcode1, sizeof(fromcode1), fromcode);
@@ -556,10 +617,28 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, int flags)
 
   /* call system iconv with names it appreciates */
   cd = iconv_open(tocode2, fromcode2);
-  if (cd != (iconv_t) -1)
+  if (cd == (iconv_t) -1)
+    return (iconv_t) -1;
+
+  /* the caller keeps several descriptors open at once and owns this one */
+  if (flags & MUTT_ICONV_NO_CACHE)
     return cd;
 
-  return (iconv_t) -1;
+  /* cache it, evicting the least-recently-used conversion if need be */
+  if (empty < 0)
+  {
+    empty = lru;
+    iconv_close(IconvCache[empty].cd);
+    FREE(&IconvCache[empty].fromcode);
+    FREE(&IconvCache[empty].tocode);
+  }
+  IconvCache[empty].fromcode = mutt_str_strdup(fromcode);
+  IconvCache[empty].tocode = mutt_str_strdup(tocode);
+  IconvCache[empty].flags = flags;
+  IconvCache[empty].gen = LookupsGeneration;
+  IconvCache[empty].cd = cd;
+  IconvCache[empty].used = ++IconvCacheTick;
+  return cd;
 }
 
 /**
@@ -694,7 +773,6 @@ int mutt_ch_check(const char *s, size_t slen, const char *from, const char *to)
     rc = errno;
 
   FREE(&saved_out);
-  iconv_close(cd);
   return rc;
 }
 
@@ -750,7 +828,6 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, int flag
   ob = buf;
 
   mutt_ch_iconv(cd, &ib, &ibl, &ob, &obl, inrepls, outrepl, &rc);
-  iconv_close(cd);
 
   *ob = '\0';
 
@@ -793,10 +870,7 @@ bool mutt_ch_check_charset(const char *cs, bool strict)
 
   cd = mutt_ch_iconv_open(cs, cs, 0);
   if (cd != (iconv_t)(-1))
-  {
-    iconv_close(cd);
     return true;
-  }
 
   return false;
 }
@@ -843,8 +917,7 @@ struct FgetConv *mutt_ch_fgetconv_open(FILE *file, const char *from, const char
  */
 void mutt_ch_fgetconv_close(struct FgetConv **fc)
 {
-  if ((*fc)->cd != (iconv_t) -1)
-    iconv_close((*fc)->cd);
+  /* the descriptor belongs to the mutt_ch_iconv_open() cache */
   FREE(fc);
 }
 
@@ -910,6 +983,45 @@ int mutt_ch_fgetconv(struct FgetConv *fc)
   return EOF;
 }
 
+/**
+ * mutt_ch_fgetconv_buf - Read a block of converted data
+ * @param fc     FgetConv handle
+ * @param buf    Buffer for result
+ * @param buflen Length of buffer
+ * @retval num Number of bytes read, 0 at end of file
+ *
+ * Like mutt_ch_fgetconv(), but fills a whole buffer, so bulk consumers
+ * (e.g. attachment encoding) aren't charged a function call per byte.  When
+ * no conversion is needed the data is read with a single fread(); otherwise
+ * the already-converted span is copied in one go.
+ */
+size_t mutt_ch_fgetconv_buf(struct FgetConv *fc, char *buf, size_t buflen)
+{
+  if (!fc)
+    return 0;
+  if (fc->cd == (iconv_t) -1)
+    return fread(buf, 1, buflen, fc->file);
+
+  size_t len = 0;
+  while (len < buflen)
+  {
+    if (fc->p && (fc->p < fc->ob))
+    {
+      size_t n = MIN((size_t)(fc->ob - fc->p), buflen - len);
+      memcpy(buf + len, fc->p, n);
+      fc->p += n;
+      len += n;
+      continue;
+    }
+    /* refill the conversion buffer */
+    const int c = mutt_ch_fgetconv(fc);
+    if (c == EOF)
+      break;
+    buf[len++] = (char) c;
+  }
+  return len;
+}
+
 /**
  * mutt_ch_fgetconvs - Convert a file's charset into a string buffer
  * @param buf    Buffer for result
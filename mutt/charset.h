@@ -42,8 +42,10 @@ struct FgetConv
 {
   FILE *file;
   iconv_t cd;
-  char bufi[512];
-  char bufo[512];
+  /* the handle is heap-allocated, so size the buffers for iconv call count,
+   * not stack frugality: one conversion per 16KiB instead of per 512 bytes */
+  char bufi[16384];
+  char bufo[16384];
   char *p;
   char *ob;
   char *ib;
@@ -79,6 +81,7 @@ enum LookupType
 };
 
 #define MUTT_ICONV_HOOK_FROM 1 /**< apply charset-hooks to fromcode */
+#define MUTT_ICONV_NO_CACHE 2  /**< descriptor is not cached; caller must iconv_close() it */
 
 extern const struct MimeNames PreferredMimeNames[];
 
@@ -91,6 +94,7 @@ bool             mutt_ch_chscmp(const char *cs1, const char *cs2);
 int              mutt_ch_convert_nonmime_string(char **ps);
 int              mutt_ch_convert_string(char **ps, const char *from, const char *to, int flags);
 int              mutt_ch_fgetconv(struct FgetConv *fc);
+size_t           mutt_ch_fgetconv_buf(struct FgetConv *fc, char *buf, size_t buflen);
 void             mutt_ch_fgetconv_close(struct FgetConv **fc);
 struct FgetConv *mutt_ch_fgetconv_open(FILE *file, const char *from, const char *to, int flags);
 char *           mutt_ch_fgetconvs(char *buf, size_t buflen, struct FgetConv *fc);
@@ -39,6 +39,7 @@
 #include <string.h>
 #include <sys/file.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
 #include <utime.h>
 #include "file.h"
@@ -237,6 +238,35 @@ void mutt_file_unlink(const char *s)
  */
 int mutt_file_copy_bytes(FILE *in, FILE *out, size_t size)
 {
+#ifdef HAVE_COPY_FILE_RANGE
+  /* On the folder-save path both streams sit on regular files and the kernel
+   * can move the body without it ever entering userspace.  Sync the stdio
+   * positions with the file descriptors, hand off to copy_file_range(), and
+   * fall back to the read/write loop for whatever the kernel refuses
+   * (e.g. the destination is a pipe). */
+  if ((size > 0) && (fflush(out) == 0))
+  {
+    off_t inpos = ftello(in);
+    off_t outpos = ftello(out);
+    if ((inpos >= 0) && (outpos >= 0) && (fseeko(in, inpos, SEEK_SET) == 0))
+    {
+      while (size > 0)
+      {
+        ssize_t chunk = copy_file_range(fileno(in), NULL, fileno(out), NULL, size, 0);
+        if (chunk <= 0)
+          break;
+        inpos += chunk;
+        outpos += chunk;
+        size -= chunk;
+      }
+      /* resync stdio with wherever the descriptors ended up */
+      if ((fseeko(in, inpos, SEEK_SET) != 0) || (fseeko(out, outpos, SEEK_SET) != 0))
+        return -1;
+      if (size == 0)
+        return 0;
+    }
+  }
+#endif
   while (size > 0)
   {
     char buf[2048];
@@ -267,6 +297,32 @@ int mutt_file_copy_stream(FILE *fin, FILE *fout)
   size_t l;
   char buf[LONG_STRING];
 
+#ifdef HAVE_COPY_FILE_RANGE
+  /* same trick as mutt_file_copy_bytes(): when both streams sit on regular
+   * files (e.g. saving an unencoded attachment), let the kernel move - or on
+   * reflink-capable filesystems, clone - the bytes.  The first call failing
+   * means one side isn't a regular file; fall through with nothing consumed. */
+  if (fflush(fout) == 0)
+  {
+    off_t inpos = ftello(fin);
+    off_t outpos = ftello(fout);
+    if ((inpos >= 0) && (outpos >= 0) && (fseeko(fin, inpos, SEEK_SET) == 0))
+    {
+      ssize_t chunk;
+      while ((chunk = copy_file_range(fileno(fin), NULL, fileno(fout), NULL,
+                                      1 << 30, 0)) > 0)
+      {
+        inpos += chunk;
+        outpos += chunk;
+      }
+      if ((fseeko(fin, inpos, SEEK_SET) != 0) || (fseeko(fout, outpos, SEEK_SET) != 0))
+        return -1;
+      if (chunk == 0)
+        return 0; /* reached end of input */
+    }
+  }
+#endif
+
   while ((l = fread(buf, 1, sizeof(buf), fin)) > 0)
   {
     if (fwrite(buf, 1, l, fout) != l)
@@ -680,9 +736,11 @@ char *mutt_file_read_line(char *s, size_t *size, FILE *fp, int *line, int flags)
       else
       {
         ungetc(c, fp); /* undo our damage */
-        /* There wasn't room for the line -- increase ``s'' */
+        /* There wasn't room for the line -- increase ``s''.  Grow
+         * geometrically, so a pathologically long line doesn't pay a
+         * realloc-and-copy for every #STRING bytes of its length. */
         offset = *size - 1; /* overwrite the terminating 0 */
-        *size += STRING;
+        *size += MAX(STRING, *size / 2);
         mutt_mem_realloc(&s, *size);
       }
     }
@@ -804,6 +862,24 @@ FILE *mutt_file_mkstemp_full(const char *file, int line, const char *func)
 {
   char name[PATH_MAX];
 
+#ifdef O_TMPFILE
+  /* Try an unnamed temp file first: it never appears in the directory, so
+   * the create/unlink metadata round trip is saved and a crash can't leave
+   * it behind.  Not every filesystem supports it, so quietly fall back. */
+  int tfd = open(NONULL(Tmpdir), O_TMPFILE | O_RDWR, 0600);
+  if (tfd != -1)
+  {
+    FILE *tfp = fdopen(tfd, "w+");
+    if (!tfp)
+    {
+      close(tfd);
+      return NULL;
+    }
+    MuttLogger(0, file, line, func, 1, "created unnamed temp file in '%s'\n", NONULL(Tmpdir));
+    return tfp;
+  }
+#endif
+
   int n = snprintf(name, sizeof(name), "%s/neomutt-XXXXXX", NONULL(Tmpdir));
   if (n < 0)
     return NULL;
@@ -1006,7 +1082,38 @@ int mutt_file_chmod_rm_stat(const char *path, mode_t mode, struct stat *st)
   return chmod(path, st->st_mode & ~mode);
 }
 
+#if defined(USE_FCNTL) || defined(USE_FLOCK)
+/**
+ * lock_backoff - Sleep before the next file-locking attempt
+ * @param attempt Number of attempts made so far, starting at 1
+ *
+ * A contended lock is usually held only briefly, e.g. by a delivery agent
+ * appending one message, so start with a short delay and double it on every
+ * failed attempt, capping at one second.
+ */
+static void lock_backoff(int attempt)
+{
+  struct timespec delay = { 0, 0 };
+
+  if (attempt < 5)
+    delay.tv_nsec = 100000000L << (attempt - 1); /* 0.1s, 0.2s, 0.4s, 0.8s */
+  else
+    delay.tv_sec = 1;
+  nanosleep(&delay, NULL);
+}
+#endif
+
 #if defined(USE_FCNTL)
+
+#ifdef F_OFD_SETLK
+/* Open File Description locks are owned by the open file description rather
+ * than the process, so closing an unrelated fd on the same mailbox can't
+ * silently drop a lock we still hold */
+#define MUTT_SETLK F_OFD_SETLK
+#else
+#define MUTT_SETLK F_SETLK
+#endif
+
 /**
  * mutt_file_lock - (try to) lock a file using fcntl()
  * @param fd      File descriptor to file
@@ -1030,7 +1137,7 @@ int mutt_file_lock(int fd, bool excl, bool timeout)
   lck.l_type = excl ? F_WRLCK : F_RDLCK;
   lck.l_whence = SEEK_SET;
 
-  while (fcntl(fd, F_SETLK, &lck) == -1)
+  while (fcntl(fd, MUTT_SETLK, &lck) == -1)
   {
     mutt_debug(1, "fcntl errno %d.\n", errno);
     if ((errno != EAGAIN) && (errno != EACCES))
@@ -1056,7 +1163,7 @@ int mutt_file_lock(int fd, bool excl, bool timeout)
     prev_sb = sb;
 
     mutt_message(_("Waiting for fcntl lock... %d"), ++attempt);
-    sleep(1);
+    lock_backoff(attempt);
   }
 
   return 0;
@@ -1074,7 +1181,7 @@ int mutt_file_unlock(int fd)
   memset(&unlockit, 0, sizeof(struct flock));
   unlockit.l_type = F_UNLCK;
   unlockit.l_whence = SEEK_SET;
-  fcntl(fd, F_SETLK, &unlockit);
+  fcntl(fd, MUTT_SETLK, &unlockit);
 
   return 0;
 }
@@ -1125,7 +1232,7 @@ int mutt_file_lock(int fd, bool excl, bool timeout)
     prev_sb = sb;
 
     mutt_message(_("Waiting for flock attempt... %d"), ++attempt);
-    sleep(1);
+    lock_backoff(attempt);
   }
 
   /* release any other locks obtained in this routine */
@@ -30,6 +30,7 @@
 #include "config.h"
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include "hash.h"
 #include "memory.h"
@@ -37,6 +38,17 @@
 
 #define SOMEPRIME 149711
 
+/* FNV-1a parameters, sized to match size_t.  The old shift-add multiplier
+ * clusters badly on the short, similar keys we feed it (Message-IDs,
+ * header names); FNV-1a costs the same per byte and distributes well. */
+#if SIZE_MAX > 0xffffffff
+#define FNV_OFFSET_BASIS 14695981039346656037UL
+#define FNV_PRIME 1099511628211UL
+#else
+#define FNV_OFFSET_BASIS 2166136261UL
+#define FNV_PRIME 16777619UL
+#endif
+
 /**
  * gen_string_hash - Generate a hash from a string
  * @param key String key
@@ -45,14 +57,13 @@
  */
 static size_t gen_string_hash(union HashKey key, size_t n)
 {
-  size_t h = 0;
+  size_t h = FNV_OFFSET_BASIS;
   unsigned char *s = (unsigned char *) key.strkey;
 
   while (*s)
-    h += ((h << 7) + *s++);
-  h = (h * SOMEPRIME) % n;
+    h = (h ^ *s++) * FNV_PRIME;
 
-  return h;
+  return h % n;
 }
 
 /**
@@ -76,14 +87,13 @@ static int cmp_string_key(union HashKey a, union HashKey b)
  */
 static size_t gen_case_string_hash(union HashKey key, size_t n)
 {
-  size_t h = 0;
+  size_t h = FNV_OFFSET_BASIS;
   unsigned char *s = (unsigned char *) key.strkey;
 
   while (*s)
-    h += ((h << 7) + tolower(*s++));
-  h = (h * SOMEPRIME) % n;
+    h = (h ^ tolower(*s++)) * FNV_PRIME;
 
-  return h;
+  return h % n;
 }
 
 /**
@@ -127,17 +137,74 @@ static int cmp_int_key(union HashKey a, union HashKey b)
   return 1;
 }
 
+/**
+ * raw_string_hash - Generate a full-width hash from a string
+ * @param key String key
+ * @retval num Hash of the string, never 0
+ */
+static size_t raw_string_hash(union HashKey key)
+{
+  size_t h = FNV_OFFSET_BASIS;
+  unsigned char *s = (unsigned char *) key.strkey;
+
+  while (*s)
+    h = (h ^ *s++) * FNV_PRIME;
+
+  return h ? h : SOMEPRIME;
+}
+
+/**
+ * raw_case_string_hash - Generate a full-width hash from a string (ignore the case)
+ * @param key String key
+ * @retval num Hash of the string, never 0
+ */
+static size_t raw_case_string_hash(union HashKey key)
+{
+  size_t h = FNV_OFFSET_BASIS;
+  unsigned char *s = (unsigned char *) key.strkey;
+
+  while (*s)
+    h = (h ^ tolower(*s++)) * FNV_PRIME;
+
+  return h ? h : SOMEPRIME;
+}
+
+/**
+ * raw_int_hash - Generate a full-width hash from an integer
+ * @param key Integer key
+ * @retval num Hash of the integer, never 0
+ */
+static size_t raw_int_hash(union HashKey key)
+{
+  size_t h = key.intkey * (size_t) SOMEPRIME;
+
+  return h ? h : SOMEPRIME;
+}
+
 /**
  * new_hash - Create a new Hash table
- * @param nelem Number of elements it should contain
+ * @param nelem     Number of elements it should contain
+ * @param open_addr Use open addressing instead of chained buckets
  * @retval ptr New Hash table
  *
- * The Hash table can contain more elements than nelem, but they will be
- * chained together.
+ * A chained Hash table can contain more elements than nelem; an
+ * open-addressing one grows its slot array as needed.
  */
-static struct Hash *new_hash(size_t nelem)
+static struct Hash *new_hash(size_t nelem, bool open_addr)
 {
   struct Hash *table = mutt_mem_calloc(1, sizeof(struct Hash));
+  if (open_addr)
+  {
+    size_t cap = 16;
+    while (cap < nelem)
+      cap <<= 1;
+    table->open_addr = true;
+    table->capacity = cap;
+    table->nelem = cap;
+    table->slots = mutt_mem_calloc(cap, sizeof(struct HashElem));
+    table->hashes = mutt_mem_calloc(cap, sizeof(size_t));
+    return table;
+  }
   if (nelem == 0)
     nelem = 2;
   table->nelem = nelem;
@@ -145,6 +212,167 @@ static struct Hash *new_hash(size_t nelem)
   return table;
 }
 
+/**
+ * oa_grow - Double the slot array of an open-addressing Hash table
+ * @param table Hash table to grow
+ *
+ * Occupied slots are repositioned from their cached hashes, so the keys don't
+ * have to be hashed again.  All HashElem pointers are invalidated.
+ */
+static void oa_grow(struct Hash *table)
+{
+  const size_t oldcap = table->capacity;
+  struct HashElem *oldslots = table->slots;
+  size_t *oldhashes = table->hashes;
+
+  table->capacity = oldcap * 2;
+  table->nelem = table->capacity;
+  table->slots = mutt_mem_calloc(table->capacity, sizeof(struct HashElem));
+  table->hashes = mutt_mem_calloc(table->capacity, sizeof(size_t));
+
+  const size_t mask = table->capacity - 1;
+  for (size_t i = 0; i < oldcap; i++)
+  {
+    if (!oldhashes[i])
+      continue;
+    size_t j = oldhashes[i] & mask;
+    while (table->hashes[j])
+      j = (j + 1) & mask;
+    table->slots[j] = oldslots[i];
+    table->hashes[j] = oldhashes[i];
+  }
+
+  FREE(&oldslots);
+  FREE(&oldhashes);
+}
+
+/**
+ * oa_insert - Insert into an open-addressing Hash table
+ * @param table Hash table to update
+ * @param key   Key to hash on
+ * @param type  Data type
+ * @param data  Data to associate with key
+ * @retval ptr  Newly occupied slot, valid until the next insert or delete
+ * @retval NULL If the key is already present and duplicates aren't allowed
+ */
+static struct HashElem *oa_insert(struct Hash *table, union HashKey key, int type, void *data)
+{
+  /* keep the load factor below 3/4 so probe runs stay short */
+  if (((table->count + 1) * 4) > (table->capacity * 3))
+    oa_grow(table);
+
+  const size_t mask = table->capacity - 1;
+  const size_t h = table->raw_hash(key);
+  size_t i = h & mask;
+
+  while (table->hashes[i])
+  {
+    if (!table->allow_dups && (table->hashes[i] == h) &&
+        (table->cmp_key(table->slots[i].key, key) == 0))
+    {
+      return NULL;
+    }
+    i = (i + 1) & mask;
+  }
+
+  table->slots[i].key = key;
+  table->slots[i].data = data;
+  table->slots[i].type = type;
+  table->slots[i].next = NULL;
+  table->hashes[i] = h;
+  table->count++;
+  return &table->slots[i];
+}
+
+/**
+ * oa_find_elem - Find a slot in an open-addressing Hash table
+ * @param table Hash table to search
+ * @param key   Key (either string or integer)
+ * @retval ptr Slot matching the key
+ *
+ * The cached hash is compared before the key, so most mismatching slots are
+ * skipped without touching the key at all.
+ */
+static struct HashElem *oa_find_elem(const struct Hash *table, union HashKey key)
+{
+  if (table->count == 0)
+    return NULL;
+
+  const size_t mask = table->capacity - 1;
+  const size_t h = table->raw_hash(key);
+  size_t i = h & mask;
+
+  while (table->hashes[i])
+  {
+    if ((table->hashes[i] == h) && (table->cmp_key(key, table->slots[i].key) == 0))
+      return &table->slots[i];
+    i = (i + 1) & mask;
+  }
+  return NULL;
+}
+
+/**
+ * oa_delete - Remove elements from an open-addressing Hash table
+ * @param table Hash table to use
+ * @param key   Key (either string or integer)
+ * @param data  Private data to match (or NULL for any match)
+ *
+ * Holes are closed by shifting displaced entries backwards, so the table
+ * never accumulates tombstones.
+ */
+static void oa_delete(struct Hash *table, union HashKey key, const void *data)
+{
+  if (table->count == 0)
+    return;
+
+  const size_t mask = table->capacity - 1;
+  const size_t h = table->raw_hash(key);
+  bool again = true;
+
+  while (again)
+  {
+    again = false;
+    size_t i = h & mask;
+    while (table->hashes[i])
+    {
+      if ((table->hashes[i] == h) && (!data || data == table->slots[i].data) &&
+          (table->cmp_key(table->slots[i].key, key) == 0))
+      {
+        if (table->destroy)
+          table->destroy(table->slots[i].type, table->slots[i].data, table->dest_data);
+        if (table->strdup_keys)
+          FREE(&table->slots[i].key.strkey);
+        table->count--;
+
+        /* close the hole: pull back every entry probing across it */
+        size_t hole = i;
+        size_t j = i;
+        while (true)
+        {
+          j = (j + 1) & mask;
+          if (!table->hashes[j])
+            break;
+          const size_t home = table->hashes[j] & mask;
+          const bool movable = (hole <= j) ? ((home <= hole) || (home > j)) :
+                                             ((home <= hole) && (home > j));
+          if (movable)
+          {
+            table->slots[hole] = table->slots[j];
+            table->hashes[hole] = table->hashes[j];
+            hole = j;
+          }
+        }
+        table->hashes[hole] = 0;
+
+        /* the shift may have moved further matches before i, rescan */
+        again = true;
+        break;
+      }
+      i = (i + 1) & mask;
+    }
+  }
+}
+
 /**
  * union_hash_insert - Insert into a hash table using a union as a key
  * @param table Hash table to update
@@ -156,6 +384,9 @@ static struct Hash *new_hash(size_t nelem)
 static struct HashElem *union_hash_insert(struct Hash *table, union HashKey key,
                                           int type, void *data)
 {
+  if (table->open_addr)
+    return oa_insert(table, key, type, data);
+
   struct HashElem *ptr = mutt_mem_malloc(sizeof(struct HashElem));
   unsigned int h = table->gen_hash(key, table->nelem);
   ptr->key = key;
@@ -205,6 +436,9 @@ static struct HashElem *union_hash_find_elem(const struct Hash *table, union Has
   if (!table)
     return NULL;
 
+  if (table->open_addr)
+    return oa_find_elem(table, key);
+
   hash = table->gen_hash(key, table->nelem);
   ptr = table->table[hash];
   for (; ptr; ptr = ptr->next)
@@ -244,6 +478,12 @@ static void union_hash_delete(struct Hash *table, union HashKey key, const void
   if (!table)
     return;
 
+  if (table->open_addr)
+  {
+    oa_delete(table, key, data);
+    return;
+  }
+
   hash = table->gen_hash(key, table->nelem);
   ptr = table->table[hash];
   last = &table->table[hash];
@@ -277,16 +517,18 @@ static void union_hash_delete(struct Hash *table, union HashKey key, const void
  */
 struct Hash *mutt_hash_create(size_t nelem, int flags)
 {
-  struct Hash *table = new_hash(nelem);
+  struct Hash *table = new_hash(nelem, (flags & MUTT_HASH_OPEN_ADDR));
   if (flags & MUTT_HASH_STRCASECMP)
   {
     table->gen_hash = gen_case_string_hash;
     table->cmp_key = cmp_case_string_key;
+    table->raw_hash = raw_case_string_hash;
   }
   else
   {
     table->gen_hash = gen_string_hash;
     table->cmp_key = cmp_string_key;
+    table->raw_hash = raw_string_hash;
   }
   if (flags & MUTT_HASH_STRDUP_KEYS)
     table->strdup_keys = true;
@@ -303,9 +545,10 @@ struct Hash *mutt_hash_create(size_t nelem, int flags)
  */
 struct Hash *mutt_hash_int_create(size_t nelem, int flags)
 {
-  struct Hash *table = new_hash(nelem);
+  struct Hash *table = new_hash(nelem, (flags & MUTT_HASH_OPEN_ADDR));
   table->gen_hash = gen_int_hash;
   table->cmp_key = cmp_int_key;
+  table->raw_hash = raw_int_hash;
   if (flags & MUTT_HASH_ALLOW_DUPS)
     table->allow_dups = true;
   return table;
@@ -421,10 +664,55 @@ struct HashElem *mutt_hash_find_bucket(const struct Hash *table, const char *str
     return NULL;
 
   key.strkey = strkey;
+  if (table->open_addr)
+    return oa_find_elem(table, key);
   hash = table->gen_hash(key, table->nelem);
   return table->table[hash];
 }
 
+/**
+ * mutt_hash_find_next - Find another HashElem matching the same key
+ * @param table  Hash table to search
+ * @param strkey String key that elem was found with
+ * @param elem   HashElem returned by a previous find
+ * @retval ptr Next HashElem matching the key
+ * @retval NULL When there are no more matches
+ *
+ * Use with mutt_hash_find_elem() to visit every entry of a key in a table
+ * created with #MUTT_HASH_ALLOW_DUPS.
+ */
+struct HashElem *mutt_hash_find_next(const struct Hash *table,
+                                     const char *strkey, struct HashElem *elem)
+{
+  union HashKey key;
+
+  if (!table || !elem)
+    return NULL;
+
+  key.strkey = strkey;
+  if (table->open_addr)
+  {
+    const size_t mask = table->capacity - 1;
+    const size_t h = table->raw_hash(key);
+    size_t i = (((size_t)(elem - table->slots)) + 1) & mask;
+
+    while (table->hashes[i])
+    {
+      if ((table->hashes[i] == h) && (table->cmp_key(key, table->slots[i].key) == 0))
+        return &table->slots[i];
+      i = (i + 1) & mask;
+    }
+    return NULL;
+  }
+
+  for (struct HashElem *ptr = elem->next; ptr; ptr = ptr->next)
+  {
+    if (table->cmp_key(key, ptr->key) == 0)
+      return ptr;
+  }
+  return NULL;
+}
+
 /**
  * mutt_hash_delete - Remove an element from a Hash table
  * @param table   Hash table to use
@@ -464,6 +752,22 @@ void mutt_hash_destroy(struct Hash **ptr)
     return;
 
   pptr = *ptr;
+  if (pptr->open_addr)
+  {
+    for (size_t i = 0; i < pptr->capacity; i++)
+    {
+      if (!pptr->hashes[i])
+        continue;
+      if (pptr->destroy)
+        pptr->destroy(pptr->slots[i].type, pptr->slots[i].data, pptr->dest_data);
+      if (pptr->strdup_keys)
+        FREE(&pptr->slots[i].key.strkey);
+    }
+    FREE(&pptr->slots);
+    FREE(&pptr->hashes);
+    FREE(ptr);
+    return;
+  }
   for (size_t i = 0; i < pptr->nelem; i++)
   {
     for (elem = pptr->table[i]; elem;)
@@ -490,6 +794,24 @@ void mutt_hash_destroy(struct Hash **ptr)
  */
 struct HashElem *mutt_hash_walk(const struct Hash *table, struct HashWalkState *state)
 {
+  if (table->open_addr)
+  {
+    if (state->last)
+      state->index++;
+    while (state->index < table->capacity)
+    {
+      if (table->hashes[state->index])
+      {
+        state->last = &table->slots[state->index];
+        return state->last;
+      }
+      state->index++;
+    }
+    state->index = 0;
+    state->last = NULL;
+    return NULL;
+  }
+
   if (state->last && state->last->next)
   {
     state->last = state->last->next;
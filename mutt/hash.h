@@ -63,17 +63,27 @@ struct Hash
   size_t nelem;
   bool strdup_keys : 1; /**< if set, the key->strkey is strdup'ed */
   bool allow_dups  : 1; /**< if set, duplicate keys are allowed */
+  bool open_addr   : 1; /**< if set, elements live in one contiguous array */
   struct HashElem **table;
   size_t (*gen_hash)(union HashKey, size_t);
   int (*cmp_key)(union HashKey, union HashKey);
   hash_destructor_t destroy;
   intptr_t dest_data;
+  /* open-addressing storage, used instead of table when open_addr is set */
+  struct HashElem *slots; /**< contiguous element array, capacity entries */
+  size_t *hashes;         /**< cached key hash per slot, 0 means empty */
+  size_t capacity;        /**< number of slots, always a power of two */
+  size_t count;           /**< number of occupied slots */
+  size_t (*raw_hash)(union HashKey);
 };
 
 /* flags for mutt_hash_create() */
 #define MUTT_HASH_STRCASECMP  (1 << 0) /**< use strcasecmp() to compare keys */
 #define MUTT_HASH_STRDUP_KEYS (1 << 1) /**< make a copy of the keys */
 #define MUTT_HASH_ALLOW_DUPS  (1 << 2) /**< allow duplicate keys to be inserted */
+#define MUTT_HASH_OPEN_ADDR   (1 << 3) /**< store elements in one array, not chains.
+                                        *   HashElem pointers are only valid until
+                                        *   the next insert or delete */
 
 struct Hash *    mutt_hash_create(size_t nelem, int flags);
 void             mutt_hash_delete(struct Hash *table, const char *strkey, const void *data);
@@ -81,6 +91,7 @@ void             mutt_hash_destroy(struct Hash **ptr);
 void *           mutt_hash_find(const struct Hash *table, const char *strkey);
 struct HashElem *mutt_hash_find_bucket(const struct Hash *table, const char *strkey);
 struct HashElem *mutt_hash_find_elem(const struct Hash *table, const char *strkey);
+struct HashElem *mutt_hash_find_next(const struct Hash *table, const char *strkey, struct HashElem *elem);
 struct HashElem *mutt_hash_insert(struct Hash *table, const char *strkey, void *data);
 struct Hash *    mutt_hash_int_create(size_t nelem, int flags);
 void             mutt_hash_int_delete(struct Hash *table, unsigned int intkey, const void *data);
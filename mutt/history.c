@@ -201,6 +201,9 @@ static int dup_hash_inc(struct Hash *dup_hash, char *str)
 
 /**
  * shrink_histfile - Read, de-dupe and write the history file
+ *
+ * The file is read and parsed only once; if it needs regenerating, the
+ * surviving entries are written back out from memory.
  */
 static void shrink_histfile(void)
 {
@@ -211,6 +214,12 @@ static void shrink_histfile(void)
   size_t buflen;
   bool regen_file = false;
   struct Hash *dup_hashes[HC_LAST] = { 0 };
+  struct HistLine
+  {
+    int hclass;
+    char *str;
+  } *lines = NULL;
+  size_t num_lines = 0, max_lines = 0;
 
   FILE *f = fopen(HistoryFile, "r");
   if (!f)
@@ -233,6 +242,14 @@ static void shrink_histfile(void)
     if (hclass >= HC_LAST)
       continue;
     *p = '\0';
+    if (num_lines == max_lines)
+    {
+      max_lines += 256;
+      mutt_mem_realloc(&lines, max_lines * sizeof(*lines));
+    }
+    lines[num_lines].hclass = hclass;
+    lines[num_lines].str = mutt_str_strdup(linebuf + read);
+    num_lines++;
     if (HistoryRemoveDups && (dup_hash_inc(dup_hashes[hclass], linebuf + read) > 1))
     {
       regen_file = true;
@@ -261,32 +278,23 @@ static void shrink_histfile(void)
       mutt_perror(_("Can't create temporary file"));
       goto cleanup;
     }
-    rewind(f);
-    line = 0;
-    while ((linebuf = mutt_file_read_line(linebuf, &buflen, f, &line, 0)))
+    for (size_t i = 0; i < num_lines; i++)
     {
-      if (sscanf(linebuf, "%d:%n", &hclass, &read) < 1 || read == 0 ||
-          *(p = linebuf + strlen(linebuf) - 1) != '|' || hclass < 0)
-      {
-        mutt_error(_("Bad history file format (line %d)"), line);
-        goto cleanup;
-      }
-      if (hclass >= HC_LAST)
-        continue;
-      *p = '\0';
-      if (HistoryRemoveDups && (dup_hash_dec(dup_hashes[hclass], linebuf + read) > 0))
-      {
+      hclass = lines[i].hclass;
+      /* of each set of duplicates, keep only the last (newest) copy */
+      if (HistoryRemoveDups && (dup_hash_dec(dup_hashes[hclass], lines[i].str) > 0))
         continue;
-      }
-      *p = '|';
       if (n[hclass]-- <= SaveHistory)
-        fprintf(tmpfp, "%s\n", linebuf);
+        fprintf(tmpfp, "%d:%s|\n", hclass, lines[i].str);
     }
   }
 
 cleanup:
   mutt_file_fclose(&f);
   FREE(&linebuf);
+  for (size_t i = 0; i < num_lines; i++)
+    FREE(&lines[i].str);
+  FREE(&lines);
   if (tmpfp)
   {
     if ((fflush(tmpfp) == 0) && (f = fopen(HistoryFile, "w")))
@@ -326,18 +334,20 @@ static void save_history(enum HistoryClass hclass, const char *str)
   tmp = mutt_str_strdup(str);
   mutt_ch_convert_string(&tmp, Charset, "utf-8", 0);
 
-  /* Format of a history item (1 line): "<histclass>:<string>|".
-   * We add a '|' in order to avoid lines ending with '\'. */
-  fprintf(f, "%d:", (int) hclass);
+  /* Strip \n as a history item must fit on one line. The string shouldn't
+   * contain such a character anyway, but as this can happen in practice,
+   * we must deal with that. */
+  char *dst = tmp;
   for (char *p = tmp; *p; p++)
   {
-    /* Don't copy \n as a history item must fit on one line. The string
-     * shouldn't contain such a character anyway, but as this can happen
-     * in practice, we must deal with that. */
     if (*p != '\n')
-      putc((unsigned char) *p, f);
+      *dst++ = *p;
   }
-  fputs("|\n", f);
+  *dst = '\0';
+
+  /* Format of a history item (1 line): "<histclass>:<string>|".
+   * We add a '|' in order to avoid lines ending with '\'. */
+  fprintf(f, "%d:%s|\n", (int) hclass, tmp);
 
   mutt_file_fclose(&f);
   FREE(&tmp);
@@ -63,6 +63,12 @@ static struct LogList LogQueue = STAILQ_HEAD_INITIALIZER(LogQueue);
 int LogQueueCount = 0; /**< Number of entries currently in the log queue */
 int LogQueueMax = 0;   /**< Maximum number of entries in the log queue */
 
+#define TRACE_RING_SIZE 512 /**< Number of trace events kept before overwriting */
+
+static struct TraceEvent TraceRing[TRACE_RING_SIZE]; /**< Recent trace events */
+static int TraceNext = 0;         /**< Next slot in TraceRing to write */
+static bool TraceWrapped = false; /**< Has TraceRing overwritten old events? */
+
 /**
  * timestamp - Create a YYYY-MM-DD HH:MM:SS timestamp
  * @param stamp Unix time
@@ -99,6 +105,7 @@ void log_file_close(bool verbose)
   if (!LogFileFP)
     return;
 
+  log_trace_dump(LogFileFP);
   fprintf(LogFileFP, "[%s] Closing log.\n", timestamp(0));
   mutt_file_fclose(&LogFileFP);
   if (verbose)
@@ -128,7 +135,10 @@ int log_file_open(bool verbose)
   LogFileFP = mutt_file_fopen(LogFileName, "a+");
   if (!LogFileFP)
     return -1;
-  setvbuf(LogFileFP, NULL, _IOLBF, 0);
+  /* Fully buffered: at debug level 3+ a line-buffered log costs one write()
+   * per mutt_debug() call, which is slow enough to distort what's being
+   * debugged.  Errors are flushed explicitly by log_disp_file(). */
+  setvbuf(LogFileFP, NULL, _IOFBF, 65536);
 
   fprintf(LogFileFP, "[%s] NeoMutt%s debugging at level %d\n", timestamp(0),
           NONULL(LogFileVersion), LogFileLevel);
@@ -227,6 +237,82 @@ bool log_file_running(void)
   return LogFileFP;
 }
 
+/**
+ * log_trace_timestamp - Get a monotonic timestamp in nanoseconds
+ * @retval num Nanoseconds since an arbitrary starting point
+ *
+ * Only differences between timestamps are meaningful.
+ */
+unsigned long long log_trace_timestamp(void)
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    return (unsigned long long) ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+  return (unsigned long long) time(NULL) * 1000000000;
+}
+
+/**
+ * log_trace_add - Record an event in the trace ring buffer
+ * @param event Static description of the operation, e.g. "imap_exec: start"
+ *
+ * Recording an event costs one clock read and two stores, so tracing stays
+ * compiled in and enabled.  The ring keeps the last #TRACE_RING_SIZE events;
+ * older ones are silently overwritten.
+ *
+ * @note The string isn't copied, so it must outlive the ring buffer.
+ *       Pass a string literal.
+ */
+void log_trace_add(const char *event)
+{
+  struct TraceEvent *te = &TraceRing[TraceNext];
+
+  te->event = event;
+  te->nsec = log_trace_timestamp();
+
+  TraceNext++;
+  if (TraceNext == TRACE_RING_SIZE)
+  {
+    TraceNext = 0;
+    TraceWrapped = true;
+  }
+}
+
+/**
+ * log_trace_dump - Write the trace ring buffer to a file
+ * @param fp File handle
+ * @retval num Number of events written
+ *
+ * Events are printed oldest first, each with the time elapsed since the
+ * previous one, so slow operations stand out.  The ring isn't cleared,
+ * so the log file can be rotated to take repeated dumps.
+ */
+int log_trace_dump(FILE *fp)
+{
+  if (!fp)
+    return 0;
+
+  int count = TraceWrapped ? TRACE_RING_SIZE : TraceNext;
+  if (count == 0)
+    return 0;
+
+  int pos = TraceWrapped ? TraceNext : 0;
+  unsigned long long prev = TraceRing[pos].nsec;
+
+  fprintf(fp, "[%s] Trace of the last %d events:\n", timestamp(0), count);
+  for (int i = 0; i < count; i++)
+  {
+    struct TraceEvent *te = &TraceRing[pos];
+    unsigned long long delta = te->nsec - prev;
+    fprintf(fp, "    +%llu.%03llums %s\n", delta / 1000000, (delta / 1000) % 1000, te->event);
+    prev = te->nsec;
+    pos = (pos + 1) % TRACE_RING_SIZE;
+  }
+
+  return count;
+}
+
 /**
  * log_disp_file - Save a log line to a file
  * @param stamp    Unix time (optional)
@@ -278,6 +364,11 @@ int log_disp_file(time_t stamp, const char *file, int line,
     ret++;
   }
 
+  /* the log file is fully buffered; make sure errors hit the disk even if
+   * we crash before the buffer next fills */
+  if (level < LL_DEBUG1)
+    fflush(LogFileFP);
+
   return ret;
 }
 
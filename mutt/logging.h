@@ -82,6 +82,15 @@ struct LogLine
  */
 STAILQ_HEAD(LogList, LogLine);
 
+/**
+ * struct TraceEvent - An entry in the trace ring buffer
+ */
+struct TraceEvent
+{
+  const char *event;       /**< Static description of the operation */
+  unsigned long long nsec; /**< Monotonic timestamp, in nanoseconds */
+};
+
 #define mutt_debug(LEVEL, ...) MuttLogger(0, __FILE__, __LINE__, __func__, LEVEL,      __VA_ARGS__)
 #define mutt_warning(...)      MuttLogger(0, __FILE__, __LINE__, __func__, LL_WARNING, __VA_ARGS__)
 #define mutt_message(...)      MuttLogger(0, __FILE__, __LINE__, __func__, LL_MESSAGE, __VA_ARGS__)
@@ -105,4 +114,8 @@ int  log_file_set_filename(const char *file, bool verbose);
 int  log_file_set_level(int level, bool verbose);
 void log_file_set_version(const char *version);
 
+void log_trace_add(const char *event);
+int  log_trace_dump(FILE *fp);
+unsigned long long log_trace_timestamp(void);
+
 #endif /* MUTT_LIB_LOGGING_H */
@@ -41,6 +41,88 @@
 #include "regex3.h"
 #include "string2.h"
 
+/**
+ * struct RegexCached - A shared compiled regular expression
+ *
+ * Generated configs often repeat the same pattern fragment across many rules,
+ * so identical (pattern, flags) pairs share one compiled regex_t, counted by
+ * refcount.  Failed compilations are never cached.
+ */
+struct RegexCached
+{
+  char *pattern;             /**< pattern as given to regcomp() */
+  int flags;                 /**< flags it was compiled with */
+  short refcount;            /**< users sharing this entry */
+  regex_t *regex;            /**< the compiled expression */
+  struct RegexCached *next;  /**< linked list */
+};
+
+static struct RegexCached *RegexCache = NULL;
+
+/**
+ * mutt_regex_cache_compile - Compile a pattern, sharing previous results
+ * @param[in]  str   Regular expression
+ * @param[in]  flags Flags for REGCOMP(), e.g. REG_ICASE
+ * @param[out] err   regcomp() return code, 0 on success
+ * @retval ptr Compiled expression, possibly shared
+ *
+ * On failure the returned regex_t is not cached; the caller may regerror() it
+ * and must release it as usual.
+ *
+ * Release the result with mutt_regex_cache_release().
+ */
+regex_t *mutt_regex_cache_compile(const char *str, int flags, int *err)
+{
+  for (struct RegexCached *c = RegexCache; c; c = c->next)
+  {
+    if ((c->flags == flags) && (mutt_str_strcmp(c->pattern, str) == 0))
+    {
+      c->refcount++;
+      *err = 0;
+      return c->regex;
+    }
+  }
+
+  regex_t *preg = mutt_mem_calloc(1, sizeof(regex_t));
+  *err = REGCOMP(preg, str, flags);
+  if (*err != 0)
+    return preg;
+
+  struct RegexCached *c = mutt_mem_calloc(1, sizeof(struct RegexCached));
+  c->pattern = mutt_str_strdup(str);
+  c->flags = flags;
+  c->refcount = 1;
+  c->regex = preg;
+  c->next = RegexCache;
+  RegexCache = c;
+  return preg;
+}
+
+/**
+ * mutt_regex_cache_release - Drop a reference to a shared compiled expression
+ * @param regex Compiled expression from mutt_regex_cache_compile()
+ * @retval true  The expression belonged to the cache and has been handled
+ * @retval false Not a cached expression; the caller must free it itself
+ */
+bool mutt_regex_cache_release(regex_t *regex)
+{
+  for (struct RegexCached **c = &RegexCache; *c; c = &(*c)->next)
+  {
+    if ((*c)->regex != regex)
+      continue;
+    if (--(*c)->refcount > 0)
+      return true;
+    struct RegexCached *dead = *c;
+    *c = dead->next;
+    FREE(&dead->pattern);
+    regfree(dead->regex);
+    FREE(&dead->regex);
+    FREE(&dead);
+    return true;
+  }
+  return false;
+}
+
 /**
  * mutt_regex_compile - Create an Regex from a string
  * @param str   Regular expression
@@ -50,10 +132,11 @@
  */
 struct Regex *mutt_regex_compile(const char *str, int flags)
 {
+  int rc;
   struct Regex *r = mutt_mem_calloc(1, sizeof(struct Regex));
   r->pattern = mutt_str_strdup(str);
-  r->regex = mutt_mem_calloc(1, sizeof(regex_t));
-  if (REGCOMP(r->regex, NONULL(str), flags) != 0)
+  r->regex = mutt_regex_cache_compile(NONULL(str), flags, &rc);
+  if (rc != 0)
     mutt_regex_free(&r);
 
   return r;
@@ -75,7 +158,6 @@ struct Regex *mutt_regex_create(const char *str, int flags, struct Buffer *err)
   int rflags = 0;
   struct Regex *reg = mutt_mem_calloc(1, sizeof(struct Regex));
 
-  reg->regex = mutt_mem_calloc(1, sizeof(regex_t));
   reg->pattern = mutt_str_strdup(str);
 
   /* Should we use smart case matching? */
@@ -89,7 +171,8 @@ struct Regex *mutt_regex_create(const char *str, int flags, struct Buffer *err)
     str++;
   }
 
-  int rc = REGCOMP(reg->regex, str, rflags);
+  int rc;
+  reg->regex = mutt_regex_cache_compile(str, rflags, &rc);
   if ((rc != 0) && err)
   {
     regerror(rc, reg->regex, err->data, err->dsize);
@@ -110,9 +193,12 @@ void mutt_regex_free(struct Regex **r)
     return;
 
   FREE(&(*r)->pattern);
-  if ((*r)->regex)
+  if ((*r)->regex && !mutt_regex_cache_release((*r)->regex))
+  {
+    /* not shared, e.g. a failed compilation */
     regfree((*r)->regex);
-  FREE(&(*r)->regex);
+    FREE(&(*r)->regex);
+  }
   FREE(r);
 }
 
@@ -248,6 +334,167 @@ int mutt_regexlist_remove(struct RegexList *rl, const char *str)
   return rc;
 }
 
+/**
+ * skip_bracket_exp - Step over a regex bracket expression
+ * @param p Start of the expression (the '[')
+ * @retval ptr  The closing ']'
+ * @retval NULL The expression is unterminated
+ *
+ * Handles a leading '^', a ']' in first position and [:...:], [=...=] and
+ * [.....] elements, whose embedded ']' does not close the expression.
+ */
+static const char *skip_bracket_exp(const char *p)
+{
+  p++;
+  if (*p == '^')
+    p++;
+  if (*p == ']')
+    p++;
+  while (*p && (*p != ']'))
+  {
+    if ((*p == '[') && ((p[1] == ':') || (p[1] == '=') || (p[1] == '.')))
+    {
+      const char term = p[1];
+      p += 2;
+      while (*p && !((*p == term) && (p[1] == ']')))
+        p++;
+      if (!*p)
+        return NULL;
+      p += 2;
+    }
+    else
+      p++;
+  }
+  return *p ? p : NULL;
+}
+
+/**
+ * mutt_regex_required_literal - Extract a literal that a regex match must contain
+ * @param pat Extended regular expression
+ * @retval ptr  Newly allocated literal substring
+ * @retval NULL No usable literal could be derived
+ *
+ * Find the longest run of ordinary characters that every match of the
+ * expression must contain, so callers can reject most candidate strings
+ * with a cheap substring search before paying for regexec().
+ * The scan is deliberately conservative: alternation, escapes that might be
+ * engine extensions, non-ASCII bytes and anything else it does not fully
+ * understand end the current run (or void the whole pattern) rather than
+ * risk a prefilter that rejects a matching string.
+ */
+char *mutt_regex_required_literal(const char *pat)
+{
+  char best[STRING] = { 0 };
+  char run[STRING] = { 0 };
+  size_t best_len = 0;
+  size_t run_len = 0;
+
+  for (const char *p = pat; *p; p++)
+  {
+    char lit = 0; /* the literal this element contributes, if any */
+
+    if (*p == '|')
+      return NULL; /* top-level alternation: nothing at all is required */
+
+    if (*p == '(')
+    {
+      /* a group may alternate or nest; treat its contents as unknown */
+      int depth = 1;
+      for (p++; *p && (depth != 0); p++)
+      {
+        if ((*p == '\\') && p[1])
+          p++;
+        else if (*p == '[')
+        {
+          /* bracket expressions may hold unbalanced parens */
+          p = skip_bracket_exp(p);
+          if (!p)
+            return NULL;
+        }
+        else if (*p == '(')
+          depth++;
+        else if (*p == ')')
+          depth--;
+      }
+      if (depth != 0)
+        return NULL; /* unbalanced; give up rather than guess */
+      p--;
+    }
+    else if (*p == '[')
+    {
+      p = skip_bracket_exp(p);
+      if (!p)
+        return NULL;
+    }
+    else if (*p == '\\')
+    {
+      p++;
+      if (!*p)
+        return NULL;
+      /* only escapes of regex metacharacters are certainly literal; \< \b
+       * and friends are assertions on some engines */
+      if (strchr(".*+?()[]{}|^$\\", *p))
+        lit = *p;
+    }
+    else if ((*p == '.') || (*p == '^') || (*p == '$') || (*p == ')'))
+    {
+      /* matches anything, an anchor, or a stray close paren: not literal */
+    }
+    else if ((unsigned char) *p >= 0x80)
+    {
+      /* a quantifier after a multibyte char applies to all its bytes;
+       * too fiddly to track, so don't treat any of them as required */
+    }
+    else
+      lit = *p;
+
+    /* a following ? or * (or brace repeat, which may allow zero) makes
+     * this element optional; + keeps one copy but breaks contiguity */
+    char next = p[1];
+    if ((next == '?') || (next == '*') || (next == '{'))
+    {
+      lit = 0;
+      p++;
+      if (next == '{')
+      {
+        while (*p && (*p != '}'))
+          p++;
+        if (!*p)
+          return NULL;
+      }
+    }
+
+    if (lit && (run_len < sizeof(run) - 1))
+      run[run_len++] = lit;
+
+    if (!lit || (next == '+'))
+    {
+      if (next == '+')
+        p++;
+      if (run_len > best_len)
+      {
+        run[run_len] = '\0';
+        mutt_str_strfcpy(best, run, sizeof(best));
+        best_len = run_len;
+      }
+      run_len = 0;
+    }
+  }
+
+  if (run_len > best_len)
+  {
+    run[run_len] = '\0';
+    mutt_str_strfcpy(best, run, sizeof(best));
+    best_len = run_len;
+  }
+
+  /* a one-byte needle prunes too little to be worth the extra scan */
+  if (best_len < 2)
+    return NULL;
+
+  return mutt_str_strdup(best);
+}
+
 /**
  * mutt_replacelist_add - Add a pattern and a template to a list
  * @param rl    ReplaceList to add to
@@ -304,6 +551,8 @@ int mutt_replacelist_add(struct ReplaceList *rl, const char *pat,
 
   /* Now np is the ReplaceListNode that we want to modify. It is prepared. */
   np->template = mutt_str_strdup(templ);
+  FREE(&np->literal);
+  np->literal = mutt_regex_required_literal(np->regex->pattern);
 
   /* Find highest match number in template string */
   np->nmatch = 0;
@@ -452,6 +701,7 @@ void mutt_replacelist_free(struct ReplaceList *rl)
     STAILQ_REMOVE(rl, np, ReplaceListNode, entries);
     mutt_regex_free(&np->regex);
     FREE(&np->template);
+    FREE(&np->literal);
     FREE(&np);
   }
 }
@@ -482,6 +732,10 @@ bool mutt_replacelist_match(struct ReplaceList *rl, char *buf, size_t buflen, co
   struct ReplaceListNode *np = NULL;
   STAILQ_FOREACH(np, rl, entries)
   {
+    /* Cheap prefilter: every match must contain the literal substring */
+    if (np->literal && !strcasestr(str, np->literal))
+      continue;
+
     /* If this pattern needs more matches, expand pmatch. */
     if (np->nmatch > nmatch)
     {
@@ -572,6 +826,7 @@ int mutt_replacelist_remove(struct ReplaceList *rl, const char *pat)
       STAILQ_REMOVE(rl, np, ReplaceListNode, entries);
       mutt_regex_free(&np->regex);
       FREE(&np->template);
+      FREE(&np->literal);
       FREE(&np);
       nremoved++;
     }
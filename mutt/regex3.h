@@ -80,13 +80,18 @@ struct ReplaceListNode
   struct Regex *regex;      /**< Regex containing a regular expression */
   size_t nmatch;            /**< Match the 'nth' occurrence (0 means the whole expression) */
   char *template;           /**< Template to match */
+  char *literal;            /**< Substring every match must contain, or NULL */
   STAILQ_ENTRY(ReplaceListNode) entries; /**< Next item in list */
 };
 STAILQ_HEAD(ReplaceList, ReplaceListNode);
 
+regex_t *mutt_regex_cache_compile(const char *str, int flags, int *err);
+bool     mutt_regex_cache_release(regex_t *regex);
+
 struct Regex *mutt_regex_compile(const char *str, int flags);
 struct Regex *mutt_regex_create(const char *str, int flags, struct Buffer *err);
 void          mutt_regex_free(struct Regex **r);
+char *        mutt_regex_required_literal(const char *pat);
 
 int                   mutt_regexlist_add(struct RegexList *rl, const char *str, int flags, struct Buffer *err);
 void                  mutt_regexlist_free(struct RegexList *rl);
@@ -590,6 +590,74 @@ int mutt_str_strncasecmp(const char *a, const char *b, size_t l)
   return strncasecmp(NONULL(a), NONULL(b), l);
 }
 
+/**
+ * ascii_tolower - Lowercase an ASCII letter, ignoring the locale
+ * @param c Character to lowercase
+ * @retval num Lowercased character
+ */
+static inline int ascii_tolower(int c)
+{
+  if ((c >= 'A') && (c <= 'Z'))
+    c += 'a' - 'A';
+  return c;
+}
+
+/**
+ * mutt_str_ascii_strcasecmp - Compare two ASCII strings ignoring case, safely
+ * @param a First string to compare
+ * @param b Second string to compare
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ *
+ * For protocol tokens (header field names, MIME types, IMAP atoms) which are
+ * ASCII by specification.  Unlike strcasecmp(), the result doesn't depend on
+ * the user's locale (e.g. a Turkish locale folds 'I' outside a-z/A-Z), and
+ * the short token compares skip the locale table indirection entirely.
+ */
+int mutt_str_ascii_strcasecmp(const char *a, const char *b)
+{
+  a = NONULL(a);
+  b = NONULL(b);
+
+  for (;; a++, b++)
+  {
+    const int cmp = ascii_tolower((unsigned char) *a) - ascii_tolower((unsigned char) *b);
+    if (cmp != 0)
+      return (cmp > 0) ? 1 : -1;
+    if (*a == '\0')
+      return 0;
+  }
+}
+
+/**
+ * mutt_str_ascii_strncasecmp - Compare two ASCII strings ignoring case (to a maximum), safely
+ * @param a First string to compare
+ * @param b Second string to compare
+ * @param l Maximum number of bytes to compare
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ *
+ * See mutt_str_ascii_strcasecmp() for when to prefer this over
+ * mutt_str_strncasecmp().
+ */
+int mutt_str_ascii_strncasecmp(const char *a, const char *b, size_t l)
+{
+  a = NONULL(a);
+  b = NONULL(b);
+
+  for (size_t i = 0; i < l; i++, a++, b++)
+  {
+    const int cmp = ascii_tolower((unsigned char) *a) - ascii_tolower((unsigned char) *b);
+    if (cmp != 0)
+      return (cmp > 0) ? 1 : -1;
+    if (*a == '\0')
+      return 0;
+  }
+  return 0;
+}
+
 /**
  * mutt_str_strlen - Calculate the length of a string, safely
  * @param a String to measure
@@ -29,6 +29,7 @@
 #include "config.h"
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "mutt/mutt.h"
 #include "email/lib.h"
 #include "conn/conn.h"
@@ -336,6 +337,62 @@ void mutt_account_unsetpass(struct ConnAccount *account)
   account->flags &= ~MUTT_ACCT_PASS;
 }
 
+/**
+ * struct OauthEntry - Cached OAUTHBEARER token for one account
+ */
+struct OauthEntry
+{
+  unsigned char type;      /**< account type, e.g. #MUTT_ACCT_TYPE_IMAP */
+  unsigned short port;
+  char host[128];
+  char login[64];
+  char *token;             /**< base64-encoded OAUTHBEARER token */
+  time_t expiry;           /**< when to stop trusting the cached token */
+  struct OauthEntry *next;
+};
+
+static struct OauthEntry *OauthCache = NULL;
+
+/* Access tokens are typically valid for an hour; re-run the refresh command
+ * well before that so a token never expires mid-session, while reconnects
+ * and additional connections to the same account skip the helper. */
+#define OAUTH_TOKEN_TTL 600
+
+/**
+ * oauth_entry_find - Find the cached token entry for an account
+ * @param account Account to look up
+ * @retval ptr Matching entry
+ * @retval NULL No entry for this account
+ */
+static struct OauthEntry *oauth_entry_find(const struct ConnAccount *account)
+{
+  for (struct OauthEntry *e = OauthCache; e; e = e->next)
+  {
+    if ((e->type == account->type) && (e->port == account->port) &&
+        (mutt_str_strcasecmp(e->host, account->host) == 0) &&
+        (mutt_str_strcmp(e->login, account->login) == 0))
+    {
+      return e;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * mutt_account_forget_oauthbearer - Drop an account's cached OAUTHBEARER token
+ * @param account Account whose token failed
+ *
+ * Called by the auth methods when the server rejects the token (e.g. revoked
+ * before our conservative expiry), so the next attempt re-runs the refresh
+ * command instead of replaying the rejected token until it ages out.
+ */
+void mutt_account_forget_oauthbearer(struct ConnAccount *account)
+{
+  struct OauthEntry *e = oauth_entry_find(account);
+  if (e)
+    e->expiry = 0;
+}
+
 /**
  * mutt_account_getoauthbearer - Get an OAUTHBEARER token
  * @param account Account to use
@@ -343,7 +400,10 @@ void mutt_account_unsetpass(struct ConnAccount *account)
  * @retval NULL Error
  *
  * Run an external command to generate the oauth refresh token for an account,
- * then create and encode the OAUTHBEARER token based on RFC7628.
+ * then create and encode the OAUTHBEARER token based on RFC7628.  The result
+ * is cached per account for #OAUTH_TOKEN_TTL seconds, since the refresh
+ * command is an exec of an external helper and reconnects shouldn't block on
+ * it.
  *
  * @note Caller should free the token
  */
@@ -363,6 +423,10 @@ char *mutt_account_getoauthbearer(struct ConnAccount *account)
   if (mutt_account_getlogin(account))
     return NULL;
 
+  struct OauthEntry *cached = oauth_entry_find(account);
+  if (cached && cached->token && (cached->expiry > time(NULL)))
+    return mutt_str_strdup(cached->token);
+
 #ifdef USE_IMAP
   if ((account->type == MUTT_ACCT_TYPE_IMAP) && ImapOauthRefreshCmd)
     cmd = ImapOauthRefreshCmd;
@@ -413,5 +477,19 @@ char *mutt_account_getoauthbearer(struct ConnAccount *account)
   encoded_token = mutt_mem_malloc(encoded_len);
   mutt_b64_encode(oauthbearer, strlen(oauthbearer), encoded_token, encoded_len);
   FREE(&oauthbearer);
+
+  if (!cached)
+  {
+    cached = mutt_mem_calloc(1, sizeof(struct OauthEntry));
+    cached->type = account->type;
+    cached->port = account->port;
+    mutt_str_strfcpy(cached->host, account->host, sizeof(cached->host));
+    mutt_str_strfcpy(cached->login, account->login, sizeof(cached->login));
+    cached->next = OauthCache;
+    OauthCache = cached;
+  }
+  mutt_str_replace(&cached->token, encoded_token);
+  cached->expiry = time(NULL) + OAUTH_TOKEN_TTL;
+
   return encoded_token;
 }
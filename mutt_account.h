@@ -67,5 +67,6 @@ int mutt_account_getlogin(struct ConnAccount *account);
 int mutt_account_getpass(struct ConnAccount *account);
 void mutt_account_unsetpass(struct ConnAccount *account);
 char *mutt_account_getoauthbearer(struct ConnAccount *account);
+void  mutt_account_forget_oauthbearer(struct ConnAccount *account);
 
 #endif /* MUTT_MUTT_ACCOUNT_H */
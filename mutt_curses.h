@@ -180,6 +180,10 @@ struct ColorLine
   regex_t regex;
   int match; /**< which substringmap 0 for old behaviour */
   char *pattern;
+  char *prefilter;      /**< literal every match must contain, or NULL.
+                             Lets the pager skip regexec() on lines that
+                             can't possibly match */
+  bool prefilter_icase; /**< prefilter must be searched case-insensitively */
   struct Pattern *color_pattern; /**< compiled pattern to speed up index color
                                       calculation */
   short fg;
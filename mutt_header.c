@@ -272,12 +272,12 @@ void mutt_edit_headers(const char *editor, const char *body, struct Email *msg,
          (mutt_str_strcmp(STAILQ_FIRST(&n->in_reply_to)->data,
                           STAILQ_FIRST(&msg->env->in_reply_to)->data) != 0)))
     {
-      mutt_list_free(&msg->env->references);
+      mutt_env_release_idlist(&msg->env->references);
     }
   }
 
   /* restore old info. */
-  mutt_list_free(&n->references);
+  mutt_env_release_idlist(&n->references);
   STAILQ_SWAP(&n->references, &msg->env->references, ListNode);
 
   mutt_env_free(&msg->env);
@@ -33,6 +33,7 @@
 #include "mutt_thread.h"
 #include "context.h"
 #include "curs_lib.h"
+#include "globals.h"
 #include "mailbox.h"
 #include "mx.h"
 #include "protos.h"
@@ -179,9 +180,10 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
     tree->subtree_visible = 0;
     if (tree->message)
     {
-      FREE(&tree->message->tree);
       if (is_visible(tree->message, ctx))
       {
+        /* the old tree string is kept for now; mutt_draw_tree() will reuse
+         * it if the drawing for this message hasn't changed */
         tree->deep = true;
         tree->visible = true;
         tree->message->display_subject = need_display_subject(ctx, tree->message);
@@ -199,6 +201,7 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
       }
       else
       {
+        FREE(&tree->message->tree);
         tree->visible = false;
         tree->deep = !HideLimited;
       }
@@ -275,7 +278,7 @@ static void calculate_visibility(struct Context *ctx, int *max_depth)
  */
 void mutt_draw_tree(struct Context *ctx)
 {
-  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *new_tree = NULL;
+  char *pfx = NULL, *mypfx = NULL, *arrow = NULL, *myarrow = NULL, *scratch = NULL;
   char corner = (Sort & SORT_REVERSE) ? MUTT_TREE_ULCORNER : MUTT_TREE_LLCORNER;
   char vtee = (Sort & SORT_REVERSE) ? MUTT_TREE_BTEE : MUTT_TREE_TTEE;
   int depth = 0, start_depth = 0, max_depth = 0, width = NarrowTree ? 1 : 2;
@@ -287,6 +290,7 @@ void mutt_draw_tree(struct Context *ctx)
   calculate_visibility(ctx, &max_depth);
   pfx = mutt_mem_malloc(width * max_depth + 2);
   arrow = mutt_mem_malloc(width * max_depth + 2);
+  scratch = mutt_mem_malloc(width * max_depth + 2);
   while (tree)
   {
     if (depth)
@@ -309,18 +313,27 @@ void mutt_draw_tree(struct Context *ctx)
       {
         myarrow[width] = MUTT_TREE_RARROW;
         myarrow[width + 1] = 0;
-        new_tree = mutt_mem_malloc((2 + depth * width));
+        /* compose into the scratch buffer and only replace the message's
+         * string if the drawing actually changed; on a resort most subtrees
+         * come out identical, so this saves a free/strdup per message */
         if (start_depth > 1)
         {
-          strncpy(new_tree, pfx, (start_depth - 1) * width);
-          mutt_str_strfcpy(new_tree + (start_depth - 1) * width, arrow,
+          strncpy(scratch, pfx, (start_depth - 1) * width);
+          mutt_str_strfcpy(scratch + (start_depth - 1) * width, arrow,
                            (1 + depth - start_depth) * width + 2);
         }
         else
-          mutt_str_strfcpy(new_tree, arrow, 2 + depth * width);
-        tree->message->tree = new_tree;
+          mutt_str_strfcpy(scratch, arrow, 2 + depth * width);
+        if (mutt_str_strcmp(scratch, tree->message->tree) != 0)
+          mutt_str_replace(&tree->message->tree, scratch);
       }
     }
+    else if (tree->message)
+    {
+      /* root messages have no tree drawing; drop any leftover from a
+       * previous threading */
+      FREE(&tree->message->tree);
+    }
     if (tree->child && depth)
     {
       mypfx = pfx + (depth - 1) * width;
@@ -384,6 +397,7 @@ void mutt_draw_tree(struct Context *ctx)
 
   FREE(&pfx);
   FREE(&arrow);
+  FREE(&scratch);
 }
 
 /**
@@ -462,7 +476,8 @@ static struct MuttThread *find_subject(struct Context *ctx, struct MuttThread *c
   struct ListNode *np = NULL;
   STAILQ_FOREACH(np, &subjects, entries)
   {
-    for (ptr = mutt_hash_find_bucket(ctx->mailbox->subj_hash, np->data); ptr; ptr = ptr->next)
+    for (ptr = mutt_hash_find_elem(ctx->mailbox->subj_hash, np->data); ptr;
+         ptr = mutt_hash_find_next(ctx->mailbox->subj_hash, np->data, ptr))
     {
       tmp = ((struct Email *) ptr->data)->thread;
       if (tmp != cur &&                    /* don't match the same message */
@@ -491,7 +506,8 @@ static struct MuttThread *find_subject(struct Context *ctx, struct MuttThread *c
  */
 static struct Hash *make_subj_hash(struct Context *ctx)
 {
-  struct Hash *hash = mutt_hash_create(ctx->mailbox->msg_count * 2, MUTT_HASH_ALLOW_DUPS);
+  struct Hash *hash = mutt_hash_create(ctx->mailbox->msg_count * 2,
+                                       MUTT_HASH_ALLOW_DUPS | MUTT_HASH_OPEN_ADDR);
 
   for (int i = 0; i < ctx->mailbox->msg_count; i++)
   {
@@ -819,7 +835,8 @@ void mutt_sort_threads(struct Context *ctx, bool init)
 
   if (init)
   {
-    ctx->thread_hash = mutt_hash_create(ctx->mailbox->msg_count * 2, MUTT_HASH_ALLOW_DUPS);
+    ctx->thread_hash = mutt_hash_create(ctx->mailbox->msg_count * 2,
+                                        MUTT_HASH_ALLOW_DUPS | MUTT_HASH_OPEN_ADDR);
     mutt_hash_set_destructor(ctx->thread_hash, thread_hash_destructor, 0);
   }
 
@@ -910,10 +927,12 @@ void mutt_sort_threads(struct Context *ctx, bool init)
         }
       }
     }
-    else
+    else if (!StrictThreads)
     {
       /* unlink pseudo-threads because they might be children of newly
-       * arrived messages */
+       * arrived messages.  They can only exist when $strict_threads is
+       * unset; toggling it forces a full rebuild, so it's safe to skip
+       * this scan entirely otherwise. */
       thread = cur->thread;
       for (new = thread->child; new;)
       {
@@ -1146,6 +1165,65 @@ int mutt_parent_message(struct Context *ctx, struct Email *e, bool find_root)
   return parent->virtual;
 }
 
+/**
+ * thread_update_num_hidden - Set num_hidden on every message of one thread
+ * @param ctx Mailbox
+ * @param top Top-level thread node
+ *
+ * num_hidden is a property of the whole thread: mutt_get_hidden() walks up to
+ * the root before counting, so every message of a thread carries the same
+ * value.  Computing it per visible message made mutt_set_virtual() quadratic
+ * in the thread size; one pass to count and one to assign keeps it linear.
+ */
+static void thread_update_num_hidden(struct Context *ctx, struct MuttThread *top)
+{
+  struct MuttThread *thread = NULL;
+  struct Email *cur = NULL;
+  int num_hidden = 0;
+
+  for (thread = top; thread;)
+  {
+    cur = thread->message;
+    if (cur && (cur->virtual == -1) && (!ctx->pattern || cur->limited))
+      num_hidden++;
+
+    if (thread->child)
+      thread = thread->child;
+    else
+    {
+      while ((thread != top) && !thread->next)
+        thread = thread->parent;
+      if (thread == top)
+        break;
+      thread = thread->next;
+    }
+  }
+
+  /* mutt_get_hidden() counts the root in for multi-message threads */
+  thread = top;
+  while (!thread->message)
+    thread = thread->child;
+  if ((thread != top) || top->child)
+    num_hidden++;
+
+  for (thread = top; thread;)
+  {
+    if (thread->message)
+      thread->message->num_hidden = num_hidden;
+
+    if (thread->child)
+      thread = thread->child;
+    else
+    {
+      while ((thread != top) && !thread->next)
+        thread = thread->parent;
+      if (thread == top)
+        break;
+      thread = thread->next;
+    }
+  }
+}
+
 /**
  * mutt_set_virtual - Set the virtual index number of all the messages in a mailbox
  * @param ctx Mailbox
@@ -1153,6 +1231,7 @@ int mutt_parent_message(struct Context *ctx, struct Email *e, bool find_root)
 void mutt_set_virtual(struct Context *ctx)
 {
   struct Email *cur = NULL;
+  const bool threaded = (((Sort & SORT_MASK) == SORT_THREADS) && ctx->tree);
 
   ctx->mailbox->vcount = 0;
   ctx->vsize = 0;
@@ -1168,9 +1247,16 @@ void mutt_set_virtual(struct Context *ctx)
       ctx->mailbox->vcount++;
       ctx->vsize += cur->content->length + cur->content->offset -
                     cur->content->hdr_offset + padding;
-      cur->num_hidden = mutt_get_hidden(ctx, cur);
+      if (!threaded)
+        cur->num_hidden = mutt_get_hidden(ctx, cur);
     }
   }
+
+  if (threaded)
+  {
+    for (struct MuttThread *top = ctx->tree; top; top = top->next)
+      thread_update_num_hidden(ctx, top);
+  }
 }
 
 /**
@@ -1196,6 +1282,10 @@ int mutt_traverse_thread(struct Context *ctx, struct Email *cur, int flag)
     return cur->virtual;
   }
 
+  /* collapsing changes %M and collapse markers in the rendered lines */
+  if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
+    IndexLineGen++;
+
   final = cur->virtual;
   thread = cur->thread;
   while (thread->parent)
@@ -1396,7 +1486,7 @@ int mutt_messages_in_thread(struct Context *ctx, struct Email *e, int flag)
  */
 struct Hash *mutt_make_id_hash(struct Mailbox *mailbox)
 {
-  struct Hash *hash = mutt_hash_create(mailbox->msg_count * 2, 0);
+  struct Hash *hash = mutt_hash_create(mailbox->msg_count * 2, MUTT_HASH_OPEN_ADDR);
 
   for (int i = 0; i < mailbox->msg_count; i++)
   {
@@ -1421,7 +1511,8 @@ static bool link_threads(struct Email *parent, struct Email *child, struct Conte
     return false;
 
   mutt_break_thread(child);
-  mutt_list_insert_head(&child->env->in_reply_to, mutt_str_strdup(parent->env->message_id));
+  mutt_list_insert_head(&child->env->in_reply_to,
+                        mutt_env_intern_id(mutt_str_strdup(parent->env->message_id)));
   mutt_set_flag(ctx, child, MUTT_TAG, 0);
 
   child->env->irt_changed = true;
@@ -286,6 +286,12 @@ char *mutt_expand_path_regex(char *buf, size_t buflen, bool regex)
       }
     }
 
+    /* no shortcut matched: the expansion is the input itself.  The mailbox
+     * check and browser loops re-expand already-expanded paths every cycle,
+     * so skip the round trip through tmp for them */
+    if ((*p == '\0') && (tail == buf))
+      break;
+
     if (regex && *p && !recurse)
     {
       mutt_file_sanitize_regex(q, sizeof(q), p);
@@ -753,6 +759,27 @@ void mutt_safe_path(char *buf, size_t buflen, struct Address *a)
       *p = '_';
 }
 
+/**
+ * expando_strwidth - Measure the display width of an expanded expando
+ * @param s String to measure
+ * @retval num Width in screen columns
+ *
+ * Most expansions (dates, counters, flags, ascii names) contain only
+ * printable ASCII, where the width simply equals the length.  Only fall back
+ * to the mbrtowc() walk in mutt_strwidth() when that's not the case.  This
+ * runs for every %-expando of every index row on every redraw, so the short
+ * cut is worth it.
+ */
+static int expando_strwidth(const char *s)
+{
+  const unsigned char *p = (const unsigned char *) s;
+
+  for (; *p; p++)
+    if ((*p < 0x20) || (*p > 0x7e))
+      return mutt_strwidth(s);
+  return p - (const unsigned char *) s;
+}
+
 /**
  * mutt_expando_format - Expand expandos (%x) in a string
  * @param[out] buf      Buffer in which to save string
@@ -809,10 +836,11 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
       srccopy[n - 1] = '\0';
 
       /* prepare BUFFERs */
-      struct Buffer *srcbuf = mutt_buffer_from(srccopy);
+      struct Buffer *srcbuf = mutt_buffer_pool_get();
+      mutt_buffer_addstr(srcbuf, srccopy);
       srcbuf->dptr = srcbuf->data;
-      struct Buffer *word = mutt_buffer_new();
-      struct Buffer *command = mutt_buffer_new();
+      struct Buffer *word = mutt_buffer_pool_get();
+      struct Buffer *command = mutt_buffer_pool_get();
 
       /* Iterate expansions across successive arguments */
       do
@@ -903,9 +931,9 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
         *wptr = '\0';
       }
 
-      mutt_buffer_free(&command);
-      mutt_buffer_free(&srcbuf);
-      mutt_buffer_free(&word);
+      mutt_buffer_pool_release(&command);
+      mutt_buffer_pool_release(&srcbuf);
+      mutt_buffer_pool_release(&word);
       return;
     }
   }
@@ -1096,7 +1124,7 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
           /* get contents after padding */
           mutt_expando_format(tmp, sizeof(tmp), 0, cols, src + pl, callback, data, flags);
           len = mutt_str_strlen(tmp);
-          wid = mutt_strwidth(tmp);
+          wid = expando_strwidth(tmp);
 
           pad = (cols - col - wid) / pw;
           if (pad >= 0)
@@ -1215,7 +1243,7 @@ void mutt_expando_format(char *buf, size_t buflen, size_t col, int cols, const c
         memcpy(wptr, tmp, len);
         wptr += len;
         wlen += len;
-        col += mutt_strwidth(tmp);
+        col += expando_strwidth(tmp);
       }
     }
     else if (*src == '\\')
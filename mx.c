@@ -310,7 +310,12 @@ struct Context *mx_mbox_open(const char *path, int flags)
   if (!ctx->mailbox->quiet)
     mutt_message(_("Reading %s..."), ctx->mailbox->path);
 
+  log_trace_add("mx_mbox_open: read");
+  ctx->mailbox->open_rtt = 0;
+  unsigned long long t0 = log_trace_timestamp();
   rc = ctx->mailbox->mx_ops->mbox_open(ctx);
+  ctx->mailbox->open_parse_ms = (log_trace_timestamp() - t0) / 1000000;
+  log_trace_add("mx_mbox_open: parsed");
 
   if ((rc == 0) || (rc == -2))
   {
@@ -320,7 +325,10 @@ struct Context *mx_mbox_open(const char *path, int flags)
          to begin with */
       OptSortSubthreads = false;
       OptNeedRescore = false;
+      t0 = log_trace_timestamp();
       mutt_sort_headers(ctx, true);
+      ctx->mailbox->open_sort_ms = (log_trace_timestamp() - t0) / 1000000;
+      log_trace_add("mx_mbox_open: sorted");
     }
     if (!ctx->mailbox->quiet)
       mutt_clear_error();
@@ -456,6 +464,15 @@ static int trash_append(struct Context *ctx)
   }
 #endif
 
+  /* maildir to maildir on the same filesystem: hardlink instead of copying,
+   * the expunge below removes the originals */
+  if ((ctx->mailbox->magic == MUTT_MAILDIR) &&
+      (mx_path_probe(Trash, NULL) == MUTT_MAILDIR))
+  {
+    if (maildir_fast_trash(ctx->mailbox, Trash) == 0)
+      return 0;
+  }
+
   struct Context *ctx_trash = mx_mbox_open(Trash, MUTT_APPEND);
   if (ctx_trash)
   {
@@ -776,6 +793,9 @@ void mx_update_tables(struct Context *ctx, bool committing)
 {
   int i, j, padding;
 
+  /* messages are renumbered below, so cached index lines go stale */
+  IndexLineGen++;
+
   /* update memory to reflect the new state of the mailbox */
   ctx->mailbox->vcount = 0;
   ctx->vsize = 0;
@@ -1152,20 +1172,25 @@ void mx_alloc_memory(struct Mailbox *mailbox)
 {
   size_t s = MAX(sizeof(struct Email *), sizeof(int));
 
-  if ((mailbox->hdrmax + 25) * s < mailbox->hdrmax * s)
+  /* grow geometrically: fixed 25-slot steps mean loading an n-message
+   * folder reallocates and copies the array n/25 times */
+  size_t newmax = mailbox->hdrmax ? (mailbox->hdrmax + (mailbox->hdrmax / 2)) : 32;
+
+  if ((newmax * s < mailbox->hdrmax * s) || (newmax > (INT_MAX / 2)))
   {
     mutt_error(_("Out of memory"));
     mutt_exit(1);
   }
 
+  mailbox->hdrmax = newmax;
   if (mailbox->hdrs)
   {
-    mutt_mem_realloc(&mailbox->hdrs, sizeof(struct Email *) * (mailbox->hdrmax += 25));
+    mutt_mem_realloc(&mailbox->hdrs, sizeof(struct Email *) * mailbox->hdrmax);
     mutt_mem_realloc(&mailbox->v2r, sizeof(int) * mailbox->hdrmax);
   }
   else
   {
-    mailbox->hdrs = mutt_mem_calloc((mailbox->hdrmax += 25), sizeof(struct Email *));
+    mailbox->hdrs = mutt_mem_calloc(mailbox->hdrmax, sizeof(struct Email *));
     mailbox->v2r = mutt_mem_calloc(mailbox->hdrmax, sizeof(int));
   }
   for (int i = mailbox->msg_count; i < mailbox->hdrmax; i++)
@@ -1218,7 +1243,11 @@ void mx_update_context(struct Context *ctx, int new_messages)
       {
         e2->superseded = true;
         if (Score)
+        {
+          /* ~S rules must see the flag we just set, force a fresh score */
+          e2->score_rules = 0;
           mutt_score_message(ctx, e2, true);
+        }
       }
     }
 
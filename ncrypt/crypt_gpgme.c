@@ -131,6 +131,29 @@ static struct CryptCache *id_defaults = NULL;
 static gpgme_key_t signature_key = NULL;
 static char *current_sender = NULL;
 
+/**
+ * struct VerifyCache - A memoised signature verification result
+ *
+ * Verifying a signature spawns a gpg process, which costs hundreds of
+ * milliseconds every time a signed message is redisplayed.  The rendered
+ * result for a given signature/message pair cannot change while the keyring
+ * is stable, so keep it for $crypt_verify_cache_ttl seconds and replay it.
+ */
+struct VerifyCache
+{
+  int rc;     /**< Return code of verify_one() */
+  char *text; /**< Captured output, replayed verbatim */
+  time_t when; /**< When the verification ran, for expiry */
+};
+
+static struct Hash *VerifyCacheTable = NULL;
+static int VerifyCacheCount = 0;
+
+static void keyring_snapshot_invalidate(void);
+
+/** Wipe the cache rather than growing without bound in long sessions */
+#define VERIFY_CACHE_MAX_ENTRIES 256
+
 #define PKA_NOTATION_NAME "pka-address@gnupg.org"
 
 /**
@@ -567,28 +590,30 @@ static gpgme_data_t body_to_data_object(struct Body *a, bool convert)
 
   if (convert)
   {
-    int c, hadcr = 0;
-    unsigned char buf[1];
+    char buf[4096];
+    size_t got;
+    int prev = 0; /* last byte of the previous block, for CRs crossing reads */
 
     data = create_gpgme_data();
     rewind(fptmp);
-    while ((c = fgetc(fptmp)) != EOF)
+    while ((got = fread(buf, 1, sizeof(buf), fptmp)) > 0)
     {
-      if (c == '\r')
-        hadcr = 1;
-      else
+      /* insert a CR before every bare LF, writing the spans in between in
+       * one go instead of one gpgme_data_write() per byte */
+      size_t start = 0;
+      for (size_t i = 0; i < got; i++)
       {
-        if (c == '\n' && !hadcr)
+        if ((buf[i] == '\n') && (((i == 0) ? prev : buf[i - 1]) != '\r'))
         {
-          buf[0] = '\r';
-          gpgme_data_write(data, buf, 1);
+          if (i > start)
+            gpgme_data_write(data, buf + start, i - start);
+          gpgme_data_write(data, "\r\n", 2);
+          start = i + 1;
         }
-
-        hadcr = 0;
       }
-      /* FIXME: This is quite suboptimal */
-      buf[0] = c;
-      gpgme_data_write(data, buf, 1);
+      if (got > start)
+        gpgme_data_write(data, buf + start, got - start);
+      prev = buf[got - 1];
     }
     mutt_file_fclose(&fptmp);
     gpgme_data_seek(data, 0, SEEK_SET);
@@ -654,10 +679,18 @@ static int data_object_to_stream(gpgme_data_t data, FILE *fp)
   {
     /* fixme: we are not really converting CRLF to LF but just
          skipping CR. Doing it correctly needs a more complex logic */
-    for (char *p = buf; nread; p++, nread--)
+    const char *p = buf;
+    size_t left = nread;
+    while (left > 0)
     {
-      if (*p != '\r')
-        putc(*p, fp);
+      /* write the span up to the next CR in one go instead of a putc()
+       * per byte */
+      const char *cr = memchr(p, '\r', left);
+      const size_t span = cr ? (size_t)(cr - p) : left;
+      if (span)
+        fwrite(p, 1, span, fp);
+      p += span + (cr ? 1 : 0);
+      left -= span + (cr ? 1 : 0);
     }
 
     if (ferror(fp))
@@ -1680,11 +1713,12 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
 }
 
 /**
- * verify_one - Do the actual verification step
+ * verify_one_real - Do the actual verification step
  *
  * With IS_SMIME set to true we assume S/MIME (surprise!)
  */
-static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+static int verify_one_real(struct Body *sigbdy, struct State *s,
+                           const char *tempfile, bool is_smime)
 {
   int badsig = -1;
   int anywarn = 0;
@@ -1808,6 +1842,161 @@ static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile
   return badsig ? 1 : anywarn ? 2 : 0;
 }
 
+/**
+ * verify_cache_free - Hash destructor for a struct VerifyCache
+ */
+static void verify_cache_free(int type, void *obj, intptr_t data)
+{
+  struct VerifyCache *vc = obj;
+  FREE(&vc->text);
+  FREE(&vc);
+}
+
+/**
+ * verify_cache_key - Identify a signature/message pair
+ * @param[in]  sigbdy   Signature part, read from s->fpin
+ * @param[in]  s        State the result would be written to
+ * @param[in]  tempfile File containing the signed data
+ * @param[in]  is_smime True if an S/MIME signature
+ * @param[out] key      Buffer for the key, at least 33 bytes
+ * @retval true Key was computed
+ *
+ * Hashes the signature bytes, the signed data and the display flags - the
+ * rendered output differs between displayed and piped mail.
+ */
+static bool verify_cache_key(struct Body *sigbdy, struct State *s,
+                             const char *tempfile, bool is_smime, char *key)
+{
+  struct Md5Ctx ctx;
+  unsigned char digest[16];
+  char buf[4096];
+  size_t got;
+
+  FILE *fp = fopen(tempfile, "r");
+  if (!fp)
+    return false;
+
+  if (fseeko(s->fpin, sigbdy->offset, SEEK_SET) != 0)
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  mutt_md5_init_ctx(&ctx);
+
+  LOFF_T remaining = sigbdy->length;
+  while (remaining > 0)
+  {
+    got = fread(buf, 1, MIN(sizeof(buf), (size_t) remaining), s->fpin);
+    if (got == 0)
+      break;
+    mutt_md5_process_bytes(buf, got, &ctx);
+    remaining -= got;
+  }
+
+  while ((got = fread(buf, 1, sizeof(buf), fp)) != 0)
+    mutt_md5_process_bytes(buf, got, &ctx);
+  mutt_file_fclose(&fp);
+
+  const unsigned char tag = (is_smime ? 1 : 0) | ((s->flags & MUTT_DISPLAY) ? 2 : 0);
+  mutt_md5_process_bytes(&tag, sizeof(tag), &ctx);
+
+  mutt_md5_finish_ctx(&ctx, digest);
+  mutt_md5_toascii(digest, key);
+  return true;
+}
+
+/**
+ * verify_one - Memoising wrapper around verify_one_real()
+ *
+ * Capture the rendered verification result and replay it when the same
+ * signature/message pair is displayed again within $crypt_verify_cache_ttl
+ * seconds, saving a gpg invocation per redisplay.  The verification output
+ * path writes through state_puts()/state_attach_puts() only and never
+ * applies a quoting prefix, so the captured bytes can be replayed verbatim.
+ */
+static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+{
+  char key[33];
+
+  if ((CryptVerifyCacheTtl <= 0) || !verify_cache_key(sigbdy, s, tempfile, is_smime, key))
+    return verify_one_real(sigbdy, s, tempfile, is_smime);
+
+  if (VerifyCacheTable)
+  {
+    struct VerifyCache *vc = mutt_hash_find(VerifyCacheTable, key);
+    if (vc && ((time(NULL) - vc->when) <= CryptVerifyCacheTtl))
+    {
+      state_puts(vc->text, s);
+      /* signature_key still belongs to whatever ran the backend last;
+       * better no key than the wrong one if the user extracts it */
+      if (signature_key)
+      {
+        gpgme_key_unref(signature_key);
+        signature_key = NULL;
+      }
+      return vc->rc;
+    }
+  }
+
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+    return verify_one_real(sigbdy, s, tempfile, is_smime);
+
+  struct State cap = { 0 };
+  cap.fpin = s->fpin;
+  cap.fpout = fp;
+  cap.flags = s->flags;
+  const int rc = verify_one_real(sigbdy, &cap, tempfile, is_smime);
+
+  char *text = NULL;
+  fflush(fp);
+  const long len = ftell(fp);
+  if (len >= 0)
+  {
+    rewind(fp);
+    text = mutt_mem_malloc(len + 1);
+    if (fread(text, 1, len, fp) == (size_t) len)
+      text[len] = '\0';
+    else
+      FREE(&text);
+  }
+  mutt_file_fclose(&fp);
+
+  if (!text)
+    return verify_one_real(sigbdy, s, tempfile, is_smime);
+
+  state_puts(text, s);
+
+  if (VerifyCacheCount >= VERIFY_CACHE_MAX_ENTRIES)
+  {
+    mutt_hash_destroy(&VerifyCacheTable);
+    VerifyCacheCount = 0;
+  }
+  if (!VerifyCacheTable)
+  {
+    VerifyCacheTable = mutt_hash_create(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(VerifyCacheTable, verify_cache_free, 0);
+  }
+
+  struct VerifyCache *vc = mutt_hash_find(VerifyCacheTable, key);
+  if (vc)
+  {
+    FREE(&vc->text); /* expired entry, refresh it in place */
+  }
+  else
+  {
+    vc = mutt_mem_calloc(1, sizeof(struct VerifyCache));
+    mutt_hash_insert(VerifyCacheTable, key, vc);
+    VerifyCacheCount++;
+  }
+  vc->rc = rc;
+  vc->text = text;
+  vc->when = time(NULL);
+
+  return rc;
+}
+
 /**
  * pgp_gpgme_verify_one - Implements CryptModuleSpecs::verify_one()
  */
@@ -2458,6 +2647,7 @@ void pgp_gpgme_invoke_import(const char *fname)
   {
     mutt_error(_("Error extracting key data"));
   }
+  keyring_snapshot_invalidate();
   gpgme_data_release(keydata);
   mutt_file_fclose(&in);
   mutt_file_fclose(&out);
@@ -4138,21 +4328,27 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, unsigned int
       if (np->data && *np->data)
         n++;
     }
-    if (!n)
-      goto no_pgphints;
-
-    char **patarr = mutt_mem_calloc(n + 1, sizeof(*patarr));
-    n = 0;
-    STAILQ_FOREACH(np, hints, entries)
+    /* no hints at all means a full keyring listing, as used by
+     * keyring_snapshot() */
+    char **patarr = NULL;
+    if (n)
     {
-      if (np->data && *np->data)
-        patarr[n++] = mutt_str_strdup(np->data);
+      patarr = mutt_mem_calloc(n + 1, sizeof(*patarr));
+      n = 0;
+      STAILQ_FOREACH(np, hints, entries)
+      {
+        if (np->data && *np->data)
+          patarr[n++] = mutt_str_strdup(np->data);
+      }
+      patarr[n] = NULL;
     }
-    patarr[n] = NULL;
     err = gpgme_op_keylist_ext_start(ctx, (const char **) patarr, secret, 0);
-    for (n = 0; patarr[n]; n++)
-      FREE(&patarr[n]);
-    FREE(&patarr);
+    if (patarr)
+    {
+      for (n = 0; patarr[n]; n++)
+        FREE(&patarr[n]);
+      FREE(&patarr);
+    }
     if (err)
     {
       mutt_error(_("gpgme_op_keylist_start failed: %s"), gpgme_strerror(err));
@@ -4196,7 +4392,6 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, unsigned int
     if (gpg_err_code(err) != GPG_ERR_EOF)
       mutt_error(_("gpgme_op_keylist_next failed: %s"), gpgme_strerror(err));
     gpgme_op_keylist_end(ctx);
-  no_pgphints:;
   }
 
   if ((app & APPLICATION_SMIME))
@@ -4245,6 +4440,98 @@ static struct CryptKeyInfo *get_candidates(struct ListHead *hints, unsigned int
   return db;
 }
 
+/* Cached full keyring enumerations, one per application/secret combination.
+ * Resolving recipients runs one keylist per address, each of which makes
+ * gpgme re-scan the keyring; enumerating once and matching the hints in
+ * memory turns composing to many recipients into a single scan.  The keyring
+ * mtime isn't visible through gpgme, so a short lifetime bounds staleness. */
+static struct CryptKeyInfo *KeyringSnapshot[4][2];
+static time_t KeyringSnapshotWhen[4][2];
+
+#define KEYRING_SNAPSHOT_TTL 60 ///< Lifetime of a keyring snapshot, in seconds
+
+/**
+ * keyring_snapshot_invalidate - Drop the cached keyring enumerations
+ *
+ * Call after anything that modifies the keyring, e.g. a key import.
+ */
+static void keyring_snapshot_invalidate(void)
+{
+  for (int ai = 0; ai < 4; ai++)
+  {
+    for (int si = 0; si < 2; si++)
+    {
+      crypt_free_key(&KeyringSnapshot[ai][si]);
+      KeyringSnapshotWhen[ai][si] = 0;
+    }
+  }
+}
+
+/**
+ * keyring_snapshot - Get a full keyring enumeration
+ * @param app    Application type, e.g. #APPLICATION_PGP
+ * @param secret If true, only list secret keys
+ * @retval ptr  Key list owned by the cache, do not free
+ * @retval NULL Error, or the keyring is empty
+ */
+static struct CryptKeyInfo *keyring_snapshot(unsigned int app, int secret)
+{
+  const int ai = ((app & APPLICATION_PGP) ? 1 : 0) | ((app & APPLICATION_SMIME) ? 2 : 0);
+  const int si = secret ? 1 : 0;
+
+  if (KeyringSnapshot[ai][si] &&
+      ((time(NULL) - KeyringSnapshotWhen[ai][si]) <= KEYRING_SNAPSHOT_TTL))
+  {
+    return KeyringSnapshot[ai][si];
+  }
+
+  crypt_free_key(&KeyringSnapshot[ai][si]);
+
+  struct ListHead nohints = STAILQ_HEAD_INITIALIZER(nohints);
+  KeyringSnapshot[ai][si] = get_candidates(&nohints, app, secret);
+  KeyringSnapshotWhen[ai][si] = time(NULL);
+
+  return KeyringSnapshot[ai][si];
+}
+
+/**
+ * keyring_filter_hints - Clone the keys whose user ID contains a hint
+ * @param snap  Keyring snapshot from keyring_snapshot()
+ * @param hints List of strings to match
+ * @retval ptr Key list, free with crypt_free_key()
+ *
+ * A hint matches like a bare gpg listing pattern: a case-insensitive
+ * substring of the user ID.  An empty hints list matches every key, like a
+ * listing without a pattern.
+ */
+static struct CryptKeyInfo *keyring_filter_hints(struct CryptKeyInfo *snap,
+                                                 struct ListHead *hints)
+{
+  struct CryptKeyInfo *db = NULL, **kend = &db;
+
+  for (struct CryptKeyInfo *k = snap; k; k = k->next)
+  {
+    bool match = STAILQ_EMPTY(hints);
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, hints, entries)
+    {
+      if (np->data && *np->data && mutt_str_stristr(k->uid, np->data))
+      {
+        match = true;
+        break;
+      }
+    }
+    if (match)
+    {
+      struct CryptKeyInfo *tmp = crypt_copy_key(k);
+      *kend = tmp;
+      kend = &tmp->next;
+    }
+  }
+
+  return db;
+}
+
 /**
  * crypt_add_string_to_hints - Split a string and add the parts to a List
  * @param[in]  str   String to parse
@@ -4519,7 +4806,13 @@ static struct CryptKeyInfo *crypt_getkeybyaddr(struct Address *a,
 
   if (!oppenc_mode)
     mutt_message(_("Looking for keys matching \"%s\"..."), a ? a->mailbox : "");
-  keys = get_candidates(&hints, app, (abilities & KEYFLAG_CANSIGN));
+  /* the address filtering below is authoritative, so the candidates only
+   * need to be a superset of the keys gpg would list for the hints */
+  struct CryptKeyInfo *snap = keyring_snapshot(app, (abilities & KEYFLAG_CANSIGN));
+  if (snap)
+    keys = keyring_filter_hints(snap, &hints);
+  else
+    keys = get_candidates(&hints, app, (abilities & KEYFLAG_CANSIGN));
 
   mutt_list_free(&hints);
 
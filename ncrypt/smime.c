@@ -104,6 +104,26 @@ static char SmimeKeyToUse[PATH_MAX] = { 0 };
 static char SmimeCertToUse[PATH_MAX];
 static char SmimeIntermediateToUse[PATH_MAX];
 
+/**
+ * struct SmimeVerifyCache - A memoised signature verification result
+ *
+ * Each verification execs openssl, so redisplaying a signed message - or
+ * verifying a tagged set containing duplicates - pays process startup every
+ * time.  Keep the rendered result for $crypt_verify_cache_ttl seconds.
+ */
+struct SmimeVerifyCache
+{
+  int rc;      /**< Return code of smime_class_verify_one() */
+  char *text;  /**< Captured output, replayed verbatim */
+  time_t when; /**< When the verification ran, for expiry */
+};
+
+static struct Hash *SmimeVerifyCacheTable = NULL;
+static int SmimeVerifyCacheCount = 0;
+
+/** Wipe the cache rather than growing without bound in long sessions */
+#define SMIME_VERIFY_CACHE_MAX_ENTRIES 256
+
 /**
  * smime_free_key - Free a list of SMIME keys
  * @param keylist List of keys to free
@@ -1886,9 +1906,11 @@ static pid_t smime_invoke_decrypt(FILE **smimein, FILE **smimeout,
 }
 
 /**
- * smime_class_verify_one - Implements CryptModuleSpecs::verify_one()
+ * smime_verify_one_real - Do the actual verification step
+ *
+ * The caller has already written the timestamped banner for the output.
  */
-int smime_class_verify_one(struct Body *sigbdy, struct State *s, const char *tempfile)
+static int smime_verify_one_real(struct Body *sigbdy, struct State *s, const char *tempfile)
 {
   char signedfile[PATH_MAX];
   FILE *smimeout = NULL;
@@ -1945,8 +1967,6 @@ int smime_class_verify_one(struct Body *sigbdy, struct State *s, const char *tem
     return -1;
   }
 
-  crypt_current_time(s, "OpenSSL");
-
   thepid = smime_invoke_verify(NULL, &smimeout, NULL, -1, -1, fileno(smimeerr),
                                tempfile, signedfile, 0);
   if (thepid != -1)
@@ -1992,6 +2012,152 @@ int smime_class_verify_one(struct Body *sigbdy, struct State *s, const char *tem
   return badsig;
 }
 
+/**
+ * smime_verify_cache_free - Hash destructor for a struct SmimeVerifyCache
+ */
+static void smime_verify_cache_free(int type, void *obj, intptr_t data)
+{
+  struct SmimeVerifyCache *vc = obj;
+  FREE(&vc->text);
+  FREE(&vc);
+}
+
+/**
+ * smime_verify_cache_key - Identify a signature/message pair
+ * @param[in]  sigbdy   Signature part, read from s->fpin
+ * @param[in]  s        State the result would be written to
+ * @param[in]  tempfile File containing the signed data
+ * @param[out] key      Buffer for the key, at least 33 bytes
+ * @retval true Key was computed
+ *
+ * Hashes the undecoded signature bytes and the signed data.
+ */
+static bool smime_verify_cache_key(struct Body *sigbdy, struct State *s,
+                                   const char *tempfile, char *key)
+{
+  struct Md5Ctx ctx;
+  unsigned char digest[16];
+  char buf[4096];
+  size_t got;
+
+  FILE *fp = fopen(tempfile, "r");
+  if (!fp)
+    return false;
+
+  if (fseeko(s->fpin, sigbdy->offset, SEEK_SET) != 0)
+  {
+    mutt_file_fclose(&fp);
+    return false;
+  }
+
+  mutt_md5_init_ctx(&ctx);
+
+  LOFF_T remaining = sigbdy->length;
+  while (remaining > 0)
+  {
+    got = fread(buf, 1, MIN(sizeof(buf), (size_t) remaining), s->fpin);
+    if (got == 0)
+      break;
+    mutt_md5_process_bytes(buf, got, &ctx);
+    remaining -= got;
+  }
+
+  while ((got = fread(buf, 1, sizeof(buf), fp)) != 0)
+    mutt_md5_process_bytes(buf, got, &ctx);
+  mutt_file_fclose(&fp);
+
+  mutt_md5_finish_ctx(&ctx, digest);
+  mutt_md5_toascii(digest, key);
+  return true;
+}
+
+/**
+ * smime_class_verify_one - Implements CryptModuleSpecs::verify_one()
+ *
+ * Memoising wrapper around smime_verify_one_real().  The rendered result for
+ * a signature/message pair is captured and replayed on redisplay within
+ * $crypt_verify_cache_ttl seconds, saving an openssl exec each time.  The
+ * timestamped banner is always written afresh so $crypt_timestamp keeps its
+ * anti-spoofing value.
+ */
+int smime_class_verify_one(struct Body *sigbdy, struct State *s, const char *tempfile)
+{
+  char key[33];
+
+  crypt_current_time(s, "OpenSSL");
+
+  if ((CryptVerifyCacheTtl <= 0) || !smime_verify_cache_key(sigbdy, s, tempfile, key))
+    return smime_verify_one_real(sigbdy, s, tempfile);
+
+  if (SmimeVerifyCacheTable)
+  {
+    struct SmimeVerifyCache *vc = mutt_hash_find(SmimeVerifyCacheTable, key);
+    if (vc && ((time(NULL) - vc->when) <= CryptVerifyCacheTtl))
+    {
+      state_puts(vc->text, s);
+      return vc->rc;
+    }
+  }
+
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+    return smime_verify_one_real(sigbdy, s, tempfile);
+
+  struct State cap = { 0 };
+  cap.fpin = s->fpin;
+  cap.fpout = fp;
+  cap.prefix = s->prefix;
+  cap.flags = s->flags;
+  const int rc = smime_verify_one_real(sigbdy, &cap, tempfile);
+
+  char *text = NULL;
+  fflush(fp);
+  const long len = ftell(fp);
+  if (len >= 0)
+  {
+    rewind(fp);
+    text = mutt_mem_malloc(len + 1);
+    if (fread(text, 1, len, fp) == (size_t) len)
+      text[len] = '\0';
+    else
+      FREE(&text);
+  }
+  mutt_file_fclose(&fp);
+
+  if (!text)
+    return smime_verify_one_real(sigbdy, s, tempfile);
+
+  state_puts(text, s);
+
+  if (SmimeVerifyCacheCount >= SMIME_VERIFY_CACHE_MAX_ENTRIES)
+  {
+    mutt_hash_destroy(&SmimeVerifyCacheTable);
+    SmimeVerifyCacheCount = 0;
+  }
+  if (!SmimeVerifyCacheTable)
+  {
+    SmimeVerifyCacheTable = mutt_hash_create(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(SmimeVerifyCacheTable, smime_verify_cache_free, 0);
+  }
+
+  struct SmimeVerifyCache *vc = mutt_hash_find(SmimeVerifyCacheTable, key);
+  if (vc)
+  {
+    FREE(&vc->text); /* expired entry, refresh it in place */
+  }
+  else
+  {
+    vc = mutt_mem_calloc(1, sizeof(struct SmimeVerifyCache));
+    mutt_hash_insert(SmimeVerifyCacheTable, key, vc);
+    SmimeVerifyCacheCount++;
+  }
+  vc->rc = rc;
+  vc->text = text;
+  vc->when = time(NULL);
+
+  return rc;
+}
+
 /**
  * smime_handle_entity - Handle type application/pkcs7-mime
  * @param m        Body to handle
@@ -33,6 +33,7 @@
 #include <errno.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -179,6 +180,176 @@ void nntp_group_unread_stat(struct NntpMboxData *mdata)
   }
 }
 
+static void cache_expand(char *dst, size_t dstlen, struct ConnAccount *acct, const char *src);
+static int update_file(char *filename, char *buf, size_t buflen);
+
+/* first field of the compiled .newsrc cache, bump when the format changes */
+#define NEWSRC_CACHE_MAGIC 0x4e524301u
+
+/**
+ * struct NewsrcCacheHeader - Header of the compiled .newsrc cache
+ *
+ * The cache compiles the subscription state of one parsed .newsrc into a
+ * flat file: this header, then one record per newsgroup.  A record is three
+ * uint32_t fields - length of the group name including its terminating NUL,
+ * subscribed flag, number of article ranges - followed by the name and the
+ * first/last pairs.  All fields are in host byte order, the cache is only
+ * ever read by the host that wrote it.
+ */
+struct NewsrcCacheHeader
+{
+  uint32_t magic;   /**< #NEWSRC_CACHE_MAGIC */
+  uint32_t groups;  /**< number of newsgroup records that follow */
+  int64_t size;     /**< size of the .newsrc this cache was compiled from */
+  int64_t mtime;    /**< mtime of the .newsrc this cache was compiled from */
+};
+
+/**
+ * newsrc_get_cache - Load subscription state from the compiled .newsrc cache
+ * @param nserv NNTP server
+ * @retval  0 Success
+ * @retval -1 Failure, caller must parse the textual .newsrc
+ *
+ * The cache is only used when it was compiled from exactly the .newsrc now
+ * on disk (same size and mtime), so an externally modified file always goes
+ * through the real parser.  The whole file is validated before any group is
+ * touched - a truncated or corrupt cache is simply ignored.
+ */
+static int newsrc_get_cache(struct NntpServer *nserv)
+{
+  char file[PATH_MAX];
+  struct NewsrcCacheHeader hdr;
+  struct stat sb;
+  char *buf = NULL;
+  int rc = -1;
+
+  if (!nserv->cacheable)
+    return -1;
+
+  cache_expand(file, sizeof(file), &nserv->conn->account, ".newsrc");
+  FILE *fp = mutt_file_fopen(file, "r");
+  if (!fp)
+    return -1;
+
+  if ((fstat(fileno(fp), &sb) == 0) && (sb.st_size >= (off_t) sizeof(hdr)))
+  {
+    const size_t len = sb.st_size - sizeof(hdr);
+    buf = mutt_mem_malloc(len ? len : 1);
+    if ((fread(&hdr, sizeof(hdr), 1, fp) == 1) && (hdr.magic == NEWSRC_CACHE_MAGIC) &&
+        (hdr.size == (int64_t) nserv->size) && (hdr.mtime == (int64_t) nserv->mtime) &&
+        (fread(buf, 1, len, fp) == len))
+    {
+      /* first pass: validate every record before applying any */
+      size_t off = 0;
+      uint32_t count;
+      for (count = 0; count < hdr.groups; count++)
+      {
+        uint32_t rec[3];
+        if (len - off < sizeof(rec))
+          break;
+        memcpy(rec, buf + off, sizeof(rec));
+        off += sizeof(rec);
+        if ((rec[0] == 0) || (len - off < rec[0]) || (buf[off + rec[0] - 1] != '\0'))
+          break;
+        off += rec[0];
+        if ((len - off) / (2 * sizeof(anum_t)) < rec[2])
+          break;
+        off += rec[2] * 2 * sizeof(anum_t);
+      }
+
+      if ((count == hdr.groups) && (off == len))
+      {
+        mutt_debug(1, "Loading compiled %s\n", nserv->newsrc_file);
+
+        /* second pass: apply */
+        off = 0;
+        for (uint32_t i = 0; i < hdr.groups; i++)
+        {
+          uint32_t rec[3];
+          memcpy(rec, buf + off, sizeof(rec));
+          off += sizeof(rec);
+
+          struct NntpMboxData *mdata = mdata_find(nserv, buf + off);
+          off += rec[0];
+          FREE(&mdata->newsrc_ent);
+          mdata->subscribed = rec[1];
+          mdata->newsrc_len = rec[2];
+          mdata->newsrc_ent = mutt_mem_calloc(rec[2] ? rec[2] : 1,
+                                              sizeof(struct NewsrcEntry));
+          for (uint32_t j = 0; j < rec[2]; j++)
+          {
+            memcpy(&mdata->newsrc_ent[j].first, buf + off, sizeof(anum_t));
+            off += sizeof(anum_t);
+            memcpy(&mdata->newsrc_ent[j].last, buf + off, sizeof(anum_t));
+            off += sizeof(anum_t);
+          }
+          if ((mdata->last_message == 0) && rec[2])
+            mdata->last_message = mdata->newsrc_ent[rec[2] - 1].last;
+          nntp_group_unread_stat(mdata);
+        }
+        rc = 0;
+      }
+    }
+  }
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+  return rc;
+}
+
+/**
+ * newsrc_save_cache - Compile parsed .newsrc data into the binary cache
+ * @param nserv NNTP server
+ */
+static void newsrc_save_cache(struct NntpServer *nserv)
+{
+  char file[PATH_MAX];
+  struct NewsrcCacheHeader hdr = { NEWSRC_CACHE_MAGIC, 0, (int64_t) nserv->size,
+                                   (int64_t) nserv->mtime };
+  char *buf = NULL;
+  size_t buflen, off;
+
+  if (!nserv->cacheable)
+    return;
+
+  buflen = 10 * LONG_STRING;
+  buf = mutt_mem_calloc(1, buflen);
+  off = sizeof(hdr);
+
+  for (unsigned int i = 0; i < nserv->groups_num; i++)
+  {
+    struct NntpMboxData *mdata = nserv->groups_list[i];
+
+    if (!mdata || !mdata->newsrc_ent)
+      continue;
+
+    uint32_t rec[3] = { strlen(mdata->group) + 1, mdata->subscribed, mdata->newsrc_len };
+    const size_t reclen = sizeof(rec) + rec[0] + rec[2] * 2 * sizeof(anum_t);
+    while (off + reclen > buflen)
+    {
+      buflen *= 2;
+      mutt_mem_realloc(&buf, buflen);
+    }
+    memcpy(buf + off, rec, sizeof(rec));
+    off += sizeof(rec);
+    memcpy(buf + off, mdata->group, rec[0]);
+    off += rec[0];
+    for (unsigned int j = 0; j < mdata->newsrc_len; j++)
+    {
+      memcpy(buf + off, &mdata->newsrc_ent[j].first, sizeof(anum_t));
+      off += sizeof(anum_t);
+      memcpy(buf + off, &mdata->newsrc_ent[j].last, sizeof(anum_t));
+      off += sizeof(anum_t);
+    }
+    hdr.groups++;
+  }
+  memcpy(buf, &hdr, sizeof(hdr));
+
+  cache_expand(file, sizeof(file), &nserv->conn->account, ".newsrc");
+  mutt_debug(1, "Updating %s\n", file);
+  update_file(file, buf, off);
+  FREE(&buf);
+}
+
 /**
  * nntp_newsrc_parse - Parse .newsrc file
  * @param nserv NNTP server
@@ -247,6 +418,10 @@ int nntp_newsrc_parse(struct NntpServer *nserv)
     FREE(&mdata->newsrc_ent);
   }
 
+  /* a compiled cache of this very .newsrc loads in one read */
+  if (newsrc_get_cache(nserv) == 0)
+    return 1;
+
   line = mutt_mem_malloc(sb.st_size + 1);
   while (sb.st_size && fgets(line, sb.st_size + 1, nserv->newsrc_fp))
   {
@@ -314,6 +489,7 @@ int nntp_newsrc_parse(struct NntpServer *nserv)
     mutt_debug(2, "%s\n", mdata->group);
   }
   FREE(&line);
+  newsrc_save_cache(nserv);
   return 1;
 }
 
@@ -405,11 +581,12 @@ void nntp_newsrc_gen_entries(struct Context *ctx)
 /**
  * update_file - Update file with new contents
  * @param filename File to update
- * @param buf      New context
+ * @param buf      New contents
+ * @param buflen   Length of new contents
  * @retval  0 Success
  * @retval -1 Failure
  */
-static int update_file(char *filename, char *buf)
+static int update_file(char *filename, char *buf, size_t buflen)
 {
   FILE *fp = NULL;
   char tmpfile[PATH_MAX];
@@ -425,7 +602,7 @@ static int update_file(char *filename, char *buf)
       *tmpfile = '\0';
       break;
     }
-    if (fputs(buf, fp) == EOF)
+    if (fwrite(buf, 1, buflen, fp) != buflen)
     {
       mutt_perror(tmpfile);
       break;
@@ -514,7 +691,7 @@ int nntp_newsrc_update(struct NntpServer *nserv)
 
   /* newrc being fully rewritten */
   mutt_debug(1, "Updating %s\n", nserv->newsrc_file);
-  if (nserv->newsrc_file && update_file(nserv->newsrc_file, buf) == 0)
+  if (nserv->newsrc_file && update_file(nserv->newsrc_file, buf, off) == 0)
   {
     struct stat sb;
 
@@ -523,6 +700,7 @@ int nntp_newsrc_update(struct NntpServer *nserv)
     {
       nserv->size = sb.st_size;
       nserv->mtime = sb.st_mtime;
+      newsrc_save_cache(nserv);
     }
     else
     {
@@ -699,7 +877,7 @@ int nntp_active_save_cache(struct NntpServer *nserv)
 
   cache_expand(file, sizeof(file), &nserv->conn->account, ".active");
   mutt_debug(1, "Updating %s\n", file);
-  rc = update_file(file, buf);
+  rc = update_file(file, buf, off);
   FREE(&buf);
   return rc;
 }
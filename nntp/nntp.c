@@ -68,6 +68,7 @@
 /* These Config Variables are only used in nntp/nntp.c */
 char *NntpAuthenticators; ///< Config: (nntp) Allowed authentication methods
 short NntpContext; ///< Config: (nntp) Maximum number of articles to list (0 for all articles)
+bool NntpDeflate; ///< Config: (nntp) Compress network traffic via COMPRESS DEFLATE
 bool NntpListgroup; ///< Config: (nntp) Check all articles when opening a newsgroup
 bool NntpLoadDescription; ///< Config: (nntp) Load descriptions for newsgroups when adding to the list
 short NntpPoll; ///< Config: (nntp) Interval between checks for new posts
@@ -162,6 +163,7 @@ static int nntp_capabilities(struct NntpServer *nserv)
   nserv->hasLISTGROUP = false;
   nserv->hasLISTGROUPrange = false;
   nserv->hasOVER = false;
+  nserv->hasCOMPRESS = false;
   FREE(&nserv->authenticators);
 
   if (mutt_socket_send(conn, "CAPABILITIES\r\n") < 0 ||
@@ -206,6 +208,11 @@ static int nntp_capabilities(struct NntpServer *nserv)
 #endif
     else if (mutt_str_strcmp("OVER", buf) == 0)
       nserv->hasOVER = true;
+    else if (mutt_str_strncmp("COMPRESS ", buf, 9) == 0)
+    {
+      if (strstr(buf + 9, "DEFLATE"))
+        nserv->hasCOMPRESS = true;
+    }
     else if (mutt_str_strncmp("LIST ", buf, 5) == 0)
     {
       char *p = strstr(buf, " NEWSGROUPS");
@@ -1021,88 +1028,116 @@ static int parse_overview_line(char *line, void *data)
     return 0;
   }
 
-  /* convert overview line to header */
-  FILE *fp = mutt_file_mkstemp();
-  if (!fp)
-    return -1;
+  /* allocate memory for headers */
+  if (ctx->mailbox->msg_count >= ctx->mailbox->hdrmax)
+    mx_alloc_memory(ctx->mailbox);
 
-  header = mdata->nserv->overview_fmt;
-  while (field)
-  {
-    char *b = field;
+#ifdef USE_HCACHE
+  char buf[16];
+  snprintf(buf, sizeof(buf), "%u", anum);
+
+  /* try to fetch header from cache, skipping the overview conversion */
+  void *hdata = fc->hc ? mutt_hcache_fetch(fc->hc, buf, strlen(buf)) : NULL;
+  if (hdata)
+  {
+    mutt_debug(2, "mutt_hcache_fetch %s\n", buf);
+    e = mutt_hcache_restore(hdata);
+    ctx->mailbox->hdrs[ctx->mailbox->msg_count] = e;
+    mutt_hcache_free(fc->hc, &hdata);
+    e->data = NULL;
+    e->read = false;
+    e->old = false;
 
-    if (*header)
+    /* skip header marked as deleted in cache */
+    if (e->deleted && !fc->restore)
     {
-      if (!strstr(header, ":full") && (fputs(header, fp) == EOF))
+      if (mdata->bcache)
       {
-        mutt_file_fclose(&fp);
-        return -1;
+        mutt_debug(2, "mutt_bcache_del %s\n", buf);
+        mutt_bcache_del(mdata->bcache, buf);
       }
-      header = strchr(header, '\0') + 1;
-    }
-
-    field = strchr(field, '\t');
-    if (field)
-      *field++ = '\0';
-    if (fputs(b, fp) == EOF || fputc('\n', fp) == EOF)
-    {
-      mutt_file_fclose(&fp);
-      return -1;
+      save = false;
     }
   }
-  rewind(fp);
-
-  /* allocate memory for headers */
-  if (ctx->mailbox->msg_count >= ctx->mailbox->hdrmax)
-    mx_alloc_memory(ctx->mailbox);
-
-  /* parse header */
-  ctx->mailbox->hdrs[ctx->mailbox->msg_count] = mutt_email_new();
-  e = ctx->mailbox->hdrs[ctx->mailbox->msg_count];
-  e->env = mutt_rfc822_read_header(fp, e, false, false);
-  e->env->newsgroups = mutt_str_strdup(mdata->group);
-  e->received = e->date_sent;
-  mutt_file_fclose(&fp);
-
-#ifdef USE_HCACHE
-  if (fc->hc)
+  else
+#endif
   {
-    char buf[16];
+    /* convert overview line to header */
+#ifdef USE_FMEMOPEN
+    char *mem = NULL;
+    size_t memsize = 0;
+    FILE *fp = open_memstream(&mem, &memsize);
+#else
+    FILE *fp = mutt_file_mkstemp();
+#endif
+    if (!fp)
+      return -1;
 
-    /* try to replace with header from cache */
-    snprintf(buf, sizeof(buf), "%u", anum);
-    void *hdata = mutt_hcache_fetch(fc->hc, buf, strlen(buf));
-    if (hdata)
+    header = mdata->nserv->overview_fmt;
+    while (field)
     {
-      mutt_debug(2, "mutt_hcache_fetch %s\n", buf);
-      mutt_email_free(&e);
-      e = mutt_hcache_restore(hdata);
-      ctx->mailbox->hdrs[ctx->mailbox->msg_count] = e;
-      mutt_hcache_free(fc->hc, &hdata);
-      e->data = NULL;
-      e->read = false;
-      e->old = false;
+      char *b = field;
 
-      /* skip header marked as deleted in cache */
-      if (e->deleted && !fc->restore)
+      if (*header)
       {
-        if (mdata->bcache)
+        if (!strstr(header, ":full") && (fputs(header, fp) == EOF))
         {
-          mutt_debug(2, "mutt_bcache_del %s\n", buf);
-          mutt_bcache_del(mdata->bcache, buf);
+          mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+          FREE(&mem);
+#endif
+          return -1;
         }
-        save = false;
+        header = strchr(header, '\0') + 1;
       }
+
+      field = strchr(field, '\t');
+      if (field)
+        *field++ = '\0';
+      if (fputs(b, fp) == EOF || fputc('\n', fp) == EOF)
+      {
+        mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+        FREE(&mem);
+#endif
+        return -1;
+      }
+    }
+#ifdef USE_FMEMOPEN
+    mutt_file_fclose(&fp);
+    if (memsize)
+      fp = fmemopen(mem, memsize, "r");
+    else /* fmemopen cannot handle empty buffers */
+      fp = mutt_file_fopen("/dev/null", "r");
+    if (!fp)
+    {
+      FREE(&mem);
+      return -1;
     }
+#else
+    rewind(fp);
+#endif
+
+    /* parse header */
+    ctx->mailbox->hdrs[ctx->mailbox->msg_count] = mutt_email_new();
+    e = ctx->mailbox->hdrs[ctx->mailbox->msg_count];
+    e->env = mutt_rfc822_read_header(fp, e, false, false);
+    e->env->newsgroups = mutt_str_strdup(mdata->group);
+    e->received = e->date_sent;
+    mutt_file_fclose(&fp);
+#ifdef USE_FMEMOPEN
+    FREE(&mem);
+#endif
 
+#ifdef USE_HCACHE
     /* not cached yet, store header */
-    else
+    if (fc->hc)
     {
       mutt_debug(2, "mutt_hcache_store %s\n", buf);
       mutt_hcache_store(fc->hc, buf, strlen(buf), e, 0);
     }
-  }
 #endif
+  }
 
   if (save)
   {
@@ -1861,6 +1896,24 @@ int nntp_open_connection(struct NntpServer *nserv)
   if (nntp_attempt_features(nserv) < 0)
     return -1;
 
+#ifdef USE_ZLIB
+  /* RFC8054 COMPRESS DEFLATE.  Negotiated last: everything after the
+   * server's 206 is a deflate stream, including overview feeds. */
+  if (NntpDeflate && nserv->hasCOMPRESS)
+  {
+    if (mutt_socket_send(conn, "COMPRESS DEFLATE\r\n") < 0 ||
+        mutt_socket_readln(buf, sizeof(buf), conn) < 0)
+    {
+      return nntp_connect_error(nserv);
+    }
+    if (mutt_str_strncmp("206", buf, 3) == 0)
+    {
+      mutt_debug(2, "NNTP compression enabled\n");
+      mutt_zstrm_wrap_conn(conn);
+    }
+  }
+#endif
+
   nserv->status = NNTP_OK;
   return 0;
 }
@@ -2657,10 +2710,10 @@ int nntp_path_probe(const char *path, const struct stat *st)
   if (!path)
     return MUTT_UNKNOWN;
 
-  if (mutt_str_strncasecmp(path, "news://", 7) == 0)
+  if (mutt_str_ascii_strncasecmp(path, "news://", 7) == 0)
     return MUTT_NNTP;
 
-  if (mutt_str_strncasecmp(path, "snews://", 8) == 0)
+  if (mutt_str_ascii_strncasecmp(path, "snews://", 8) == 0)
     return MUTT_NNTP;
 
   return MUTT_UNKNOWN;
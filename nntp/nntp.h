@@ -51,6 +51,7 @@ struct Context;
 /* These Config Variables are only used in nntp/nntp.c */
 extern char *NntpAuthenticators;
 extern short NntpContext;
+extern bool  NntpDeflate;
 extern bool  NntpListgroup;
 extern bool  NntpLoadDescription;
 extern short NntpPoll;
@@ -78,6 +79,7 @@ struct NntpServer
   bool hasLISTGROUPrange  : 1;
   bool hasOVER            : 1;
   bool hasXOVER           : 1;
+  bool hasCOMPRESS        : 1;
   unsigned int use_tls    : 3;
   unsigned int status     : 3;
   bool cacheable          : 1;
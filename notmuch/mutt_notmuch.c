@@ -654,6 +654,7 @@ static int release_db(struct NmMboxData *mdata)
 #endif
   mdata->db = NULL;
   mdata->longrun = false;
+  mdata->trans = false; /* any open transaction died with the db handle */
   return 0;
 }
 
@@ -1758,6 +1759,11 @@ void nm_longrun_init(struct Mailbox *mailbox, bool writable)
   if (mdata && get_db(mdata, writable))
   {
     mdata->longrun = true;
+    /* batch everything the long run does into one atomic block, so e.g.
+     * re-tagging thousands of messages costs a single xapian commit
+     * instead of one per message */
+    if (writable)
+      db_trans_begin(mdata);
     mutt_debug(2, "nm: long run initialized\n");
   }
 }
@@ -1770,7 +1776,11 @@ void nm_longrun_done(struct Mailbox *mailbox)
 {
   struct NmMboxData *mdata = get_mboxdata(mailbox);
 
-  if (mdata && (release_db(mdata) == 0))
+  if (!mdata)
+    return;
+
+  db_trans_end(mdata); /* commit whatever the long run batched up */
+  if (release_db(mdata) == 0)
     mutt_debug(2, "nm: long run deinitialized\n");
 }
 
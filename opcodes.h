@@ -223,6 +223,7 @@
   _fmt(OP_SEARCH_TOGGLE,                  N_("toggle search pattern coloring")) \
   _fmt(OP_SHELL_ESCAPE,                   N_("invoke a command in a subshell")) \
   _fmt(OP_SHOW_LOG_MESSAGES,              N_("show log (and debug) messages")) \
+  _fmt(OP_SHOW_STATS,                     N_("show per-mailbox statistics")) \
   _fmt(OP_SORT,                           N_("sort messages")) \
   _fmt(OP_SORT_REVERSE,                   N_("sort messages in reverse order")) \
   _fmt(OP_SUBSCRIBE_PATTERN,              N_("subscribe to newsgroups matching a pattern")) \
@@ -863,6 +863,24 @@ int mutt_is_quote_line(char *line, regmatch_t *pmatch)
   return is_quote;
 }
 
+/**
+ * color_line_might_match - Can a colour rule's regex possibly match a string?
+ * @param color_line Colour rule to check
+ * @param s          String the regex would be run against
+ * @retval true The regex may match (or no prefilter is available)
+ *
+ * A substring search for the rule's required literal is far cheaper than
+ * regexec(), so use it to skip rules that cannot match this line.
+ */
+static bool color_line_might_match(const struct ColorLine *color_line, const char *s)
+{
+  if (!color_line->prefilter)
+    return true;
+  if (color_line->prefilter_icase)
+    return mutt_str_stristr(s, color_line->prefilter) != NULL;
+  return strstr(s, color_line->prefilter) != NULL;
+}
+
 /**
  * resolve_types - Determine the style for a line of text
  * @param buf          Formatted text
@@ -918,7 +936,8 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       {
         STAILQ_FOREACH(color_line, &ColorHdrList, entries)
         {
-          if (regexec(&color_line->regex, buf, 0, NULL, 0) == 0)
+          if (color_line_might_match(color_line, buf) &&
+              regexec(&color_line->regex, buf, 0, NULL, 0) == 0)
           {
             line_info[n].type = MT_COLOR_HEADER;
             line_info[n].syntax[0].color = color_line->pair;
@@ -1012,7 +1031,8 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
         head = &ColorBodyList;
       STAILQ_FOREACH(color_line, head, entries)
       {
-        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
+        if (color_line_might_match(color_line, buf + offset) &&
+            regexec(&color_line->regex, buf + offset, 1, pmatch,
                     (offset ? REG_NOTBOL : 0)) == 0)
         {
           if (pmatch[0].rm_eo != pmatch[0].rm_so)
@@ -1082,7 +1102,8 @@ static void resolve_types(char *buf, char *raw, struct Line *line_info, int n,
       null_rx = false;
       STAILQ_FOREACH(color_line, &ColorAttachList, entries)
       {
-        if (regexec(&color_line->regex, buf + offset, 1, pmatch,
+        if (color_line_might_match(color_line, buf + offset) &&
+            regexec(&color_line->regex, buf + offset, 1, pmatch,
                     (offset ? REG_NOTBOL : 0)) == 0)
         {
           if (pmatch[0].rm_eo != pmatch[0].rm_so)
@@ -1266,6 +1287,16 @@ static int fill_buffer(FILE *f, LOFF_T *last_pos, LOFF_T offset, unsigned char *
     /* copy "buf" to "fmt", but without bold and underline controls */
     p = *buf;
     q = *fmt;
+
+    /* common case: nothing to strip, so take one memcpy instead of the
+     * per-byte loop below; this runs for every line on every repaint */
+    const size_t len = strlen((char *) p);
+    if (!memchr(p, '\010', len) && !memchr(p, '\033', len))
+    {
+      memcpy(q, p, len + 1);
+      return b_read;
+    }
+
     while (*p)
     {
       if (*p == '\010' && (p > *buf))
@@ -1548,7 +1579,9 @@ static int display_line(FILE *f, LOFF_T *last_pos, struct Line **line_info, int
 
   if (*last == *max)
   {
-    mutt_mem_realloc(line_info, sizeof(struct Line) * (*max += LINES));
+    /* grow geometrically: fixed-size steps mean quadratic copying on
+     * million-line attachments */
+    mutt_mem_realloc(line_info, sizeof(struct Line) * (*max += MAX(LINES, *max / 2)));
     for (ch = *last; ch < *max; ch++)
     {
       memset(&((*line_info)[ch]), 0, sizeof(struct Line));
@@ -2180,6 +2213,50 @@ static void pager_menu_redraw(struct Menu *pager_menu)
   pager_menu->redraw = 0;
 }
 
+/* largest body we fetch ahead of the user; the fetch is synchronous, so
+ * anything bigger isn't worth the risk of blocking a keypress on it */
+#define PREFETCH_MAX_BODY (1024 * 1024)
+
+/**
+ * prefetch_next_message - Warm the message cache with the following message
+ * @param cur Email currently shown in the pager
+ *
+ * Called while the pager sits idle waiting for input.  For network-backed
+ * mailboxes, fetch the next visible message into the driver's cache (body
+ * cache or temporary file) so that a subsequent <next-entry> renders from
+ * local disk instead of waiting on the server.  Reading a message takes
+ * much longer than fetching the next one, so the fetch usually finishes
+ * well before it's needed.
+ */
+static void prefetch_next_message(struct Email *cur)
+{
+  if (!Context || !Context->mailbox || OptAttachMsg)
+    return;
+  if ((Context->mailbox->magic != MUTT_IMAP) && (Context->mailbox->magic != MUTT_POP))
+    return;
+  if (cur->virtual < 0)
+    return;
+
+  for (int v = cur->virtual + 1; v < Context->mailbox->vcount; v++)
+  {
+    struct Email *e = Context->mailbox->hdrs[Context->mailbox->v2r[v]];
+    if (e->deleted)
+      continue;
+    if (e->content->length > PREFETCH_MAX_BODY)
+      return;
+
+    /* quiet suppresses the drivers' "Fetching message..." progress, which
+     * would otherwise flicker over whatever the user is reading */
+    bool q = Context->mailbox->quiet;
+    Context->mailbox->quiet = true;
+    struct Message *msg = mx_msg_open(Context, Context->mailbox->v2r[v]);
+    if (msg)
+      mx_msg_close(Context, &msg);
+    Context->mailbox->quiet = q;
+    return;
+  }
+}
+
 /**
  * mutt_pager - Display a file, or help, in a window
  * @param banner Title to display in status bar
@@ -2212,6 +2289,7 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
   int index_hint = 0;      /* used to restore cursor position */
   int oldcount = -1;
   int check;
+  struct Email *prefetched_for = NULL;
 
 #ifdef USE_NNTP
   char *followup_to = NULL;
@@ -2245,7 +2323,8 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
     mutt_file_fclose(&rd.fp);
     return -1;
   }
-  unlink(fname);
+  if (!(flags & MUTT_PAGER_KEEPFILE))
+    unlink(fname);
 
   /* Initialize variables */
 
@@ -2333,6 +2412,14 @@ int mutt_pager(const char *banner, const char *fname, int flags, struct Pager *e
     }
     mutt_curs_set(1);
 
+    if ((ch == -2) && IsHeader(extra) && (prefetched_for != extra->email))
+    {
+      /* input timed out: the user is reading, so use the idle time to pull
+       * the next message into the cache before they ask for it */
+      prefetched_for = extra->email;
+      prefetch_next_message(extra->email);
+    }
+
     bool do_new_mail = false;
 
     if (Context && !OptAttachMsg)
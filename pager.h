@@ -54,6 +54,7 @@ extern bool          Tilde;
 #define MUTT_PAGER_ATTACHMENT (1 << 8)
 #define MUTT_PAGER_NOWRAP     (1 << 9)    /**< format for term width, ignore $wrap */
 #define MUTT_PAGER_LOGS       (1 << 10)   /**< Logview mode */
+#define MUTT_PAGER_KEEPFILE   (1 << 11)   /**< caller keeps ownership of the file */
 
 #define MUTT_DISPLAYFLAGS (MUTT_SHOW | MUTT_PAGER_NSKIP | MUTT_PAGER_MARKER | MUTT_PAGER_LOGS)
 
@@ -181,6 +181,20 @@ static struct Pattern *SearchPattern = NULL; /**< current search pattern */
 static char LastSearch[STRING] = { 0 };      /**< last pattern searched for */
 static char LastSearchExpn[LONG_STRING] = { 0 }; /**< expanded version of LastSearch */
 
+/* true while every Email's ->limited bit still reflects Context->pattern,
+ * so an identical limit can be re-applied without re-running the pattern */
+static bool LimitBitsValid = false;
+
+/**
+ * regex_is_literal - Does a regex contain no special characters?
+ * @param s Expression to check
+ * @retval true If the expression would match as a plain substring
+ */
+static bool regex_is_literal(const char *s)
+{
+  return (s[strcspn(s, "^$.[]()|*+?{\\")] == '\0');
+}
+
 /**
  * eat_regex - Parse a regex
  * @param pat  Pattern to match
@@ -218,11 +232,20 @@ static bool eat_regex(struct Pattern *pat, struct Buffer *s, struct Buffer *err)
     pat->p.g = mutt_pattern_group(buf.data);
     FREE(&buf.data);
   }
+  else if (regex_is_literal(buf.data))
+  {
+    /* A literal expression can be matched with strstr() instead of the regex
+     * engine.  For body/header patterns, stringmatch also selects server-side
+     * SEARCH on IMAP: a literal ~b asks for the same substring =b does, and
+     * pushing it down saves fetching every message body. */
+    pat->stringmatch = true;
+    pat->ign_case = mutt_mb_is_lower(buf.data);
+    pat->p.str = buf.data;
+  }
   else
   {
-    pat->p.regex = mutt_mem_malloc(sizeof(regex_t));
     int flags = mutt_mb_is_lower(buf.data) ? REG_ICASE : 0;
-    r = REGCOMP(pat->p.regex, buf.data, REG_NEWLINE | REG_NOSUB | flags);
+    pat->p.regex = mutt_regex_cache_compile(buf.data, REG_NEWLINE | REG_NOSUB | flags, &r);
     if (r != 0)
     {
       regerror(r, pat->p.regex, errmsg, sizeof(errmsg));
@@ -962,6 +985,53 @@ static int patmatch(const struct Pattern *pat, const char *buf)
     return regexec(pat->p.regex, buf, 0, NULL, 0);
 }
 
+/**
+ * search_stream_literal - Search a file region for a literal string
+ * @param fp  File to read, positioned at the start of the region
+ * @param lng Number of bytes to search
+ * @param pat Literal stringmatch Pattern
+ * @retval true If the string was found
+ *
+ * Reads in large blocks instead of line by line, keeping a needle-sized
+ * overlap between blocks so matches straddling a block boundary aren't
+ * missed.  Embedded NUL bytes end a strstr() scan, so each block is scanned
+ * segment by segment.
+ */
+static bool search_stream_literal(FILE *fp, long lng, const struct Pattern *pat)
+{
+  char buf[8192 + 1];
+  const size_t nlen = mutt_str_strlen(pat->p.str);
+  size_t keep = 0;
+
+  while (lng > 0)
+  {
+    size_t want = sizeof(buf) - 1 - keep;
+    if ((long) want > lng)
+      want = lng;
+    const size_t got = fread(buf + keep, 1, want, fp);
+    if (got == 0)
+      break;
+    lng -= got;
+
+    const size_t have = keep + got;
+    buf[have] = '\0';
+
+    for (const char *p = buf; p < (buf + have); p += strlen(p) + 1)
+    {
+      if (pat->ign_case ? strcasestr(p, pat->p.str) : strstr(p, pat->p.str))
+        return true;
+    }
+
+    /* keep the tail in case a match straddles the block boundary */
+    keep = (nlen > 1) ? (nlen - 1) : 0;
+    if (keep > have)
+      keep = have;
+    memmove(buf, buf + have - keep, keep);
+  }
+
+  return false;
+}
+
 /**
  * msg_search - Search an email
  * @param ctx   Mailbox
@@ -969,6 +1039,11 @@ static int patmatch(const struct Pattern *pat, const char *buf)
  * @param msgno Message to search
  * @retval true Pattern found
  * @retval false Error or pattern not found
+ *
+ * XXX - repeated ~b searches re-read every message from disk.  A persistent
+ * body index would have to live outside the header cache: hcache entries are
+ * validated per message by mtime/uidvalidity, while an inverted index needs
+ * folder-wide invalidation and a tokenizer, neither of which exists here.
  */
 static bool msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
 {
@@ -1082,29 +1157,38 @@ static bool msg_search(struct Context *ctx, struct Pattern *pat, int msgno)
     }
   }
 
-  size_t blen = STRING;
-  char *buf = mutt_mem_malloc(blen);
-
-  /* search the file "fp" */
-  while (lng > 0)
+  if ((pat->op != MUTT_HEADER) && pat->stringmatch &&
+      (mutt_str_strlen(pat->p.str) < 4096))
+  {
+    /* literal needle: search in 8KiB blocks instead of line by line */
+    match = search_stream_literal(fp, lng, pat);
+  }
+  else
   {
-    if (pat->op == MUTT_HEADER)
+    size_t blen = STRING;
+    char *buf = mutt_mem_malloc(blen);
+
+    /* search the file "fp" */
+    while (lng > 0)
     {
-      buf = mutt_rfc822_read_line(fp, buf, &blen);
-      if (*buf == '\0')
+      if (pat->op == MUTT_HEADER)
+      {
+        buf = mutt_rfc822_read_line(fp, buf, &blen);
+        if (*buf == '\0')
+          break;
+      }
+      else if (!fgets(buf, blen - 1, fp))
+        break; /* don't loop forever */
+      if (patmatch(pat, buf) == 0)
+      {
+        match = true;
         break;
+      }
+      lng -= mutt_str_strlen(buf);
     }
-    else if (!fgets(buf, blen - 1, fp))
-      break; /* don't loop forever */
-    if (patmatch(pat, buf) == 0)
-    {
-      match = true;
-      break;
-    }
-    lng -= mutt_str_strlen(buf);
-  }
 
-  FREE(&buf);
+    FREE(&buf);
+  }
 
   mx_msg_close(ctx, &msg);
 
@@ -1234,8 +1318,11 @@ void mutt_pattern_free(struct Pattern **pat)
       tmp->p.g = NULL;
     else if (tmp->p.regex)
     {
-      regfree(tmp->p.regex);
-      FREE(&tmp->p.regex);
+      if (!mutt_regex_cache_release(tmp->p.regex))
+      {
+        regfree(tmp->p.regex);
+        FREE(&tmp->p.regex);
+      }
     }
 
     if (tmp->child)
@@ -2184,6 +2271,7 @@ bool mutt_limit_current_thread(struct Email *e)
   Context->mailbox->vcount = 0;
   Context->vsize = 0;
   Context->collapsed = false;
+  IndexLineGen++; /* implicit uncollapse invalidates cached index lines */
 
   for (int i = 0; i < Context->mailbox->msg_count; i++)
   {
@@ -2203,6 +2291,8 @@ bool mutt_limit_current_thread(struct Email *e)
       Context->vsize += (body->length + body->offset - body->hdr_offset);
     }
   }
+  /* the ->limited bits now describe the thread, not Context->pattern */
+  LimitBitsValid = false;
   return true;
 }
 
@@ -2231,6 +2321,44 @@ int mutt_pattern_func(int op, char *prompt)
   simple = mutt_str_strdup(buf);
   mutt_check_simple(buf, sizeof(buf), NONULL(SimpleSearch));
 
+  /* Re-applying the limit that is already in effect is common when flipping
+   * between saved views on a big folder.  If nothing has invalidated the
+   * cached ->limited bits since they were recorded, rebuild the view from
+   * them instead of re-running the pattern against every message. */
+  if ((op == MUTT_LIMIT) && LimitBitsValid && !OptSearchInvalid && Context->pattern)
+  {
+    char oldbuf[LONG_STRING];
+    mutt_str_strfcpy(oldbuf, Context->pattern, sizeof(oldbuf));
+    mutt_check_simple(oldbuf, sizeof(oldbuf), NONULL(SimpleSearch));
+    if (mutt_str_strcmp(oldbuf, buf) == 0)
+    {
+      Context->mailbox->vcount = 0;
+      Context->vsize = 0;
+      Context->collapsed = false;
+      IndexLineGen++; /* implicit uncollapse invalidates cached index lines */
+      padding = mx_msg_padding_size(Context);
+
+      for (int i = 0; i < Context->mailbox->msg_count; i++)
+      {
+        /* re-applying a limit implicitly uncollapses all threads too */
+        Context->mailbox->hdrs[i]->virtual = -1;
+        Context->mailbox->hdrs[i]->collapsed = false;
+        Context->mailbox->hdrs[i]->num_hidden = 0;
+        if (Context->mailbox->hdrs[i]->limited)
+        {
+          Context->mailbox->hdrs[i]->virtual = Context->mailbox->vcount;
+          Context->mailbox->v2r[Context->mailbox->vcount] = i;
+          Context->mailbox->vcount++;
+          struct Body *b = Context->mailbox->hdrs[i]->content;
+          Context->vsize += b->length + b->offset - b->hdr_offset + padding;
+        }
+      }
+      mutt_clear_error();
+      FREE(&simple);
+      return 0;
+    }
+  }
+
   mutt_buffer_init(&err);
   err.dsize = STRING;
   err.data = mutt_mem_malloc(err.dsize);
@@ -2256,6 +2384,7 @@ int mutt_pattern_func(int op, char *prompt)
     Context->mailbox->vcount = 0;
     Context->vsize = 0;
     Context->collapsed = false;
+    IndexLineGen++; /* implicit uncollapse invalidates cached index lines */
     padding = mx_msg_padding_size(Context);
 
     for (int i = 0; i < Context->mailbox->msg_count; i++)
@@ -2328,6 +2457,7 @@ int mutt_pattern_func(int op, char *prompt)
       simple = NULL; /* don't clobber it */
       Context->limit_pattern = mutt_pattern_comp(buf, MUTT_FULL_MSG, &err);
     }
+    LimitBitsValid = true;
   }
 
   rc = 0;
@@ -2402,6 +2532,9 @@ int mutt_search_command(int cur, int op)
   {
     for (int i = 0; i < Context->mailbox->msg_count; i++)
       Context->mailbox->hdrs[i]->searched = false;
+    /* whatever invalidated the search may have changed the messages the
+     * active limit matches; don't let a repeated limit reuse stale bits */
+    LimitBitsValid = false;
 #ifdef USE_IMAP
     if (Context->mailbox->magic == MUTT_IMAP &&
         imap_search(Context->mailbox, SearchPattern) < 0)
@@ -166,14 +166,18 @@ static int fetch_message(char *line, void *file)
 
 /**
  * pop_read_header - Read header
- * @param mdata POP Mailbox data
- * @param e        Email header
+ * @param mdata  POP Mailbox data
+ * @param e      Email header
+ * @param length Message length, from the LIST response
  * @retval  0 Success
  * @retval -1 Connection lost
  * @retval -2 Invalid command or execution error
  * @retval -3 Error writing to tempfile
+ *
+ * The TOP command for @a e must already be on the wire; this reads its
+ * response, which allows the caller to pipeline several commands.
  */
-static int pop_read_header(struct PopMboxData *mdata, struct Email *e)
+static int pop_read_header(struct PopMboxData *mdata, struct Email *e, size_t length)
 {
   FILE *f = mutt_file_mkstemp();
   if (!f)
@@ -182,36 +186,28 @@ static int pop_read_header(struct PopMboxData *mdata, struct Email *e)
     return -3;
   }
 
-  int index = 0;
-  size_t length = 0;
   char buf[LONG_STRING];
 
-  snprintf(buf, sizeof(buf), "LIST %d\r\n", e->refno);
-  int rc = pop_query(mdata, buf, sizeof(buf));
+  int rc = pop_read_status(mdata, "TOP", buf, sizeof(buf));
   if (rc == 0)
-  {
-    sscanf(buf, "+OK %d %zu", &index, &length);
+    rc = pop_read_multiline(mdata, NULL, fetch_message, f);
 
-    snprintf(buf, sizeof(buf), "TOP %d 0\r\n", e->refno);
-    rc = pop_fetch_data(mdata, buf, NULL, fetch_message, f);
-
-    if (mdata->cmd_top == 2)
+  if (mdata->cmd_top == 2)
+  {
+    if (rc == 0)
     {
-      if (rc == 0)
-      {
-        mdata->cmd_top = 1;
+      mdata->cmd_top = 1;
 
-        mutt_debug(1, "set TOP capability\n");
-      }
+      mutt_debug(1, "set TOP capability\n");
+    }
 
-      if (rc == -2)
-      {
-        mdata->cmd_top = 0;
+    if (rc == -2)
+    {
+      mdata->cmd_top = 0;
 
-        mutt_debug(1, "unset TOP capability\n");
-        snprintf(mdata->err_msg, sizeof(mdata->err_msg), "%s",
-                 _("Command TOP is not supported by server"));
-      }
+      mutt_debug(1, "unset TOP capability\n");
+      snprintf(mdata->err_msg, sizeof(mdata->err_msg), "%s",
+               _("Command TOP is not supported by server"));
     }
   }
 
@@ -364,6 +360,33 @@ static header_cache_t *pop_hcache_open(struct PopMboxData *mdata, const char *pa
 }
 #endif
 
+/**
+ * struct PopSizes - Message sizes parsed from a LIST response
+ */
+struct PopSizes
+{
+  int count;     /**< number of entries in sizes */
+  size_t *sizes; /**< message size, indexed by refno (1-based) */
+};
+
+/**
+ * fetch_sizes - parse LIST output
+ * @param line String to parse
+ * @param data PopSizes being filled
+ * @retval 0 Always
+ */
+static int fetch_sizes(char *line, void *data)
+{
+  struct PopSizes *ps = data;
+  int index = 0;
+  size_t size = 0;
+
+  if ((sscanf(line, "%d %zu", &index, &size) == 2) && (index > 0) && (index <= ps->count))
+    ps->sizes[index] = size;
+
+  return 0;
+}
+
 /**
  * pop_fetch_headers - Read headers
  * @param ctx Mailbox
@@ -436,51 +459,94 @@ static int pop_fetch_headers(struct Context *ctx)
           deleted);
     }
 
+    /* one LIST answers every message size; asking per message would cost a
+     * round-trip each */
+    size_t *sizes = mutt_mem_calloc(new_count + 1, sizeof(size_t));
+    struct PopSizes list_sizes = { new_count, sizes };
+    ret = pop_fetch_data(mdata, "LIST\r\n", NULL, fetch_sizes, &list_sizes);
+
+    /* Classify and send ahead of the message being parsed: with the
+     * PIPELINING capability (RFC2449) a window of TOP commands is on the
+     * wire while earlier responses are read back.  Without it the window
+     * is one command, the old lock-step behaviour. */
+    bool *hcached_list = mutt_mem_calloc(MAX(new_count - old_count, 1), sizeof(bool));
+    int sent = old_count; /* next message to classify and request */
+    int inflight = 0;     /* TOP commands awaiting their response */
+
     bool hcached = false;
-    for (i = old_count; i < new_count; i++)
+    for (i = old_count; (i < new_count) && (ret == 0); i++)
     {
       if (!ctx->mailbox->quiet)
         mutt_progress_update(&progress, i + 1 - old_count, -1);
-      struct PopEmailData *edata = ctx->mailbox->hdrs[i]->data;
-#ifdef USE_HCACHE
-      void *data = mutt_hcache_fetch(hc, edata->uid, strlen(edata->uid));
-      if (data)
+
+      /* top up the send window; while TOP is unconfirmed (cmd_top == 2)
+       * keep it at a single command */
+      const int window =
+          (mdata->pipelining && (mdata->cmd_top == 1)) ? POP_PIPELINE_DEPTH : 1;
+      while ((sent < new_count) && (inflight < window))
       {
-        /* Detach the private data */
-        ctx->mailbox->hdrs[i]->data = NULL;
-
-        int refno = ctx->mailbox->hdrs[i]->refno;
-        int index = ctx->mailbox->hdrs[i]->index;
-        /* - POP dynamically numbers headers and relies on e->refno
-         *   to map messages; so restore header and overwrite restored
-         *   refno with current refno, same for index
-         * - e->data needs to a separate pointer as it's driver-specific
-         *   data freed separately elsewhere
-         *   (the old e->data should point inside a malloc'd block from
-         *   hcache so there shouldn't be a memleak here)
-         */
-        struct Email *e = mutt_hcache_restore((unsigned char *) data);
-        mutt_hcache_free(hc, &data);
-        mutt_email_free(&ctx->mailbox->hdrs[i]);
-        ctx->mailbox->hdrs[i] = e;
-        ctx->mailbox->hdrs[i]->refno = refno;
-        ctx->mailbox->hdrs[i]->index = index;
-
-        /* Reattach the private data */
-        ctx->mailbox->hdrs[i]->data = edata;
-        ret = 0;
-        hcached = true;
-      }
-      else
+#ifdef USE_HCACHE
+        struct PopEmailData *sdata = ctx->mailbox->hdrs[sent]->data;
+        void *data = mutt_hcache_fetch(hc, sdata->uid, strlen(sdata->uid));
+        if (data)
+        {
+          /* Detach the private data */
+          ctx->mailbox->hdrs[sent]->data = NULL;
+
+          int refno = ctx->mailbox->hdrs[sent]->refno;
+          int index = ctx->mailbox->hdrs[sent]->index;
+          /* - POP dynamically numbers headers and relies on e->refno
+           *   to map messages; so restore header and overwrite restored
+           *   refno with current refno, same for index
+           * - e->data needs to a separate pointer as it's driver-specific
+           *   data freed separately elsewhere
+           *   (the old e->data should point inside a malloc'd block from
+           *   hcache so there shouldn't be a memleak here)
+           */
+          struct Email *e = mutt_hcache_restore((unsigned char *) data);
+          mutt_hcache_free(hc, &data);
+          mutt_email_free(&ctx->mailbox->hdrs[sent]);
+          ctx->mailbox->hdrs[sent] = e;
+          ctx->mailbox->hdrs[sent]->refno = refno;
+          ctx->mailbox->hdrs[sent]->index = index;
+
+          /* Reattach the private data */
+          ctx->mailbox->hdrs[sent]->data = sdata;
+          hcached_list[sent - old_count] = true;
+        }
+        else
 #endif
-          if ((ret = pop_read_header(mdata, ctx->mailbox->hdrs[i])) < 0)
+        {
+          char buf[LONG_STRING];
+          snprintf(buf, sizeof(buf), "TOP %d 0\r\n", ctx->mailbox->hdrs[sent]->refno);
+          if (mutt_socket_send_d(mdata->conn, buf, MUTT_SOCK_LOG_CMD) < 0)
+          {
+            mdata->status = POP_DISCONNECTED;
+            ret = -1;
+            break;
+          }
+          inflight++;
+        }
+        sent++;
+      }
+      if (ret < 0)
         break;
-#ifdef USE_HCACHE
-      else
+
+      struct PopEmailData *edata = ctx->mailbox->hdrs[i]->data;
+      hcached = hcached_list[i - old_count];
+      if (!hcached)
       {
+        const int refno = ctx->mailbox->hdrs[i]->refno;
+        const size_t length =
+            ((refno > 0) && (refno <= new_count)) ? sizes[refno] : 0;
+        ret = pop_read_header(mdata, ctx->mailbox->hdrs[i], length);
+        inflight--;
+        if (ret < 0)
+          break;
+#ifdef USE_HCACHE
         mutt_hcache_store(hc, edata->uid, strlen(edata->uid), ctx->mailbox->hdrs[i], 0);
-      }
 #endif
+      }
 
       /* faked support for flags works like this:
        * - if 'hcached' is true, we have the message in our hcache:
@@ -513,6 +579,9 @@ static int pop_fetch_headers(struct Context *ctx)
       ctx->mailbox->msg_count++;
     }
 
+    FREE(&sizes);
+    FREE(&hcached_list);
+
     if (i > old_count)
       mx_update_context(ctx, i - old_count);
   }
@@ -1006,8 +1075,11 @@ static int pop_msg_open(struct Context *ctx, struct Message *msg, int msgno)
       return -1;
     }
 
-    mutt_progress_init(&progressbar, _("Fetching message..."), MUTT_PROGRESS_SIZE,
-                       NetInc, e->content->length + e->content->offset - 1);
+    if (!ctx->mailbox->quiet)
+    {
+      mutt_progress_init(&progressbar, _("Fetching message..."), MUTT_PROGRESS_SIZE,
+                         NetInc, e->content->length + e->content->offset - 1);
+    }
 
     /* see if we can put in body cache; use our cache as fallback */
     msg->fp = mutt_bcache_put(mdata->bcache, cache_id(edata->uid));
@@ -1026,7 +1098,9 @@ static int pop_msg_open(struct Context *ctx, struct Message *msg, int msgno)
 
     snprintf(buf, sizeof(buf), "RETR %d\r\n", e->refno);
 
-    const int ret = pop_fetch_data(mdata, buf, &progressbar, fetch_message, msg->fp);
+    const int ret = pop_fetch_data(mdata, buf,
+                                   ctx->mailbox->quiet ? NULL : &progressbar,
+                                   fetch_message, msg->fp);
     if (ret == 0)
       break;
 
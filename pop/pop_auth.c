@@ -379,6 +379,7 @@ static enum PopAuthRes pop_auth_oauth(struct PopMboxData *mdata, const char *met
     decoded_err[len] = '\0';
     err = decoded_err;
   }
+  mutt_account_forget_oauthbearer(&mdata->conn->account);
   mutt_error("%s %s", _("Authentication failed"), err);
 
   return POP_A_FAILURE;
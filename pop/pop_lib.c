@@ -152,6 +152,9 @@ static int fetch_capa(char *line, void *data)
   else if (mutt_str_strncasecmp(line, "TOP", 3) == 0)
     mdata->cmd_top = 1;
 
+  else if (mutt_str_strncasecmp(line, "PIPELINING", 10) == 0)
+    mdata->pipelining = true;
+
   return 0;
 }
 
@@ -204,6 +207,7 @@ static int pop_capabilities(struct PopMboxData *mdata, int mode)
     mdata->cmd_user = 0;
     mdata->cmd_uidl = 0;
     mdata->cmd_top = 0;
+    mdata->pipelining = false;
     mdata->resp_codes = false;
     mdata->expire = true;
     mdata->login_delay = 0;
@@ -493,31 +497,54 @@ int pop_query_d(struct PopMboxData *mdata, char *buf, size_t buflen, char *msg)
 }
 
 /**
- * pop_fetch_data - Read Headers with callback function
- * @param mdata POP Mailbox data
- * @param query       POP query to send to server
+ * pop_read_status - Read the status line of a pipelined command
+ * @param mdata  POP Mailbox data
+ * @param cmd    Command name, for the error message
+ * @param buf    Buffer for the response line
+ * @param buflen Length of buffer
+ * @retval  0 Command was accepted
+ * @retval -1 Connection lost
+ * @retval -2 Command failed
+ *
+ * Counterpart of pop_query_d() for commands that have already been sent,
+ * e.g. a batch queued under the PIPELINING capability.
+ */
+int pop_read_status(struct PopMboxData *mdata, const char *cmd, char *buf, size_t buflen)
+{
+  snprintf(mdata->err_msg, sizeof(mdata->err_msg), "%s: ", cmd);
+
+  if (mutt_socket_readln(buf, buflen, mdata->conn) < 0)
+  {
+    mdata->status = POP_DISCONNECTED;
+    return -1;
+  }
+  if (mutt_str_strncmp(buf, "+OK", 3) == 0)
+    return 0;
+
+  pop_error(mdata, buf);
+  return -2;
+}
+
+/**
+ * pop_read_multiline - Read a multi-line response with callback function
+ * @param mdata       POP Mailbox data
  * @param progressbar Progress bar
- * @param func        Function called for each header read
+ * @param func        Function called for each line read
  * @param data        Data to pass to the callback
  * @retval  0 Successful
  * @retval -1 Connection lost
- * @retval -2 Invalid command or execution error
  * @retval -3 Error in func(*line, *data)
  *
- * This function calls  func(*line, *data)  for each received line,
- * func(NULL, *data)  if  rewind(*data)  needs, exits when fail or done.
+ * Reads up to the terminating "." line; the command's status line must have
+ * been consumed already.
  */
-int pop_fetch_data(struct PopMboxData *mdata, const char *query,
-                   struct Progress *progressbar, int (*func)(char *, void *), void *data)
+int pop_read_multiline(struct PopMboxData *mdata, struct Progress *progressbar,
+                       int (*func)(char *, void *), void *data)
 {
   char buf[LONG_STRING];
   long pos = 0;
   size_t lenbuf = 0;
-
-  mutt_str_strfcpy(buf, query, sizeof(buf));
-  int ret = pop_query(mdata, buf, sizeof(buf));
-  if (ret < 0)
-    return ret;
+  int ret = 0;
 
   char *inbuf = mutt_mem_malloc(sizeof(buf));
 
@@ -563,6 +590,34 @@ int pop_fetch_data(struct PopMboxData *mdata, const char *query,
   return ret;
 }
 
+/**
+ * pop_fetch_data - Read Headers with callback function
+ * @param mdata POP Mailbox data
+ * @param query       POP query to send to server
+ * @param progressbar Progress bar
+ * @param func        Function called for each header read
+ * @param data        Data to pass to the callback
+ * @retval  0 Successful
+ * @retval -1 Connection lost
+ * @retval -2 Invalid command or execution error
+ * @retval -3 Error in func(*line, *data)
+ *
+ * This function calls  func(*line, *data)  for each received line,
+ * func(NULL, *data)  if  rewind(*data)  needs, exits when fail or done.
+ */
+int pop_fetch_data(struct PopMboxData *mdata, const char *query,
+                   struct Progress *progressbar, int (*func)(char *, void *), void *data)
+{
+  char buf[LONG_STRING];
+
+  mutt_str_strfcpy(buf, query, sizeof(buf));
+  const int ret = pop_query(mdata, buf, sizeof(buf));
+  if (ret < 0)
+    return ret;
+
+  return pop_read_multiline(mdata, progressbar, func, data);
+}
+
 /**
  * check_uidl - find message with this UIDL and set refno
  * @param line String containing UIDL
@@ -40,6 +40,9 @@ struct Progress;
 /* maximal length of the server response (RFC1939) */
 #define POP_CMD_RESPONSE 512
 
+/* maximal number of TOP commands in flight when the server pipelines */
+#define POP_PIPELINE_DEPTH 32
+
 /**
  * enum PopStatus - POP server responses
  */
@@ -85,6 +88,7 @@ struct PopMboxData
   unsigned int cmd_user : 2; /**< optional command USER */
   unsigned int cmd_uidl : 2; /**< optional command UIDL */
   unsigned int cmd_top : 2;  /**< optional command TOP */
+  bool pipelining : 1;       /**< server supports command pipelining */
   bool resp_codes : 1;       /**< server supports extended response codes */
   bool expire : 1;           /**< expire is greater than 0 */
   bool clear_cache : 1;
@@ -128,6 +132,9 @@ int pop_parse_path(const char *path, struct ConnAccount *acct);
 int pop_connect(struct PopMboxData *mdata);
 int pop_open_connection(struct PopMboxData *mdata);
 int pop_query_d(struct PopMboxData *mdata, char *buf, size_t buflen, char *msg);
+int pop_read_status(struct PopMboxData *mdata, const char *cmd, char *buf, size_t buflen);
+int pop_read_multiline(struct PopMboxData *mdata, struct Progress *progressbar,
+                       int (*func)(char *, void *), void *data);
 int pop_fetch_data(struct PopMboxData *mdata, const char *query, struct Progress *progressbar,
                    int (*func)(char *, void *), void *data);
 int pop_reconnect(struct Mailbox *mailbox);
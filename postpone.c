@@ -28,6 +28,7 @@
  */
 
 #include "config.h"
+#include <dirent.h>
 #include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -75,6 +76,38 @@ static short PostCount = 0;
 static struct Context *PostContext = NULL;
 static short UpdateNumPostponed = 0;
 
+/**
+ * maildir_count_files - Count the messages in a maildir without parsing them
+ * @param path Path of the maildir
+ * @retval num Number of message files in cur/ and new/
+ *
+ * For the status-line count only the number of messages matters, so there's
+ * no need to open the mailbox and parse every message's headers.
+ */
+static int maildir_count_files(const char *path)
+{
+  char buf[PATH_MAX];
+  int count = 0;
+  static const char *subdirs[] = { "cur", "new" };
+
+  for (size_t i = 0; i < mutt_array_size(subdirs); i++)
+  {
+    snprintf(buf, sizeof(buf), "%s/%s", path, subdirs[i]);
+    DIR *dp = opendir(buf);
+    if (!dp)
+      continue;
+    struct dirent *de = NULL;
+    while ((de = readdir(dp)))
+    {
+      if (*de->d_name != '.')
+        count++;
+    }
+    closedir(dp);
+  }
+
+  return count;
+}
+
 /**
  * mutt_num_postponed - Return the number of postponed messages
  * @param force
@@ -134,6 +167,7 @@ int mutt_num_postponed(bool force)
     return 0;
   }
 
+  bool is_maildir = false;
   if (S_ISDIR(st.st_mode))
   {
     /* if we have a maildir mailbox, we need to stat the "new" dir */
@@ -141,11 +175,15 @@ int mutt_num_postponed(bool force)
     char buf[PATH_MAX];
 
     snprintf(buf, sizeof(buf), "%s/new", Postponed);
-    if (access(buf, F_OK) == 0 && stat(buf, &st) == -1)
+    if (access(buf, F_OK) == 0)
     {
-      PostCount = 0;
-      LastModify = 0;
-      return 0;
+      is_maildir = true;
+      if (stat(buf, &st) == -1)
+      {
+        PostCount = 0;
+        LastModify = 0;
+        return 0;
+      }
     }
   }
 
@@ -158,6 +196,12 @@ int mutt_num_postponed(bool force)
 
     if (access(Postponed, R_OK | F_OK) != 0)
       return PostCount = 0;
+    if (is_maildir)
+    {
+      /* the full parse is deferred until the postponed menu actually opens */
+      PostCount = maildir_count_files(Postponed);
+      return PostCount;
+    }
 #ifdef USE_NNTP
     if (optnews)
       OptNews = false;
@@ -589,7 +633,7 @@ int mutt_prepare_template(FILE *fp, struct Context *ctx, struct Email *newhdr,
    */
   if (resend)
   {
-    FREE(&newhdr->env->message_id);
+    mutt_env_release_id(&newhdr->env->message_id);
     FREE(&newhdr->env->mail_followup_to);
   }
 
@@ -32,6 +32,7 @@
 #include <stdbool.h>
 #include <string.h>
 #include <sys/time.h>
+#include <time.h>
 #include "mutt/mutt.h"
 #include "progress.h"
 #include "curs_lib.h"
@@ -42,6 +43,29 @@
 /* These Config Variables are only used in progress.c */
 short TimeInc; ///< Config: Frequency of progress bar updates (milliseconds)
 
+/**
+ * progress_timestamp - Get a millisecond timestamp for throttling updates
+ * @retval num Milliseconds from an arbitrary origin
+ *
+ * Prefer the monotonic clock: a wall-clock step (ntp, DST) must not freeze
+ * the progress bar for TimeInc, nor let it flood the screen.
+ */
+static unsigned int progress_timestamp(void)
+{
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+    return ((unsigned int) ts.tv_sec * 1000) + (unsigned int) (ts.tv_nsec / 1000000);
+#endif
+  struct timeval tv;
+  if (gettimeofday(&tv, NULL) < 0)
+  {
+    mutt_debug(1, "gettimeofday failed: %d\n", errno);
+    return 0;
+  }
+  return ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
+}
+
 /**
  * message_bar - Draw a colourful progress bar
  * @param percent %age complete
@@ -113,8 +137,6 @@ static void message_bar(int percent, const char *fmt, ...)
 void mutt_progress_init(struct Progress *progress, const char *msg,
                         unsigned short flags, unsigned short inc, size_t size)
 {
-  struct timeval tv = { 0, 0 };
-
   if (!progress)
     return;
   if (OptNoCurses)
@@ -143,14 +165,10 @@ void mutt_progress_init(struct Progress *progress, const char *msg,
       mutt_message(msg);
     return;
   }
-  if (gettimeofday(&tv, NULL) < 0)
-    mutt_debug(1, "gettimeofday failed: %d\n", errno);
+  progress->start = progress_timestamp();
   /* if timestamp is 0 no time-based suppression is done */
   if (TimeInc != 0)
-  {
-    progress->timestamp =
-        ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
-  }
+    progress->timestamp = progress->start;
   mutt_progress_update(progress, 0, 0);
 }
 
@@ -170,8 +188,8 @@ void mutt_progress_init(struct Progress *progress, const char *msg,
 void mutt_progress_update(struct Progress *progress, long pos, int percent)
 {
   char posstr[SHORT_STRING];
+  char etastr[SHORT_STRING] = { 0 };
   bool update = false;
-  struct timeval tv = { 0, 0 };
   unsigned int now = 0;
 
   if (OptNoCurses)
@@ -190,9 +208,9 @@ void mutt_progress_update(struct Progress *progress, long pos, int percent)
     update = true;
 
   /* skip refresh if not enough time has passed */
-  if (update && progress->timestamp && (gettimeofday(&tv, NULL) == 0))
+  if (update && progress->timestamp)
   {
-    now = ((unsigned int) tv.tv_sec * 1000) + (unsigned int) (tv.tv_usec / 1000);
+    now = progress_timestamp();
     if (now && ((now - progress->timestamp) < TimeInc))
       update = false;
   }
@@ -217,14 +235,27 @@ void mutt_progress_update(struct Progress *progress, long pos, int percent)
     if (now)
       progress->timestamp = now;
 
+    /* estimate the remaining time from the throughput so far, but only once
+     * a second has elapsed - early rates are noise */
+    if ((progress->size > 0) && (progress->pos > 0))
+    {
+      unsigned int elapsed = progress_timestamp() - progress->start;
+      if (elapsed >= 1000)
+      {
+        long eta = (progress->size - progress->pos) * (elapsed / 1000) / progress->pos;
+        snprintf(etastr, sizeof(etastr), " ETA %ld:%02ld", eta / 60, eta % 60);
+      }
+    }
+
     if (progress->size > 0)
     {
       message_bar(
           (percent > 0) ? percent :
                           (int) (100.0 * (double) progress->pos / progress->size),
-          "%s %s/%s (%d%%)", progress->msg, posstr, progress->sizestr,
+          "%s %s/%s (%d%%)%s", progress->msg, posstr, progress->sizestr,
           (percent > 0) ? percent :
-                          (int) (100.0 * (double) progress->pos / progress->size));
+                          (int) (100.0 * (double) progress->pos / progress->size),
+          etastr);
     }
     else
     {
@@ -42,6 +42,7 @@ struct Progress
   const char *msg;
   long pos;
   size_t size;
+  unsigned int start;
   unsigned int timestamp;
   char sizestr[SHORT_STRING];
 };
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 #include "mutt/mutt.h"
 #include "email/lib.h"
 #include "mutt.h"
@@ -43,6 +44,7 @@
 #include "send.h"
 
 /* These Config Variables are only used in query.c */
+short QueryCacheTtl; ///< Config: Lifetime (in seconds) of cached $query_command results
 char *QueryCommand; ///< Config: External command to query and external address book
 char *QueryFormat; ///< Config: printf-like format string for the query menu (address book)
 
@@ -120,6 +122,117 @@ static void free_query(struct Query **query)
   }
 }
 
+/**
+ * copy_query - Deep-copy a list of Query results
+ * @param src List to copy
+ * @retval ptr Copied list
+ */
+static struct Query *copy_query(const struct Query *src)
+{
+  struct Query *first = NULL, *cur = NULL;
+
+  for (; src; src = src->next)
+  {
+    struct Query *q = mutt_mem_calloc(1, sizeof(struct Query));
+    q->addr = mutt_addr_copy_list(src->addr, false);
+    q->name = mutt_str_strdup(src->name);
+    q->other = mutt_str_strdup(src->other);
+    if (cur)
+      cur->next = q;
+    else
+      first = q;
+    cur = q;
+  }
+  return first;
+}
+
+/**
+ * struct QueryCache - Remembered results of one $query_command run
+ *
+ * The cache is a short most-recently-used-first list, keyed by the exact
+ * command line that was run (so a $query_command changed by a hook can't
+ * serve another account's results).
+ */
+struct QueryCache
+{
+  char *cmd;              /**< command line that produced the results */
+  struct Query *results;  /**< what it returned */
+  time_t when;            /**< when it ran */
+  struct QueryCache *next;
+};
+
+static struct QueryCache *QueryCacheList = NULL;
+static int QueryCacheCount = 0;
+
+#define QUERY_CACHE_MAX_ENTRIES 64
+
+/**
+ * query_cache_free - Free one cache entry
+ * @param qc Entry to free
+ */
+static void query_cache_free(struct QueryCache *qc)
+{
+  free_query(&qc->results);
+  FREE(&qc->cmd);
+  FREE(&qc);
+}
+
+/**
+ * query_cache_lookup - Find unexpired cached results for a command line
+ * @param cmd Command line about to be run
+ * @retval ptr  Deep copy of the cached results
+ * @retval NULL Nothing cached (or entry expired)
+ *
+ * A hit is moved to the front of the list; an expired entry is dropped.
+ */
+static struct Query *query_cache_lookup(const char *cmd)
+{
+  struct QueryCache *qc = NULL, **prev = &QueryCacheList;
+
+  for (qc = QueryCacheList; qc; prev = &qc->next, qc = qc->next)
+  {
+    if (mutt_str_strcmp(qc->cmd, cmd) != 0)
+      continue;
+
+    *prev = qc->next;
+    if (time(NULL) > (qc->when + QueryCacheTtl))
+    {
+      QueryCacheCount--;
+      query_cache_free(qc);
+      return NULL;
+    }
+    qc->next = QueryCacheList;
+    QueryCacheList = qc;
+    return copy_query(qc->results);
+  }
+  return NULL;
+}
+
+/**
+ * query_cache_insert - Remember the results of a command line
+ * @param cmd     Command line that was run
+ * @param results Results to remember (the cache takes its own copy)
+ */
+static void query_cache_insert(const char *cmd, const struct Query *results)
+{
+  struct QueryCache *qc = mutt_mem_calloc(1, sizeof(struct QueryCache));
+  qc->cmd = mutt_str_strdup(cmd);
+  qc->results = copy_query(results);
+  qc->when = time(NULL);
+  qc->next = QueryCacheList;
+  QueryCacheList = qc;
+
+  if (++QueryCacheCount > QUERY_CACHE_MAX_ENTRIES)
+  {
+    struct QueryCache **prev = &QueryCacheList;
+    while ((*prev)->next)
+      prev = &(*prev)->next;
+    query_cache_free(*prev);
+    *prev = NULL;
+    QueryCacheCount--;
+  }
+}
+
 /**
  * run_query - Run an external program to find Addresses
  * @param s     String to match
@@ -141,6 +254,13 @@ static struct Query *run_query(char *s, int quiet)
 
   mutt_file_expand_fmt_quote(cmd, sizeof(cmd), QueryCommand, s);
 
+  if (QueryCacheTtl > 0)
+  {
+    first = query_cache_lookup(cmd);
+    if (first)
+      return first;
+  }
+
   thepid = mutt_create_filter(cmd, NULL, &fp, NULL);
   if (thepid < 0)
   {
@@ -192,6 +312,8 @@ static struct Query *run_query(char *s, int quiet)
   {
     if (!quiet)
       mutt_message("%s", msg);
+    if (first && (QueryCacheTtl > 0))
+      query_cache_insert(cmd, first);
   }
 
   return first;
@@ -26,6 +26,7 @@
 #include <stdio.h>
 
 /* These Config Variables are only used in query.c */
+extern short QueryCacheTtl;
 extern char *QueryCommand;
 extern char *QueryFormat;
 
@@ -37,6 +37,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include "mutt/mutt.h"
 #include "email/lib.h"
 #include "mutt.h"
@@ -193,6 +194,105 @@ static int get_field_text(char *field, char **entry, char *type, char *filename,
   }
 }
 
+/**
+ * struct MailcapFile - Cached logical lines of one mailcap file
+ *
+ * Mailcap files are consulted for every attachment view and, with
+ * $implicit_autoview, for every MIME part rendered in the pager.  Re-reading
+ * and re-joining continuation lines each time is pure overhead, so the logical
+ * lines (comments stripped, backslash continuations joined) are kept in memory
+ * and refreshed only when the file changes on disk.  Matching, including the
+ * execution of any "test=" commands, still happens per lookup.
+ */
+struct MailcapFile
+{
+  char *path;             /**< Absolute path of the mailcap file */
+  time_t mtime;           /**< Modification time when the file was read */
+  off_t size;             /**< Size in bytes when the file was read */
+  char **lines;           /**< Logical lines of the file */
+  int *line_nums;         /**< Line number of each logical line, for errors */
+  int num_lines;          /**< Number of entries in lines/line_nums */
+  struct MailcapFile *next;
+};
+
+static struct MailcapFile *MailcapCache = NULL;
+
+/**
+ * mailcap_file_free_lines - Release the cached lines of a mailcap file
+ * @param mc Cached mailcap file
+ */
+static void mailcap_file_free_lines(struct MailcapFile *mc)
+{
+  for (int i = 0; i < mc->num_lines; i++)
+    FREE(&mc->lines[i]);
+  FREE(&mc->lines);
+  FREE(&mc->line_nums);
+  mc->num_lines = 0;
+}
+
+/**
+ * mailcap_file_load - Get the cached lines of a mailcap file
+ * @param path Path of the mailcap file
+ * @retval ptr  Cached file contents
+ * @retval NULL File doesn't exist or can't be read
+ *
+ * The cache entry is reused as long as the file's mtime and size are
+ * unchanged, so edits to a mailcap file are picked up on the next lookup.
+ */
+static struct MailcapFile *mailcap_file_load(const char *path)
+{
+  struct stat sb;
+  struct MailcapFile *mc = NULL;
+
+  for (mc = MailcapCache; mc; mc = mc->next)
+    if (mutt_str_strcmp(mc->path, path) == 0)
+      break;
+
+  if (stat(path, &sb) != 0)
+    return NULL;
+
+  if (mc && (mc->mtime == sb.st_mtime) && (mc->size == sb.st_size))
+    return mc;
+
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+    return NULL;
+
+  if (!mc)
+  {
+    mc = mutt_mem_calloc(1, sizeof(struct MailcapFile));
+    mc->path = mutt_str_strdup(path);
+    mc->next = MailcapCache;
+    MailcapCache = mc;
+  }
+  else
+    mailcap_file_free_lines(mc);
+
+  char *buf = NULL;
+  size_t buflen;
+  int line = 0;
+  while ((buf = mutt_file_read_line(buf, &buflen, fp, &line, MUTT_CONT)))
+  {
+    /* ignore comments */
+    if ((*buf == '#') || (*buf == '\0'))
+      continue;
+    if ((mc->num_lines % 32) == 0)
+    {
+      mutt_mem_realloc(&mc->lines, (mc->num_lines + 32) * sizeof(char *));
+      mutt_mem_realloc(&mc->line_nums, (mc->num_lines + 32) * sizeof(int));
+    }
+    mc->lines[mc->num_lines] = mutt_str_strdup(buf);
+    mc->line_nums[mc->num_lines] = line;
+    mc->num_lines++;
+  }
+  FREE(&buf);
+  mutt_file_fclose(&fp);
+
+  mc->mtime = sb.st_mtime;
+  mc->size = sb.st_size;
+  return mc;
+}
+
 /**
  * rfc1524_mailcap_parse - Parse a mailcap entry
  * @param a        Email Body
@@ -227,15 +327,14 @@ static int rfc1524_mailcap_parse(struct Body *a, char *filename, char *type,
     return false;
   const int btlen = ch - type;
 
-  FILE *fp = fopen(filename, "r");
-  if (fp)
+  struct MailcapFile *mc = mailcap_file_load(filename);
+  if (mc)
   {
-    size_t buflen;
-    while (!found && (buf = mutt_file_read_line(buf, &buflen, fp, &line, MUTT_CONT)))
+    for (int i = 0; !found && (i < mc->num_lines); i++)
     {
-      /* ignore comments */
-      if (*buf == '#')
-        continue;
+      line = mc->line_nums[i];
+      /* get_field() pokes NULs into the line, so work on a copy */
+      buf = mutt_str_strdup(mc->lines[i]);
       mutt_debug(2, "mailcap entry: %s\n", buf);
 
       /* check type */
@@ -245,6 +344,7 @@ static int rfc1524_mailcap_parse(struct Body *a, char *filename, char *type,
            (buf[btlen] != 0 &&                           /* implicit wild */
             (mutt_str_strcmp(buf + btlen, "/*") != 0)))) /* wildsubtype */
       {
+        FREE(&buf);
         continue;
       }
 
@@ -379,10 +479,9 @@ static int rfc1524_mailcap_parse(struct Body *a, char *filename, char *type,
           entry->copiousoutput = false;
         }
       }
-    } /* while (!found && (buf = mutt_file_read_line ())) */
-    mutt_file_fclose(&fp);
-  } /* if ((fp = fopen ())) */
-  FREE(&buf);
+      FREE(&buf);
+    } /* for (each cached logical line) */
+  } /* if (mc) */
   return found;
 }
 
@@ -57,6 +57,39 @@ struct Score
 
 static struct Score *ScoreList = NULL;
 
+/* cached result of score_rules_hash(), invalidated by score/unscore */
+static unsigned int ScoreRulesHash = 0;
+
+/**
+ * score_rules_hash - Hash the current score rules and thresholds
+ * @retval num Hash of the rules, never 0
+ *
+ * An Email whose score_rules matches this hash was scored with exactly these
+ * rules, so its cached score - typically restored from the header cache - can
+ * be trusted without running the patterns again.
+ */
+static unsigned int score_rules_hash(void)
+{
+  if (ScoreRulesHash != 0)
+    return ScoreRulesHash;
+
+  unsigned int h = 5381;
+
+  for (struct Score *sc = ScoreList; sc; sc = sc->next)
+  {
+    for (const char *p = sc->str; *p; p++)
+      h = (h * 33) + (unsigned char) *p;
+    h = (h * 33) + (unsigned int) sc->val;
+    h = (h * 33) + (unsigned int) sc->exact;
+  }
+  h = (h * 33) + (unsigned int) ScoreThresholdDelete;
+  h = (h * 33) + (unsigned int) ScoreThresholdRead;
+  h = (h * 33) + (unsigned int) ScoreThresholdFlag;
+
+  ScoreRulesHash = h ? h : 5381;
+  return ScoreRulesHash;
+}
+
 /**
  * mutt_check_rescore - Do the emails need to have their scores recalculated?
  * @param ctx Mailbox
@@ -158,6 +191,7 @@ int mutt_parse_score(struct Buffer *buf, struct Buffer *s, unsigned long data,
     mutt_str_strfcpy(err->data, _("Error: score: invalid number"), err->dsize);
     return -1;
   }
+  ScoreRulesHash = 0; /* rules changed, recompute the hash lazily */
   OptNeedRescore = true;
   return 0;
 }
@@ -173,21 +207,29 @@ void mutt_score_message(struct Context *ctx, struct Email *e, bool upd_ctx)
   struct Score *tmp = NULL;
   struct PatternCache cache = { 0 };
 
-  e->score = 0; /* in case of re-scoring */
-  for (tmp = ScoreList; tmp; tmp = tmp->next)
+  /* skip the pattern runs if the score on hand - typically restored from the
+   * header cache - was computed with the current rules; the thresholds below
+   * are cheap and idempotent, so they are always (re-)applied */
+  const unsigned int rules = score_rules_hash();
+  if (e->score_rules != rules)
   {
-    if (mutt_pattern_exec(tmp->pat, MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
+    e->score = 0; /* in case of re-scoring */
+    for (tmp = ScoreList; tmp; tmp = tmp->next)
     {
-      if (tmp->exact || tmp->val == 9999 || tmp->val == -9999)
+      if (mutt_pattern_exec(tmp->pat, MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
       {
-        e->score = tmp->val;
-        break;
+        if (tmp->exact || tmp->val == 9999 || tmp->val == -9999)
+        {
+          e->score = tmp->val;
+          break;
+        }
+        e->score += tmp->val;
       }
-      e->score += tmp->val;
     }
+    if (e->score < 0)
+      e->score = 0;
+    e->score_rules = rules;
   }
-  if (e->score < 0)
-    e->score = 0;
 
   if (e->score <= ScoreThresholdDelete)
     mutt_set_flag_update(ctx, e, MUTT_DELETE, true, upd_ctx);
@@ -243,6 +285,7 @@ int mutt_parse_unscore(struct Buffer *buf, struct Buffer *s, unsigned long data,
       }
     }
   }
+  ScoreRulesHash = 0; /* rules changed, recompute the hash lazily */
   OptNeedRescore = true;
   return 0;
 }
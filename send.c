@@ -460,7 +460,7 @@ static void process_user_header(struct Envelope *env)
       char *tmp = mutt_extract_message_id(uh->data + 11, NULL);
       if (mutt_addr_valid_msgid(tmp))
       {
-        FREE(&env->message_id);
+        mutt_env_release_id(&env->message_id);
         env->message_id = tmp;
       }
       else
@@ -923,7 +923,7 @@ static void make_reference_headers(struct Envelope *curenv,
   if (ctx->tagged > 0 && !STAILQ_EMPTY(&env->in_reply_to) &&
       STAILQ_NEXT(STAILQ_FIRST(&env->in_reply_to), entries))
   {
-    mutt_list_free(&env->references);
+    mutt_env_release_idlist(&env->references);
   }
 }
 
@@ -221,76 +221,32 @@ static void encode_quoted(struct FgetConv *fc, FILE *fout, bool istext)
   }
 }
 
-/**
- * struct B64Context - Cursor for the Base64 conversion
- */
-struct B64Context
-{
-  char buffer[3];
-  short size;
-  short linelen;
-};
-
-/**
- * b64_init - Set up the base64 conversion
- * @param ctx Cursor for the base64 conversion
- * @retval 0 Always
- */
-static int b64_init(struct B64Context *ctx)
-{
-  memset(ctx->buffer, '\0', sizeof(ctx->buffer));
-  ctx->size = 0;
-  ctx->linelen = 0;
-
-  return 0;
-}
+/* 54 input bytes make one 72-character base64 line */
+#define B64_LINE_INPUT 54
 
 /**
- * b64_flush - Save the bytes to the file
- * @param ctx  Cursor for the base64 conversion
- * @param fout File to save the output
+ * b64_write_line - Base64-encode one output line
+ * @param[in]     in    Input bytes, at most #B64_LINE_INPUT of them
+ * @param[in,out] inlen Number of input bytes, reset to zero
+ * @param[in,out] first True until the first line has been written
+ * @param[in]     fout  File to store the result
  */
-static void b64_flush(struct B64Context *ctx, FILE *fout)
+static void b64_write_line(const char *in, size_t *inlen, bool *first, FILE *fout)
 {
-  /* for some reasons, mutt_b64_encode expects the
-   * output buffer to be larger than 10B */
-  char encoded[11];
-  size_t ret;
+  /* mutt_b64_encode() wants more slack in the output buffer than the
+   * encoding itself needs */
+  char encoded[B64_LINE_INPUT * 4 / 3 + 16];
 
-  if (!ctx->size)
+  if (*inlen == 0)
     return;
-
-  if (ctx->linelen >= 72)
-  {
+  if (*first)
+    *first = false;
+  else
     fputc('\n', fout);
-    ctx->linelen = 0;
-  }
 
-  /* ret should always be equal to 4 here, because ctx->size
-   * is a value between 1 and 3 (included), but let's not hardcode it
-   * and prefer the return value of the function */
-  ret = mutt_b64_encode(ctx->buffer, ctx->size, encoded, sizeof(encoded));
-  for (size_t i = 0; i < ret; i++)
-  {
-    fputc(encoded[i], fout);
-    ctx->linelen++;
-  }
-
-  ctx->size = 0;
-}
-
-/**
- * b64_putc - Base64-encode one character
- * @param ctx  Cursor for the base64 conversion
- * @param c    Character to encode
- * @param fout File to save the output
- */
-static void b64_putc(struct B64Context *ctx, char c, FILE *fout)
-{
-  if (ctx->size == 3)
-    b64_flush(ctx, fout);
-
-  ctx->buffer[ctx->size++] = c;
+  const size_t elen = mutt_b64_encode(in, *inlen, encoded, sizeof(encoded));
+  fwrite(encoded, 1, elen, fout);
+  *inlen = 0;
 }
 
 /**
@@ -298,27 +254,43 @@ static void b64_putc(struct B64Context *ctx, char c, FILE *fout)
  * @param fc     Cursor for converting a file's encoding
  * @param fout   File to store the result
  * @param istext Is the input text?
+ *
+ * The input is consumed in blocks and encoded a line at a time, rather than
+ * pushing single bytes through the encoder, so large attachments don't pay a
+ * function call per byte.
  */
 static void encode_base64(struct FgetConv *fc, FILE *fout, int istext)
 {
-  struct B64Context ctx;
-  int ch, ch1 = EOF;
-
-  b64_init(&ctx);
+  char raw[4096];
+  char in[B64_LINE_INPUT];
+  size_t inlen = 0;
+  size_t got;
+  int ch1 = EOF;
+  bool first = true;
 
-  while ((ch = mutt_ch_fgetconv(fc)) != EOF)
+  while ((got = mutt_ch_fgetconv_buf(fc, raw, sizeof(raw))) != 0)
   {
     if (SigInt == 1)
     {
       SigInt = 0;
       return;
     }
-    if (istext && ch == '\n' && ch1 != '\r')
-      b64_putc(&ctx, '\r', fout);
-    b64_putc(&ctx, ch, fout);
-    ch1 = ch;
+    for (size_t i = 0; i < got; i++)
+    {
+      const int ch = (unsigned char) raw[i];
+      if (istext && (ch == '\n') && (ch1 != '\r'))
+      {
+        in[inlen++] = '\r';
+        if (inlen == sizeof(in))
+          b64_write_line(in, &inlen, &first, fout);
+      }
+      in[inlen++] = (char) ch;
+      if (inlen == sizeof(in))
+        b64_write_line(in, &inlen, &first, fout);
+      ch1 = ch;
+    }
   }
-  b64_flush(&ctx, fout);
+  b64_write_line(in, &inlen, &first, fout);
   fputc('\n', fout);
 }
 
@@ -742,9 +714,11 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
                               const char **tocodes, int *tocode, struct Content *info)
 {
   char bufi[256], bufu[512], bufo[4 * sizeof(bufi)];
-  size_t ret;
+  size_t ret = (size_t)(-1);
 
-  const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, 0);
+  /* 1+ncodes descriptors are held at once here, more than the descriptor
+   * cache may track - bypass it and close them below */
+  const iconv_t cd1 = mutt_ch_iconv_open("utf-8", fromcode, MUTT_ICONV_NO_CACHE);
   if (cd1 == (iconv_t)(-1))
     return -1;
 
@@ -756,7 +730,7 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
   for (int i = 0; i < ncodes; i++)
   {
     if (mutt_str_strcasecmp(tocodes[i], "utf-8") != 0)
-      cd[i] = mutt_ch_iconv_open(tocodes[i], "utf-8", 0);
+      cd[i] = mutt_ch_iconv_open(tocodes[i], "utf-8", MUTT_ICONV_NO_CACHE);
     else
     {
       /* Special case for conversion to UTF-8 */
@@ -860,8 +834,8 @@ static size_t convert_file_to(FILE *file, const char *fromcode, int ncodes,
   for (int i = 0; i < ncodes; i++)
     if (cd[i] != (iconv_t)(-1))
       iconv_close(cd[i]);
-
   iconv_close(cd1);
+
   FREE(&cd);
   FREE(&infos);
   FREE(&score);
@@ -898,7 +872,7 @@ static size_t convert_file_from_to(FILE *file, const char *fromcodes, const char
   char **tcode = NULL;
   const char *c = NULL, *c1 = NULL;
   size_t ret;
-  int ncodes, i, cn;
+  int ncodes, i, cn = 0;
 
   /* Count the tocodes */
   ncodes = 0;
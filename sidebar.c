@@ -76,11 +76,19 @@ struct SbEntry
   char box[STRING];        /**< formatted mailbox name */
   struct Mailbox *mailbox; /**< Mailbox this represents */
   bool is_hidden;          /**< Don't show, e.g. $sidebar_new_mail_only */
+  char display[STRING];    /**< cached formatted sidebar line */
+  int display_gen;         /**< value of IndexLineGen at format time */
+  int display_width;       /**< screen cells the cached line was made for */
+  int display_count;       /**< counts the cached line was made from */
+  int display_unread;
+  int display_flagged;
+  bool display_new;
 };
 
 static int EntryCount = 0;
 static int EntryLen = 0;
 static struct SbEntry **Entries = NULL;
+static bool EntriesUnsorted = false; /**< Entries added since the last sort */
 
 static int TopIndex = -1; /**< First mailbox visible in sidebar */
 static int OpnIndex = -1; /**< Current (open) mailbox */
@@ -443,11 +451,18 @@ static void sort_entries(void)
 {
   short ssm = (SidebarSortMethod & SORT_MASK);
 
-  /* These are the only sort methods we understand */
-  if ((ssm == SORT_COUNT) || (ssm == SORT_UNREAD) || (ssm == SORT_FLAGGED) || (ssm == SORT_PATH))
+  /* These are the only sort methods we understand.
+   * The count-keyed orderings depend on totals that change without us being
+   * notified, so they must be redone on every draw.  A path ordering only
+   * goes stale when the list itself or the sort method changes. */
+  if ((ssm == SORT_COUNT) || (ssm == SORT_UNREAD) || (ssm == SORT_FLAGGED))
     qsort(Entries, EntryCount, sizeof(*Entries), cb_qsort_sbe);
-  else if ((ssm == SORT_ORDER) && (SidebarSortMethod != PreviousSort))
+  else if ((ssm == SORT_PATH) && (EntriesUnsorted || (SidebarSortMethod != PreviousSort)))
+    qsort(Entries, EntryCount, sizeof(*Entries), cb_qsort_sbe);
+  else if ((ssm == SORT_ORDER) && (EntriesUnsorted || (SidebarSortMethod != PreviousSort)))
     unsort_entries();
+
+  EntriesUnsorted = false;
 }
 
 /**
@@ -863,8 +878,9 @@ static void draw_sidebar(int num_rows, int num_cols, int div_width)
       col = div_width;
 
     mutt_window_move(MuttSidebarWindow, row, col);
-    if (Context && (Context->mailbox->realpath[0] != '\0') &&
-        (mutt_str_strcmp(m->realpath, Context->mailbox->realpath) == 0))
+    const bool open_ctx = Context && (Context->mailbox->realpath[0] != '\0') &&
+                          (mutt_str_strcmp(m->realpath, Context->mailbox->realpath) == 0);
+    if (open_ctx)
     {
 #ifdef USE_NOTMUCH
       if (m->magic == MUTT_NOTMUCH)
@@ -878,6 +894,20 @@ static void draw_sidebar(int num_rows, int num_cols, int div_width)
       m->msg_flagged = Context->mailbox->msg_flagged;
     }
 
+    /* The open mailbox pulls %d/%t/%L out of Context, so it can't be cached;
+     * any other entry can reuse its last formatted line while the counts
+     * that feed $sidebar_format are unchanged.  Config changes bump
+     * IndexLineGen, which retires every cached line at once. */
+    if (!open_ctx && (entry->display_gen == IndexLineGen) &&
+        (entry->display_width == w) && (entry->display_count == m->msg_count) &&
+        (entry->display_unread == m->msg_unread) &&
+        (entry->display_flagged == m->msg_flagged) && (entry->display_new == m->has_new))
+    {
+      printw("%s", entry->display);
+      row++;
+      continue;
+    }
+
     /* compute length of Folder without trailing separator */
     size_t maildirlen = mutt_str_strlen(Folder);
     if (maildirlen && SidebarDelimChars && strchr(SidebarDelimChars, Folder[maildirlen - 1]))
@@ -953,9 +983,14 @@ static void draw_sidebar(int num_rows, int num_cols, int div_width)
         mutt_str_strcat(sidebar_folder_name, sfn_len, tmp_folder_name);
       }
     }
-    char str[STRING];
-    make_sidebar_entry(str, sizeof(str), w, sidebar_folder_name, entry);
-    printw("%s", str);
+    make_sidebar_entry(entry->display, sizeof(entry->display), w, sidebar_folder_name, entry);
+    entry->display_gen = IndexLineGen;
+    entry->display_width = w;
+    entry->display_count = m->msg_count;
+    entry->display_unread = m->msg_unread;
+    entry->display_flagged = m->msg_flagged;
+    entry->display_new = m->has_new;
+    printw("%s", entry->display);
     if (sidebar_folder_depth > 0)
       FREE(&sidebar_folder_name);
     row++;
@@ -1130,6 +1165,7 @@ void mutt_sb_notify_mailbox(struct Mailbox *m, bool created)
     }
     Entries[EntryCount] = mutt_mem_calloc(1, sizeof(struct SbEntry));
     Entries[EntryCount]->mailbox = m;
+    EntriesUnsorted = true;
 
     if (TopIndex < 0)
       TopIndex = EntryCount;
@@ -75,12 +75,35 @@ enum SmtpCapability
   DSN,
   EIGHTBITMIME,
   SMTPUTF8,
+  PIPELINING,
 
   CAPMAX
 };
 
-static char *AuthMechs = NULL;
-static unsigned char Capabilities[(CAPMAX + 7) / 8];
+/**
+ * struct SmtpData - SMTP-specific Connection data
+ *
+ * Connections are kept alive per account, so the capabilities announced by a
+ * server's EHLO must live with the Connection they were read from - a static
+ * would leak one server's capabilities into another's session.
+ */
+struct SmtpData
+{
+  unsigned char capabilities[(CAPMAX + 7) / 8];
+  char *auth_mechs;
+};
+
+/**
+ * smtp_conn_data - Get a Connection's SMTP data, creating it if necessary
+ * @param conn SMTP Connection
+ * @retval ptr SMTP data attached to the Connection
+ */
+static struct SmtpData *smtp_conn_data(struct Connection *conn)
+{
+  if (!conn->data)
+    conn->data = mutt_mem_calloc(1, sizeof(struct SmtpData));
+  return conn->data;
+}
 
 /**
  * valid_smtp_code - Is the is a valid SMTP return code?
@@ -114,6 +137,7 @@ static int smtp_get_resp(struct Connection *conn)
 {
   int n;
   char buf[1024];
+  struct SmtpData *sdata = smtp_conn_data(conn);
 
   do
   {
@@ -125,19 +149,21 @@ static int smtp_get_resp(struct Connection *conn)
     }
 
     if (mutt_str_strncasecmp("8BITMIME", buf + 4, 8) == 0)
-      mutt_bit_set(Capabilities, EIGHTBITMIME);
+      mutt_bit_set(sdata->capabilities, EIGHTBITMIME);
     else if (mutt_str_strncasecmp("AUTH ", buf + 4, 5) == 0)
     {
-      mutt_bit_set(Capabilities, AUTH);
-      FREE(&AuthMechs);
-      AuthMechs = mutt_str_strdup(buf + 9);
+      mutt_bit_set(sdata->capabilities, AUTH);
+      FREE(&sdata->auth_mechs);
+      sdata->auth_mechs = mutt_str_strdup(buf + 9);
     }
     else if (mutt_str_strncasecmp("DSN", buf + 4, 3) == 0)
-      mutt_bit_set(Capabilities, DSN);
+      mutt_bit_set(sdata->capabilities, DSN);
     else if (mutt_str_strncasecmp("STARTTLS", buf + 4, 8) == 0)
-      mutt_bit_set(Capabilities, STARTTLS);
+      mutt_bit_set(sdata->capabilities, STARTTLS);
     else if (mutt_str_strncasecmp("SMTPUTF8", buf + 4, 8) == 0)
-      mutt_bit_set(Capabilities, SMTPUTF8);
+      mutt_bit_set(sdata->capabilities, SMTPUTF8);
+    else if (mutt_str_strncasecmp("PIPELINING", buf + 4, 10) == 0)
+      mutt_bit_set(sdata->capabilities, PIPELINING);
 
     if (!valid_smtp_code(buf, n, &n))
       return SMTP_ERR_CODE;
@@ -153,15 +179,18 @@ static int smtp_get_resp(struct Connection *conn)
 
 /**
  * smtp_rcpt_to - Set the recipient to an Address
- * @param conn Server Connection
- * @param a    Address to use
+ * @param conn    Server Connection
+ * @param a       Address to use
+ * @param pending If not NULL, pipeline the commands (RFC2920) and count them
+ *                here instead of reading a response after each one
  * @retval  0 Success
  * @retval <0 Error, e.g. #SMTP_ERR_WRITE
  */
-static int smtp_rcpt_to(struct Connection *conn, const struct Address *a)
+static int smtp_rcpt_to(struct Connection *conn, const struct Address *a, int *pending)
 {
   char buf[1024];
   int r;
+  struct SmtpData *sdata = smtp_conn_data(conn);
 
   while (a)
   {
@@ -171,15 +200,20 @@ static int smtp_rcpt_to(struct Connection *conn, const struct Address *a)
       a = a->next;
       continue;
     }
-    if (mutt_bit_isset(Capabilities, DSN) && DsnNotify)
+    if (mutt_bit_isset(sdata->capabilities, DSN) && DsnNotify)
       snprintf(buf, sizeof(buf), "RCPT TO:<%s> NOTIFY=%s\r\n", a->mailbox, DsnNotify);
     else
       snprintf(buf, sizeof(buf), "RCPT TO:<%s>\r\n", a->mailbox);
     if (mutt_socket_send(conn, buf) == -1)
       return SMTP_ERR_WRITE;
-    r = smtp_get_resp(conn);
-    if (r != 0)
-      return r;
+    if (pending)
+      (*pending)++;
+    else
+    {
+      r = smtp_get_resp(conn);
+      if (r != 0)
+        return r;
+    }
     a = a->next;
   }
 
@@ -364,8 +398,10 @@ static int smtp_helo(struct Connection *conn, bool esmtp)
 {
   char buf[LONG_STRING];
   const char *fqdn = NULL;
+  struct SmtpData *sdata = smtp_conn_data(conn);
 
-  memset(Capabilities, 0, sizeof(Capabilities));
+  memset(sdata->capabilities, 0, sizeof(sdata->capabilities));
+  FREE(&sdata->auth_mechs);
 
   if (!esmtp)
   {
@@ -528,7 +564,10 @@ static int smtp_auth_oauth(struct Connection *conn)
   if (rc == -1)
     return SMTP_AUTH_FAIL;
   if (smtp_get_resp(conn) != 0)
+  {
+    mutt_account_forget_oauthbearer(&conn->account);
     return SMTP_AUTH_FAIL;
+  }
 
   return SMTP_AUTH_SUCCESS;
 }
@@ -631,7 +670,7 @@ static int smtp_auth(struct Connection *conn)
   else
   {
 #ifdef USE_SASL
-    r = smtp_auth_sasl(conn, AuthMechs);
+    r = smtp_auth_sasl(conn, smtp_conn_data(conn)->auth_mechs);
 #else
     mutt_error(_("SMTP authentication requires SASL"));
     r = SMTP_AUTH_UNAVAIL;
@@ -663,6 +702,7 @@ static int smtp_auth(struct Connection *conn)
 static int smtp_open(struct Connection *conn, bool esmtp)
 {
   int rc;
+  struct SmtpData *sdata = smtp_conn_data(conn);
 
   if (mutt_socket_open(conn))
     return -1;
@@ -681,7 +721,7 @@ static int smtp_open(struct Connection *conn, bool esmtp)
     rc = MUTT_NO;
   else if (SslForceTls)
     rc = MUTT_YES;
-  else if (mutt_bit_isset(Capabilities, STARTTLS) &&
+  else if (mutt_bit_isset(sdata->capabilities, STARTTLS) &&
            (rc = query_quadoption(SslStarttls,
                                   _("Secure connection with TLS?"))) == MUTT_ABORT)
   {
@@ -711,7 +751,7 @@ static int smtp_open(struct Connection *conn, bool esmtp)
 
   if (conn->account.flags & MUTT_ACCT_USER)
   {
-    if (!mutt_bit_isset(Capabilities, AUTH))
+    if (!mutt_bit_isset(sdata->capabilities, AUTH))
     {
       mutt_error(_("SMTP server does not support authentication"));
       return -1;
@@ -763,24 +803,41 @@ int mutt_smtp_send(const struct Address *from, const struct Address *to,
   if (!conn)
     return -1;
 
+  struct SmtpData *sdata = smtp_conn_data(conn);
+
+  /* reuse the authenticated connection kept from a previous send; the
+   * capabilities recorded by its EHLO live in sdata and still apply */
+  bool reusing = (conn->fd >= 0);
+  bool data_sent = false;
+
+retry:
   do
   {
-    /* send our greeting */
-    rc = smtp_open(conn, eightbit);
-    if (rc != 0)
-      break;
-    FREE(&AuthMechs);
+    if (!reusing)
+    {
+      /* send our greeting */
+      rc = smtp_open(conn, eightbit);
+      if (rc != 0)
+        break;
+    }
+
+    /* with PIPELINING (RFC2920), batch MAIL FROM and all the RCPT TO
+     * commands into one round trip.  DATA stays synchronous: once the
+     * server answers 354 the only way out is sending a message, so it must
+     * not be pipelined behind commands that can still fail. */
+    const bool pipelined = mutt_bit_isset(sdata->capabilities, PIPELINING);
+    int pending = 0;
 
     /* send the sender's address */
     int len = snprintf(buf, sizeof(buf), "MAIL FROM:<%s>", envfrom);
-    if (eightbit && mutt_bit_isset(Capabilities, EIGHTBITMIME))
+    if (eightbit && mutt_bit_isset(sdata->capabilities, EIGHTBITMIME))
     {
       mutt_str_strncat(buf, sizeof(buf), " BODY=8BITMIME", 15);
       len += 14;
     }
-    if (DsnReturn && mutt_bit_isset(Capabilities, DSN))
+    if (DsnReturn && mutt_bit_isset(sdata->capabilities, DSN))
       len += snprintf(buf + len, sizeof(buf) - len, " RET=%s", DsnReturn);
-    if (mutt_bit_isset(Capabilities, SMTPUTF8) &&
+    if (mutt_bit_isset(sdata->capabilities, SMTPUTF8) &&
         (address_uses_unicode(envfrom) || addresses_use_unicode(to) ||
          addresses_use_unicode(cc) || addresses_use_unicode(bcc)))
     {
@@ -792,29 +849,61 @@ int mutt_smtp_send(const struct Address *from, const struct Address *to,
       rc = SMTP_ERR_WRITE;
       break;
     }
-    rc = smtp_get_resp(conn);
-    if (rc != 0)
-      break;
+    if (pipelined)
+      pending++;
+    else
+    {
+      rc = smtp_get_resp(conn);
+      if (rc != 0)
+        break;
+    }
 
     /* send the recipient list */
-    if ((rc = smtp_rcpt_to(conn, to)) || (rc = smtp_rcpt_to(conn, cc)) ||
-        (rc = smtp_rcpt_to(conn, bcc)))
+    if ((rc = smtp_rcpt_to(conn, to, pipelined ? &pending : NULL)) ||
+        (rc = smtp_rcpt_to(conn, cc, pipelined ? &pending : NULL)) ||
+        (rc = smtp_rcpt_to(conn, bcc, pipelined ? &pending : NULL)))
     {
       break;
     }
 
+    /* collect the responses to the pipelined batch, in order */
+    for (; pending > 0; pending--)
+    {
+      const int r = smtp_get_resp(conn);
+      if ((r != 0) && (rc == 0))
+        rc = r;
+      if (r == SMTP_ERR_READ)
+        break;
+    }
+    if (rc != 0)
+      break;
+
     /* send the message data */
+    data_sent = true;
     rc = smtp_data(conn, msgfile);
     if (rc != 0)
       break;
 
-    mutt_socket_send(conn, "QUIT\r\n");
-
     rc = 0;
   } while (0);
 
-  if (conn)
+  if (rc == 0)
+  {
+    /* leave the connection open and authenticated for the next message in
+     * this session, instead of paying connect, TLS and AUTH per send */
+  }
+  else
+  {
     mutt_socket_close(conn);
+    if (reusing && !data_sent && ((rc == SMTP_ERR_READ) || (rc == SMTP_ERR_WRITE)))
+    {
+      /* the kept-alive connection probably idled out; retry once from a
+       * fresh connection.  After DATA the message file is gone, but a
+       * half-dead connection fails at MAIL FROM, well before that. */
+      reusing = false;
+      goto retry;
+    }
+  }
 
   if (rc == SMTP_ERR_READ)
     mutt_error(_("SMTP session failed: read error"));
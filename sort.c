@@ -72,6 +72,91 @@ int perform_auxsort(int retval, const void *a, const void *b)
   return retval;
 }
 
+/**
+ * headers_sorted - Check whether the header array is already in order
+ * @param hdrs     Array of emails
+ * @param count    Number of emails
+ * @param sortfunc Comparison function
+ * @retval true If the array is already sorted
+ */
+static bool headers_sorted(struct Email **hdrs, int count, sort_t *sortfunc)
+{
+  for (int i = 0; i < (count - 1); i++)
+  {
+    if (sortfunc(&hdrs[i], &hdrs[i + 1]) > 0)
+      return false;
+  }
+  return true;
+}
+
+/* collation keys for the string sorts, indexed by Email.index; only
+ * non-NULL while mutt_sort_headers() is running a subject/from sort */
+static char **KeySubj = NULL;
+static char **KeyFrom = NULL;
+static int SortKeyMax = 0;
+
+/**
+ * build_collation_keys - Precompute folded keys for the string sorts
+ * @param hdrs  Array of emails
+ * @param count Number of emails
+ * @param subj  Prepare keys for compare_subject()
+ * @param from  Prepare keys for compare_from()
+ *
+ * Case-folding the same subjects and resolving the same addresses once per
+ * message beats doing it O(n log n) times inside the comparators.  The keys
+ * are indexed by Email.index, the one message number that is stable while
+ * the array is being permuted.
+ */
+static void build_collation_keys(struct Email **hdrs, int count, bool subj, bool from)
+{
+  if (!subj && !from)
+    return;
+
+  int max = 0;
+  for (int i = 0; i < count; i++)
+    if (hdrs[i]->index > max)
+      max = hdrs[i]->index;
+
+  if (subj)
+    KeySubj = mutt_mem_calloc(max + 1, sizeof(char *));
+  if (from)
+    KeyFrom = mutt_mem_calloc(max + 1, sizeof(char *));
+
+  for (int i = 0; i < count; i++)
+  {
+    struct Email *e = hdrs[i];
+    if (subj && e->env->real_subj)
+      KeySubj[e->index] = mutt_str_strlower(mutt_str_strdup(e->env->real_subj));
+    if (from)
+    {
+      char buf[SHORT_STRING];
+      mutt_str_strfcpy(buf, mutt_get_name(e->env->from), sizeof(buf));
+      KeyFrom[e->index] = mutt_str_strdup(mutt_str_strlower(buf));
+    }
+  }
+
+  SortKeyMax = max;
+}
+
+/**
+ * free_collation_keys - Release the keys built by build_collation_keys()
+ */
+static void free_collation_keys(void)
+{
+  if (KeySubj)
+  {
+    for (int i = 0; i <= SortKeyMax; i++)
+      FREE(&KeySubj[i]);
+    FREE(&KeySubj);
+  }
+  if (KeyFrom)
+  {
+    for (int i = 0; i <= SortKeyMax; i++)
+      FREE(&KeyFrom[i]);
+    FREE(&KeyFrom);
+  }
+}
+
 /**
  * compare_score - Compare two emails using their scores - Implements ::sort_t
  */
@@ -117,17 +202,23 @@ static int compare_subject(const void *a, const void *b)
   struct Email **pb = (struct Email **) b;
   int rc;
 
-  if (!(*pa)->env->real_subj)
+  /* the precomputed keys are already case-folded, so a plain strcmp does */
+  const char *sa = KeySubj ? KeySubj[(*pa)->index] : (*pa)->env->real_subj;
+  const char *sb = KeySubj ? KeySubj[(*pb)->index] : (*pb)->env->real_subj;
+
+  if (!sa)
   {
-    if (!(*pb)->env->real_subj)
+    if (!sb)
       rc = compare_date_sent(pa, pb);
     else
       rc = -1;
   }
-  else if (!(*pb)->env->real_subj)
+  else if (!sb)
     rc = 1;
+  else if (KeySubj)
+    rc = strcmp(sa, sb);
   else
-    rc = mutt_str_strcasecmp((*pa)->env->real_subj, (*pb)->env->real_subj);
+    rc = mutt_str_strcasecmp(sa, sb);
   rc = perform_auxsort(rc, a, b);
   return SORTCODE(rc);
 }
@@ -183,10 +274,16 @@ static int compare_from(const void *a, const void *b)
   struct Email **ppa = (struct Email **) a;
   struct Email **ppb = (struct Email **) b;
   char fa[SHORT_STRING];
+  int result;
 
-  mutt_str_strfcpy(fa, mutt_get_name((*ppa)->env->from), SHORT_STRING);
-  const char *fb = mutt_get_name((*ppb)->env->from);
-  int result = mutt_str_strncasecmp(fa, fb, SHORT_STRING);
+  if (KeyFrom)
+    result = strcmp(KeyFrom[(*ppa)->index], KeyFrom[(*ppb)->index]);
+  else
+  {
+    mutt_str_strfcpy(fa, mutt_get_name((*ppa)->env->from), SHORT_STRING);
+    const char *fb = mutt_get_name((*ppb)->env->from);
+    result = mutt_str_strncasecmp(fa, fb, SHORT_STRING);
+  }
   result = perform_auxsort(result, a, b);
   return SORTCODE(result);
 }
@@ -360,6 +457,10 @@ void mutt_sort_headers(struct Context *ctx, bool init)
   if (!ctx)
     return;
 
+  /* sorting renumbers messages and may rebuild thread trees; cached index
+   * lines rendered from the old order are stale */
+  IndexLineGen++;
+
   if (!ctx->mailbox->msg_count)
   {
     /* this function gets called by mutt_sync_mailbox(), which may have just
@@ -391,6 +492,13 @@ void mutt_sort_headers(struct Context *ctx, bool init)
   if (init && ctx->tree)
     mutt_clear_threads(ctx);
 
+  const short mainsort = ((Sort & SORT_MASK) == SORT_THREADS) ? SortAux : Sort;
+  build_collation_keys(ctx->mailbox->hdrs, ctx->mailbox->msg_count,
+                       ((mainsort & SORT_MASK) == SORT_SUBJECT) ||
+                           ((SortAux & SORT_MASK) == SORT_SUBJECT),
+                       ((mainsort & SORT_MASK) == SORT_FROM) ||
+                           ((SortAux & SORT_MASK) == SORT_FROM));
+
   if ((Sort & SORT_MASK) == SORT_THREADS)
   {
     AuxSort = NULL;
@@ -410,11 +518,17 @@ void mutt_sort_headers(struct Context *ctx, bool init)
   else if (!(sortfunc = mutt_get_sort_func(Sort)) || !(AuxSort = mutt_get_sort_func(SortAux)))
   {
     mutt_error(_("Could not find sorting function [report this bug]"));
+    free_collation_keys();
     return;
   }
-  else
+  else if (!headers_sorted(ctx->mailbox->hdrs, ctx->mailbox->msg_count, sortfunc))
+  {
+    /* resorts are often triggered by changes (flags, scores) that don't
+     * disturb the order, so check with one linear pass before paying for a
+     * full qsort of the pointer array */
     qsort((void *) ctx->mailbox->hdrs, ctx->mailbox->msg_count,
           sizeof(struct Email *), sortfunc);
+  }
 
   /* adjust the virtual message numbers */
   ctx->mailbox->vcount = 0;
@@ -447,6 +561,8 @@ void mutt_sort_headers(struct Context *ctx, bool init)
     mutt_set_virtual(ctx);
   }
 
+  free_collation_keys();
+
   if (!ctx->mailbox->quiet)
     mutt_clear_error();
 }
@@ -0,0 +1,135 @@
+/**
+ * @file
+ * Micro-benchmarks for hot library functions
+ *
+ * @authors
+ * Copyright (C) 2018 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* Run with `make bench`.  Each benchmark is warmed up, then timed with the
+ * monotonic clock and reported as nanoseconds per operation.  The absolute
+ * numbers depend on the machine; what matters is comparing them across
+ * revisions to catch silent slowdowns in these hot paths. */
+
+#include <locale.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mutt/base64.h"
+#include "mutt/charset.h"
+#include "mutt/hash.h"
+#include "mutt/memory.h"
+#include "mutt/string2.h"
+#include "email/rfc2047.h"
+
+/**
+ * now_ns - Read the monotonic clock
+ * @retval num Nanoseconds from an arbitrary origin
+ */
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t) ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+}
+
+static void bench_b64_encode(long iters)
+{
+  const char clear[] = "The quick brown fox jumps over the lazy dog, twice.";
+  char buf[128];
+  for (long i = 0; i < iters; i++)
+    mutt_b64_encode(clear, sizeof(clear) - 1, buf, sizeof(buf));
+}
+
+static void bench_b64_decode(long iters)
+{
+  const char encoded[] = "VGhlIHF1aWNrIGJyb3duIGZveCBqdW1wcyBvdmVyIHRoZSBsYXp5IGRvZywgdHdpY2Uu";
+  char buf[128];
+  for (long i = 0; i < iters; i++)
+    mutt_b64_decode(encoded, buf, sizeof(buf));
+}
+
+static void bench_rfc2047_decode(long iters)
+{
+  const char encoded[] = "=?UTF-8?Q?Kvie=C4=8Diame=20drauge=20pildyti=20ESO?= plain tail";
+  for (long i = 0; i < iters; i++)
+  {
+    char *s = mutt_str_strdup(encoded);
+    rfc2047_decode(&s);
+    FREE(&s);
+  }
+}
+
+#define HASH_KEYS 1000
+static struct Hash *HashTable = NULL;
+static char HashKeys[HASH_KEYS][16];
+
+static void bench_hash_find(long iters)
+{
+  for (long i = 0; i < iters; i++)
+    mutt_hash_find(HashTable, HashKeys[i % HASH_KEYS]);
+}
+
+/**
+ * struct Benchmark - One timed function
+ */
+struct Benchmark
+{
+  const char *name;     /**< printed in the result table */
+  void (*func)(long);   /**< runs the operation 'iters' times */
+  long iters;           /**< timed iterations */
+};
+
+static const struct Benchmark Benchmarks[] = {
+  { "mutt_b64_encode", bench_b64_encode, 1000000 },
+  { "mutt_b64_decode", bench_b64_decode, 1000000 },
+  { "rfc2047_decode", bench_rfc2047_decode, 100000 },
+  { "mutt_hash_find", bench_hash_find, 1000000 },
+};
+
+int main(void)
+{
+  if (!setlocale(LC_ALL, "en_US.UTF-8") && !setlocale(LC_ALL, "C.UTF-8"))
+    setlocale(LC_ALL, "");
+  Charset = "utf-8";
+
+  HashTable = mutt_hash_create(HASH_KEYS, 0);
+  for (int i = 0; i < HASH_KEYS; i++)
+  {
+    snprintf(HashKeys[i], sizeof(HashKeys[i]), "key-%d", i);
+    mutt_hash_insert(HashTable, HashKeys[i], HashKeys[i]);
+  }
+
+  printf("%-24s %12s %12s %12s\n", "benchmark", "iterations", "total-ms", "ns/op");
+  for (size_t b = 0; b < mutt_array_size(Benchmarks); b++)
+  {
+    /* warm up caches, allocator and branch predictors before timing */
+    Benchmarks[b].func(Benchmarks[b].iters / 10);
+
+    const uint64_t start = now_ns();
+    Benchmarks[b].func(Benchmarks[b].iters);
+    const uint64_t elapsed = now_ns() - start;
+
+    printf("%-24s %12ld %12.1f %12.1f\n", Benchmarks[b].name, Benchmarks[b].iters,
+           (double) elapsed / 1e6, (double) elapsed / Benchmarks[b].iters);
+  }
+
+  mutt_hash_destroy(&HashTable);
+  return 0;
+}
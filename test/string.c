@@ -107,3 +107,35 @@ void test_string_strnfcpy(void)
     }
   }
 }
+
+void test_string_ascii_strcasecmp(void)
+{
+  { /* identical up to case */
+    TEST_CHECK(mutt_str_ascii_strcasecmp("Content-Type", "content-type") == 0);
+    TEST_CHECK(mutt_str_ascii_strcasecmp("SUBJECT", "subject") == 0);
+  }
+
+  { /* ordering */
+    TEST_CHECK(mutt_str_ascii_strcasecmp("apple", "banana") == -1);
+    TEST_CHECK(mutt_str_ascii_strcasecmp("banana", "apple") == 1);
+    TEST_CHECK(mutt_str_ascii_strcasecmp("abc", "abcd") == -1);
+  }
+
+  { /* NULL is treated as the empty string */
+    TEST_CHECK(mutt_str_ascii_strcasecmp(NULL, "") == 0);
+    TEST_CHECK(mutt_str_ascii_strcasecmp(NULL, NULL) == 0);
+    TEST_CHECK(mutt_str_ascii_strcasecmp("x", NULL) == 1);
+  }
+
+  { /* only a-z/A-Z fold, independent of the locale */
+    TEST_CHECK(mutt_str_ascii_strcasecmp("[", "{") != 0);
+    TEST_CHECK(mutt_str_ascii_strcasecmp("\xc3\x84", "\xc3\xa4") != 0);
+  }
+
+  { /* length-limited variant */
+    TEST_CHECK(mutt_str_ascii_strncasecmp("X-Spam-Status", "x-spam-level", 7) == 0);
+    TEST_CHECK(mutt_str_ascii_strncasecmp("X-Spam-Status", "x-spam-level", 8) != 0);
+    TEST_CHECK(mutt_str_ascii_strncasecmp("abc", "abcdef", 10) == -1);
+    TEST_CHECK(mutt_str_ascii_strncasecmp("abc", "xyz", 0) == 0);
+  }
+}